@@ -60,6 +60,15 @@ AlphaTLB::AlphaTLB(const string &name, int s)
 {
     table = new AlphaISA::PTE[size];
     memset(table, 0, sizeof(AlphaISA::PTE[size]));
+
+    int buckets = 1;
+    while (buckets < 2 * size)
+	buckets <<= 1;
+    lookupMask = buckets - 1;
+    lookupBuckets.resize(buckets, -1);
+    lookupNext.resize(size, -1);
+
+    flushMicroTLB();
 }
 
 AlphaTLB::~AlphaTLB()
@@ -75,18 +84,25 @@ AlphaTLB::lookup(Addr vpn, uint8_t asn) const
     // assume not found...
     AlphaISA::PTE *retval = NULL;
 
-    PageTable::const_iterator i = lookupTable.find(vpn);
-    if (i != lookupTable.end()) {
-	while (i->first == vpn) {
-	    int index = i->second;
+    MicroTLBEntry &micro = microTLB[vpn & (MicroTLBSize - 1)];
+    if (micro.valid && micro.vpn == vpn && micro.asn == asn) {
+	retval = &table[micro.index];
+	assert(retval->valid && retval->tag == vpn);
+    } else {
+	int index = lookupBuckets[vpn & lookupMask];
+	while (index != -1) {
 	    AlphaISA::PTE *pte = &table[index];
 	    assert(pte->valid);
 	    if (vpn == pte->tag && (pte->asma || pte->asn == asn)) {
 		retval = pte;
+		micro.vpn = vpn;
+		micro.asn = asn;
+		micro.index = index;
+		micro.valid = true;
 		break;
 	    }
 
-	    ++i;
+	    index = lookupNext[index];
 	}
     }
 
@@ -95,6 +111,47 @@ AlphaTLB::lookup(Addr vpn, uint8_t asn) const
     return retval;
 }
 
+// add a valid entry to the end of its bucket
+void
+AlphaTLB::lookupInsert(int index)
+{
+    lookupNext[index] = -1;
+
+    int *link = &lookupBuckets[table[index].tag & lookupMask];
+    while (*link != -1)
+	link = &lookupNext[*link];
+    *link = index;
+}
+
+void
+AlphaTLB::lookupRemove(int index)
+{
+    int *link = &lookupBuckets[table[index].tag & lookupMask];
+    while (*link != index) {
+	if (*link == -1)
+	    panic("TLB entry not found in lookup table");
+	link = &lookupNext[*link];
+    }
+    *link = lookupNext[index];
+    lookupNext[index] = -1;
+}
+
+void
+AlphaTLB::lookupClear()
+{
+    for (int i = 0; i < lookupBuckets.size(); i++)
+	lookupBuckets[i] = -1;
+    for (int i = 0; i < size; i++)
+	lookupNext[i] = -1;
+}
+
+void
+AlphaTLB::flushMicroTLB() const
+{
+    for (int i = 0; i < MicroTLBSize; i++)
+	microTLB[i].valid = false;
+}
+
 
 void
 AlphaTLB::checkCacheability(MemReqPtr &req)
@@ -147,24 +204,13 @@ void
 AlphaTLB::insert(Addr addr, AlphaISA::PTE &pte)
 {
     AlphaISA::VAddr vaddr = addr;
-    if (table[nlu].valid) {
-	Addr oldvpn = table[nlu].tag;
-	PageTable::iterator i = lookupTable.find(oldvpn);
-
-	if (i == lookupTable.end())
-	    panic("TLB entry not found in lookupTable");
-
-	int index;
-	while ((index = i->second) != nlu) {
-	    if (table[index].tag != oldvpn)
-		panic("TLB entry not found in lookupTable");
-
-	    ++i;
-	}
+    flushMicroTLB();
 
-	DPRINTF(TLB, "remove @%d: %#x -> %#x\n", nlu, oldvpn, table[nlu].ppn);
+    if (table[nlu].valid) {
+	DPRINTF(TLB, "remove @%d: %#x -> %#x\n", nlu, table[nlu].tag,
+		table[nlu].ppn);
 
-	lookupTable.erase(i);
+	lookupRemove(nlu);
     }
 
     DPRINTF(TLB, "insert @%d: %#x -> %#x\n", nlu, vaddr.vpn(), pte.ppn);
@@ -173,7 +219,7 @@ AlphaTLB::insert(Addr addr, AlphaISA::PTE &pte)
     table[nlu].tag = vaddr.vpn();
     table[nlu].valid = true;
 
-    lookupTable.insert(make_pair(vaddr.vpn(), nlu));
+    lookupInsert(nlu);
     nextnlu();
 }
 
@@ -182,29 +228,23 @@ AlphaTLB::flushAll()
 {
     DPRINTF(TLB, "flushAll\n");
     memset(table, 0, sizeof(AlphaISA::PTE[size]));
-    lookupTable.clear();
+    lookupClear();
+    flushMicroTLB();
     nlu = 0;
 }
 
 void
 AlphaTLB::flushProcesses()
 {
-    PageTable::iterator i = lookupTable.begin();
-    PageTable::iterator end = lookupTable.end();
-    while (i != end) {
-	int index = i->second;
-	AlphaISA::PTE *pte = &table[index];
-    	assert(pte->valid);
+    flushMicroTLB();
 
-	// we can't increment i after we erase it, so save a copy and
-	// increment it to get the next entry now
-	PageTable::iterator cur = i;
-	++i;
+    for (int index = 0; index < size; index++) {
+	AlphaISA::PTE *pte = &table[index];
 
-	if (!pte->asma) {
+	if (pte->valid && !pte->asma) {
 	    DPRINTF(TLB, "flush @%d: %#x -> %#x\n", index, pte->tag, pte->ppn);
+	    lookupRemove(index);
 	    pte->valid = false;
-	    lookupTable.erase(cur);
 	}
     }
 }
@@ -213,27 +253,26 @@ void
 AlphaTLB::flushAddr(Addr addr, uint8_t asn)
 {
     AlphaISA::VAddr vaddr = addr;
+    flushMicroTLB();
 
-    PageTable::iterator i = lookupTable.find(vaddr.vpn());
-    if (i == lookupTable.end())
-	return;
-
-    while (i->first == vaddr.vpn()) {
-	int index = i->second;
+    int index = lookupBuckets[vaddr.vpn() & lookupMask];
+    while (index != -1) {
 	AlphaISA::PTE *pte = &table[index];
 	assert(pte->valid);
 
+	// the chain is changed when the entry is removed
+	int next = lookupNext[index];
+
 	if (vaddr.vpn() == pte->tag && (pte->asma || pte->asn == asn)) {
 	    DPRINTF(TLB, "flushaddr @%d: %#x -> %#x\n", index, vaddr.vpn(),
 		    pte->ppn);
 
 	    // invalidate this entry
+	    lookupRemove(index);
 	    pte->valid = false;
-
-	    lookupTable.erase(i);
 	}
 
-	++i;
+	index = next;
     }
 }
 
@@ -256,10 +295,13 @@ AlphaTLB::unserialize(Checkpoint *cp, const string &section)
     UNSERIALIZE_SCALAR(size);
     UNSERIALIZE_SCALAR(nlu);
 
+    lookupClear();
+    flushMicroTLB();
+
     for (int i = 0; i < size; i++) {
 	table[i].unserialize(cp, csprintf("%s.PTE%d", section, i));
 	if (table[i].valid) {
-	    lookupTable.insert(make_pair(table[i].tag, i));
+	    lookupInsert(i);
 	}
     }
 }
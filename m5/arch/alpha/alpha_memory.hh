@@ -32,7 +32,7 @@
 #ifndef __ALPHA_MEMORY_HH__
 #define __ALPHA_MEMORY_HH__
 
-#include <map>
+#include <vector>
 
 #include "arch/alpha/isa_traits.hh"
 #include "base/statistics.hh"
@@ -44,16 +44,41 @@ class ExecContext;
 class AlphaTLB : public SimObject
 {
   protected:
-    typedef std::multimap<Addr, int> PageTable;
-    PageTable lookupTable;	// Quick lookup into page table
-
     AlphaISA::PTE *table;	// the Page Table
     int size;			// TLB Size
     int nlu;			// not last used entry (for replacement)
 
+    /**
+     * Quick lookup into the page table. Each bucket holds the index of
+     * the first valid entry that hashes to it, and the entries in a
+     * bucket are chained through lookupNext in insertion order.
+     */
+    std::vector<int> lookupBuckets;
+    std::vector<int> lookupNext;
+    Addr lookupMask;
+
+    /**
+     * A direct mapped cache of recent lookups tagged with the VPN and the
+     * ASN of the lookup. It is cleared whenever the TLB contents change,
+     * so it always gives the same entry as a full lookup.
+     */
+    struct MicroTLBEntry {
+	Addr vpn;
+	uint8_t asn;
+	bool valid;
+	int index;
+    };
+    static const int MicroTLBSize = 16;
+    mutable MicroTLBEntry microTLB[MicroTLBSize];
+
     void nextnlu() { if (++nlu >= size) nlu = 0; }
     AlphaISA::PTE *lookup(Addr vpn, uint8_t asn) const;
 
+    void lookupInsert(int index);
+    void lookupRemove(int index);
+    void lookupClear();
+    void flushMicroTLB() const;
+
   public:
     AlphaTLB(const std::string &name, int size);
     virtual ~AlphaTLB();
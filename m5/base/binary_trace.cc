@@ -0,0 +1,157 @@
+/*
+ * binary_trace.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include "base/binary_trace.hh"
+#include "base/misc.hh"
+
+using namespace std;
+
+namespace Trace {
+
+BinaryLog binaryLog;
+
+BinaryLog::BinaryLog()
+{
+    file = NULL;
+    buffer = NULL;
+    used = 0;
+    formatCount = 0;
+    nextFormatId = 0;
+}
+
+BinaryLog::~BinaryLog()
+{
+    close();
+}
+
+void
+BinaryLog::open(const string &filename, const char **flagNames, int numFlags)
+{
+    if (file != NULL)
+	fatal("Trace::BinaryLog::open called twice!");
+
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL)
+	fatal("Could not open binary trace file %s", filename);
+
+    buffer = new uint8_t[BufferSize];
+    used = 0;
+
+    formats.clear();
+    formats.resize(1024);
+    formatCount = 0;
+    nextFormatId = 0;
+
+    put(Binary::Magic);
+    put(Binary::Version);
+    put((uint32_t)numFlags);
+    for (int i = 0; i < numFlags; ++i)
+	putString(flagNames[i], strlen(flagNames[i]));
+}
+
+void
+BinaryLog::flush()
+{
+    if (file == NULL)
+	return;
+
+    if (used > 0)
+	fwrite(buffer, 1, used, file);
+    used = 0;
+    fflush(file);
+}
+
+void
+BinaryLog::close()
+{
+    if (file == NULL)
+	return;
+
+    flush();
+    fclose(file);
+    file = NULL;
+
+    delete [] buffer;
+    buffer = NULL;
+}
+
+int
+BinaryLog::formatSlot(const vector<FormatEntry> &table,
+		      const char *format) const
+{
+    int mask = table.size() - 1;
+    uint64_t hash = (uint64_t)(uintptr_t)format * 0x9e3779b97f4a7c15ULL;
+    int slot = (int)(hash >> 32) & mask;
+    while (table[slot].format != NULL && table[slot].format != format)
+	slot = (slot + 1) & mask;
+    return slot;
+}
+
+void
+BinaryLog::growFormats()
+{
+    vector<FormatEntry> table(formats.size() * 2);
+    for (int i = 0; i < formats.size(); ++i) {
+	if (formats[i].format != NULL)
+	    table[formatSlot(table, formats[i].format)] = formats[i];
+    }
+    formats.swap(table);
+}
+
+uint32_t
+BinaryLog::formatId(const char *format)
+{
+    int slot = formatSlot(formats, format);
+    FormatEntry &entry = formats[slot];
+
+    if (entry.format == format && entry.text == format)
+	return entry.id;
+
+    if (entry.format == NULL) {
+	if (2 * (formatCount + 1) > formats.size()) {
+	    growFormats();
+	    return formatId(format);
+	}
+	formatCount++;
+    }
+
+    // a new format string, or a buffer that now holds another string
+    entry.format = format;
+    entry.text = format;
+    entry.id = nextFormatId++;
+
+    put((uint8_t)Binary::FormatRecord);
+    put(entry.id);
+    putString(format, entry.text.size());
+
+    return entry.id;
+}
+
+void
+BinaryLog::beginPrintf(int flag, Tick cycle, const string &name,
+		       const char *format)
+{
+    uint32_t id = formatId(format);
+
+    put((uint8_t)Binary::PrintfRecord);
+    put(cycle);
+    put((int16_t)flag);
+    put(id);
+    putString(name.data(), name.size());
+}
+
+void
+BinaryLog::dataDump(Tick cycle, const string &name, const void *data,
+		    int len)
+{
+    put((uint8_t)Binary::DataRecord);
+    put(cycle);
+    putString(name.data(), name.size());
+    putString((const char *)data, len);
+}
+
+} // namespace Trace
@@ -0,0 +1,278 @@
+/*
+ * binary_trace.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef BINARY_TRACE_HH_
+#define BINARY_TRACE_HH_
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/host.hh"
+
+namespace Trace {
+
+/**
+ * The layout of a binary trace file. All values are stored in host byte
+ * order, so a trace must be decoded on a host with the same layout.
+ *
+ * The file starts with the magic number, the version, the number of
+ * trace flags and the flag names. It is followed by records that start
+ * with a RecordType byte:
+ *  - FormatRecord: format id, format string
+ *  - PrintfRecord: tick, flag (-1 if none), format id, object name and
+ *    the arguments, each starting with an ArgType byte and ending
+ *    with ArgEnd. Pointers are stored as 64-bit values.
+ *  - DataRecord: tick, object name, data
+ * Strings and data are stored as a 32-bit length followed by the bytes.
+ */
+namespace Binary {
+    const uint32_t Magic = 0x5442354d;
+    const uint32_t Version = 1;
+
+    enum RecordType {
+	FormatRecord = 1,
+	PrintfRecord,
+	DataRecord
+    };
+
+    enum ArgType {
+	ArgEnd = 0,
+	ArgBool,
+	ArgChar,
+	ArgSignedChar,
+	ArgUnsignedChar,
+	ArgShort,
+	ArgUnsignedShort,
+	ArgInt,
+	ArgUnsignedInt,
+	ArgLong,
+	ArgUnsignedLong,
+	ArgLongLong,
+	ArgUnsignedLongLong,
+	ArgFloat,
+	ArgDouble,
+	ArgString,
+	ArgPointer
+    };
+}
+
+/**
+ * Writes trace records in the binary format. The records are copied
+ * into a fixed size buffer that is written to the file when it is
+ * full, so tracing neither allocates nor formats. Format strings are
+ * written once and referred to by id after that. The text is rendered
+ * offline by util/tracedecode.
+ *
+ * @author Magnus Jahre
+ */
+class BinaryLog
+{
+  private:
+    static const int BufferSize = 1 << 20;
+
+    FILE *file;
+    uint8_t *buffer;
+    int used;
+
+    /**
+     * Open addressed table from format string pointer to format id. The
+     * text is kept so a reused pointer is detected.
+     */
+    struct FormatEntry {
+	const char *format;
+	std::string text;
+	uint32_t id;
+
+	FormatEntry() : format(NULL), id(0) {}
+    };
+    std::vector<FormatEntry> formats;
+    int formatCount;
+    uint32_t nextFormatId;
+
+    int formatSlot(const std::vector<FormatEntry> &table,
+		   const char *format) const;
+    void growFormats();
+    uint32_t formatId(const char *format);
+
+  public:
+    BinaryLog();
+    ~BinaryLog();
+
+    bool enabled() const { return file != NULL; }
+
+    void open(const std::string &filename, const char **flagNames,
+	      int numFlags);
+    void flush();
+    void close();
+
+    void
+    write(const void *data, int len)
+    {
+	if (used + len > BufferSize) {
+	    flush();
+	    if (len > BufferSize) {
+		fwrite(data, 1, len, file);
+		return;
+	    }
+	}
+	memcpy(buffer + used, data, len);
+	used += len;
+    }
+
+    template <class T>
+    void put(const T &value) { write(&value, sizeof(T)); }
+
+    void
+    putString(const char *str, uint32_t len)
+    {
+	put(len);
+	write(str, len);
+    }
+
+    void beginPrintf(int flag, Tick cycle, const std::string &name,
+		     const char *format);
+    void endPrintf() { put((uint8_t)Binary::ArgEnd); }
+
+    void dataDump(Tick cycle, const std::string &name, const void *data,
+		  int len);
+};
+
+extern BinaryLog binaryLog;
+
+/**
+ * Collects the arguments of one DPRINTF with the comma operator, in
+ * the same way as cp::ArgList, and writes them to the binary log.
+ */
+class BinaryRecord
+{
+  public:
+    BinaryRecord(int flag, Tick cycle, const std::string &name,
+		 const char *format)
+    {
+	binaryLog.beginPrintf(flag, cycle, name, format);
+    }
+
+    ~BinaryRecord() { binaryLog.endPrintf(); }
+
+    template <class T>
+    BinaryRecord &
+    arg(Binary::ArgType type, T value)
+    {
+	binaryLog.put((uint8_t)type);
+	binaryLog.put(value);
+	return *this;
+    }
+
+    BinaryRecord &
+    arg(const char *str, uint32_t len)
+    {
+	binaryLog.put((uint8_t)Binary::ArgString);
+	binaryLog.putString(str, len);
+	return *this;
+    }
+};
+
+#define BINARY_TRACE_ARG(T, TYPE) \
+inline BinaryRecord & \
+operator,(BinaryRecord &rec, T value) \
+{ return rec.arg(Binary::TYPE, value); }
+
+BINARY_TRACE_ARG(bool, ArgBool)
+BINARY_TRACE_ARG(char, ArgChar)
+BINARY_TRACE_ARG(signed char, ArgSignedChar)
+BINARY_TRACE_ARG(unsigned char, ArgUnsignedChar)
+BINARY_TRACE_ARG(short, ArgShort)
+BINARY_TRACE_ARG(unsigned short, ArgUnsignedShort)
+BINARY_TRACE_ARG(int, ArgInt)
+BINARY_TRACE_ARG(unsigned int, ArgUnsignedInt)
+BINARY_TRACE_ARG(long, ArgLong)
+BINARY_TRACE_ARG(unsigned long, ArgUnsignedLong)
+BINARY_TRACE_ARG(long long, ArgLongLong)
+BINARY_TRACE_ARG(unsigned long long, ArgUnsignedLongLong)
+BINARY_TRACE_ARG(float, ArgFloat)
+BINARY_TRACE_ARG(double, ArgDouble)
+
+#undef BINARY_TRACE_ARG
+
+inline BinaryRecord &
+operator,(BinaryRecord &rec, const char *str)
+{ return str ? rec.arg(str, strlen(str)) : rec.arg("", 0); }
+
+inline BinaryRecord &
+operator,(BinaryRecord &rec, char *str)
+{ return rec, (const char *)str; }
+
+inline BinaryRecord &
+operator,(BinaryRecord &rec, const std::string &str)
+{ return rec.arg(str.data(), str.size()); }
+
+inline BinaryRecord &
+operator,(BinaryRecord &rec, cp::ArgListNull)
+{ return rec; }
+
+template <class T>
+inline BinaryRecord &
+operator,(BinaryRecord &rec, T *ptr)
+{ return rec.arg(Binary::ArgPointer, (uint64_t)(uintptr_t)ptr); }
+
+inline BinaryRecord &
+operator,(BinaryRecord &rec, long double value)
+{ return rec, (double)value; }
+
+/** True if T is a class, struct or union type. */
+template <class T>
+class IsClassType
+{
+    template <class U> static char test(int U::*);
+    template <class U> static long test(...);
+
+  public:
+    enum { value = sizeof(test<T>(0)) == sizeof(char) };
+};
+
+template <bool IsClass>
+struct BinaryArg
+{
+    // Class types are printed with operator<< when the record is
+    // written, so format flags such as %x do not apply to them
+    template <class T>
+    static BinaryRecord &
+    put(BinaryRecord &rec, const T &value)
+    {
+	std::stringstream str;
+	str << value;
+	return rec, str.str();
+    }
+};
+
+template <>
+struct BinaryArg<false>
+{
+    // Enums are promoted to the integer type cprintf would print them
+    // as, so they keep their format flags
+    template <class T>
+    static BinaryRecord &
+    put(BinaryRecord &rec, const T &value)
+    {
+	return rec, +value;
+    }
+};
+
+template <class T>
+inline BinaryRecord &
+operator,(BinaryRecord &rec, const T &value)
+{
+    return BinaryArg<IsClassType<T>::value>::put(rec, value);
+}
+
+} // namespace Trace
+
+#endif /* BINARY_TRACE_HH_ */
@@ -0,0 +1,44 @@
+/*
+ * compact_trace.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include "base/compact_trace.hh"
+#include "base/misc.hh"
+
+using namespace std;
+
+CompactTraceWriter::CompactTraceWriter(const string& filename, const string& kind, int version){
+
+	// fast compression keeps the cost of tracing low
+	file = gzopen(filename.c_str(), "wb1");
+	if(file == NULL) fatal("Could not open trace file %s", filename);
+
+	buffer = new uint8_t[BufferSize];
+	used = 0;
+
+	for(int i=0;i<4;i++) putByte((uint8_t) (Magic >> (8*i)));
+	putString(kind);
+	putVarint(version);
+}
+
+CompactTraceWriter::~CompactTraceWriter(){
+	flush();
+	gzclose(file);
+	delete [] buffer;
+}
+
+void
+CompactTraceWriter::flush(){
+	if(used == 0) return;
+	if(gzwrite(file, buffer, used) != used) fatal("Could not write to the trace file");
+	used = 0;
+}
+
+void
+CompactTraceWriter::putString(const string& str){
+	putVarint(str.size());
+	for(int i=0;i<str.size();i++) putByte((uint8_t) str[i]);
+}
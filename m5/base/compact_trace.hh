@@ -0,0 +1,74 @@
+/*
+ * compact_trace.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef COMPACT_TRACE_HH_
+#define COMPACT_TRACE_HH_
+
+#include <string>
+#include <zlib.h>
+
+#include "sim/host.hh"
+
+/**
+* Buffered, zlib compressed output for the binary instruction and
+* pipeline traces.
+*
+* Values are written as variable length integers with 7 bits per byte.
+* Values that follow each other closely, like PCs, ticks and sequence
+* numbers, are written as the zigzag encoded difference from the
+* previous value of the same field, which is usually one byte.
+*
+* A trace starts with a magic number, the kind of trace ("exec" or
+* "pipe") and a format version. The rest of the layout is given by the
+* kind. util/compacttrace prints, filters and diffs the traces.
+*
+* @author Magnus Jahre
+*/
+class CompactTraceWriter{
+
+private:
+	static const int BufferSize = 1 << 16;
+
+	gzFile file;
+	uint8_t* buffer;
+	int used;
+
+public:
+	static const uint32_t Magic = 0x43544d35;
+
+	CompactTraceWriter(const std::string& filename, const std::string& kind, int version);
+	~CompactTraceWriter();
+
+	void flush();
+
+	void putByte(uint8_t value){
+		if(used == BufferSize) flush();
+		buffer[used++] = value;
+	}
+
+	void putVarint(uint64_t value){
+		while(value >= 0x80){
+			putByte((uint8_t) (value | 0x80));
+			value >>= 7;
+		}
+		putByte((uint8_t) value);
+	}
+
+	/**
+	 * Writes the difference from the previous value of a field and makes
+	 * the value the new previous value.
+	 */
+	void putDelta(uint64_t value, uint64_t& last){
+		int64_t delta = (int64_t) (value - last);
+		putVarint(((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+		last = value;
+	}
+
+	void putString(const std::string& str);
+};
+
+#endif /* COMPACT_TRACE_HH_ */
@@ -0,0 +1,432 @@
+/*
+ * bdi_compression.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "base/compression/bdi_compression.hh"
+#include "base/misc.hh"
+
+using namespace std;
+
+const int BDICompression::baseBytes[BDI_NUM_ENCODINGS] =
+    {0, 8, 8, 8, 8, 4, 4, 2, 0, 0};
+const int BDICompression::deltaBytes[BDI_NUM_ENCODINGS] =
+    {0, 0, 1, 2, 4, 1, 2, 1, 0, 0};
+
+static const char *encodingNames[BDICompression::BDI_NUM_ENCODINGS] =
+    {"zeros", "repeated", "b8d1", "b8d2", "b8d4", "b4d1", "b4d2", "b2d1",
+     "fpc", "uncompressed"};
+
+/* FPC patterns */
+enum {
+    FPC_ZERO,
+    FPC_SE4,
+    FPC_SE8,
+    FPC_SE16,
+    FPC_HIGH16,
+    FPC_TWO_SE8,
+    FPC_REP_BYTES,
+    FPC_RAW
+};
+
+static const int fpcDataBits[8] = {0, 4, 8, 16, 16, 16, 8, 32};
+
+static inline uint64_t
+byteMask(int bytes)
+{
+    return bytes == 8 ? ~(uint64_t) 0 : ((uint64_t) 1 << (bytes*8)) - 1;
+}
+
+/* True if value, seen as a signed number of width bytes, fits in
+ * a signed number of narrow bytes */
+static inline bool
+fitsSigned(uint64_t value, int narrow, int width)
+{
+    uint64_t half = (uint64_t) 1 << (narrow*8 - 1);
+    return ((value + half) & byteMask(width)) < (half << 1);
+}
+
+static inline uint64_t
+signExtend(uint64_t value, int narrow, int width)
+{
+    if(value & ((uint64_t) 1 << (narrow*8 - 1))){
+        value |= ~byteMask(narrow);
+    }
+    return value & byteMask(width);
+}
+
+static int
+fpcPattern(uint32_t w)
+{
+    if(w == 0) return FPC_ZERO;
+    if(((w + 8) & 0xffffffff) < 16) return FPC_SE4;
+    if(fitsSigned(w, 1, 4)) return FPC_SE8;
+    if(fitsSigned(w, 2, 4)) return FPC_SE16;
+    if((w & 0xffff) == 0) return FPC_HIGH16;
+    if(fitsSigned(w & 0xffff, 1, 2) && fitsSigned(w >> 16, 1, 2)){
+        return FPC_TWO_SE8;
+    }
+    if(w == (w & 0xff) * 0x01010101) return FPC_REP_BYTES;
+    return FPC_RAW;
+}
+
+BDICompression::BDICompression()
+    : numWords(0)
+{
+}
+
+void
+BDICompression::regStats(const string &name)
+{
+    using namespace Stats;
+
+    encodingCount
+        .init(BDI_NUM_ENCODINGS)
+        .name(name + ".bdi_encodings")
+        .desc("number of blocks compressed with each encoding")
+        .flags(total)
+        ;
+
+    for(int i=0;i<BDI_NUM_ENCODINGS;i++){
+        encodingCount.subname(i, encodingNames[i]);
+    }
+
+    uncompressedBytes
+        .name(name + ".bdi_uncompressed_bytes")
+        .desc("bytes given to the compressor")
+        ;
+
+    compressedBytes
+        .name(name + ".bdi_compressed_bytes")
+        .desc("bytes produced by the compressor")
+        ;
+
+    compressionRatio
+        .name(name + ".bdi_compression_ratio")
+        .desc("uncompressed bytes per compressed byte")
+        ;
+
+    compressionRatio = uncompressedBytes / compressedBytes;
+}
+
+inline uint64_t
+BDICompression::element(int i, int bytes) const
+{
+    int offset = i * bytes;
+    uint64_t w = words[offset >> 3];
+    if(bytes == 8) return w;
+    return (w >> ((offset & 7) * 8)) & byteMask(bytes);
+}
+
+inline void
+BDICompression::setElement(uint64_t *w, int i, int bytes, uint64_t value)
+{
+    int offset = i * bytes;
+    if(bytes == 8){
+        w[offset >> 3] = value;
+        return;
+    }
+    int shift = (offset & 7) * 8;
+    w[offset >> 3] &= ~(byteMask(bytes) << shift);
+    w[offset >> 3] |= value << shift;
+}
+
+inline uint32_t
+BDICompression::word32(int i) const
+{
+    return (uint32_t) element(i, 4);
+}
+
+int
+BDICompression::bdiSize(Encoding enc, uint64_t &base)
+{
+    int bytes = baseBytes[enc];
+    int delta = deltaBytes[enc];
+    int elements = numWords * 8 / bytes;
+    bool haveBase = false;
+    base = 0;
+
+    for(int i=0;i<elements;i++){
+        uint64_t v = element(i, bytes);
+        if(fitsSigned(v, delta, bytes)) continue;
+        if(!haveBase){
+            base = v;
+            haveBase = true;
+            continue;
+        }
+        if(!fitsSigned(v - base, delta, bytes)) return -1;
+    }
+
+    return HEADER_SIZE + bytes + (elements + 7) / 8 + elements * delta;
+}
+
+int
+BDICompression::fpcSize()
+{
+    int bits = 0;
+    for(int i=0;i<numWords*2;i++){
+        bits += 3 + fpcDataBits[fpcPattern(word32(i))];
+    }
+    return HEADER_SIZE + (bits + 7) / 8;
+}
+
+int
+BDICompression::writeBDI(uint8_t *dest, Encoding enc, uint64_t base)
+{
+    int bytes = baseBytes[enc];
+    int delta = deltaBytes[enc];
+    int elements = numWords * 8 / bytes;
+
+    uint8_t *pos = dest + HEADER_SIZE;
+    for(int b=0;b<bytes;b++) *pos++ = (base >> (b*8)) & 0xff;
+
+    uint8_t *mask = pos;
+    memset(mask, 0, (elements + 7) / 8);
+    pos += (elements + 7) / 8;
+
+    for(int i=0;i<elements;i++){
+        uint64_t v = element(i, bytes);
+        if(!fitsSigned(v, delta, bytes)){
+            mask[i >> 3] |= 1 << (i & 7);
+            v -= base;
+        }
+        for(int b=0;b<delta;b++) *pos++ = (v >> (b*8)) & 0xff;
+    }
+
+    return pos - dest;
+}
+
+void
+BDICompression::readBDI(uint64_t *w, uint8_t *src, Encoding enc)
+{
+    int bytes = baseBytes[enc];
+    int delta = deltaBytes[enc];
+    int elements = numWords * 8 / bytes;
+
+    uint8_t *pos = src + HEADER_SIZE;
+    uint64_t base = 0;
+    for(int b=0;b<bytes;b++) base |= (uint64_t) *pos++ << (b*8);
+
+    uint8_t *mask = pos;
+    pos += (elements + 7) / 8;
+
+    for(int i=0;i<elements;i++){
+        uint64_t v = 0;
+        for(int b=0;b<delta;b++) v |= (uint64_t) *pos++ << (b*8);
+        v = signExtend(v, delta, bytes);
+        if(mask[i >> 3] & (1 << (i & 7))) v = (v + base) & byteMask(bytes);
+        setElement(w, i, bytes, v);
+    }
+}
+
+int
+BDICompression::writeFPC(uint8_t *dest)
+{
+    uint8_t *pos = dest + HEADER_SIZE;
+    uint64_t acc = 0;
+    int accBits = 0;
+
+    for(int i=0;i<numWords*2;i++){
+        uint32_t w = word32(i);
+        int pattern = fpcPattern(w);
+        uint64_t data = 0;
+        switch(pattern){
+          case FPC_HIGH16:
+            data = w >> 16;
+            break;
+          case FPC_TWO_SE8:
+            data = (w & 0xff) | ((w >> 8) & 0xff00);
+            break;
+          default:
+            data = w & (((uint64_t) 1 << fpcDataBits[pattern]) - 1);
+        }
+
+        acc |= (uint64_t) pattern << accBits;
+        accBits += 3;
+        acc |= data << accBits;
+        accBits += fpcDataBits[pattern];
+
+        while(accBits >= 8){
+            *pos++ = acc & 0xff;
+            acc >>= 8;
+            accBits -= 8;
+        }
+    }
+    if(accBits > 0) *pos++ = acc & 0xff;
+
+    return pos - dest;
+}
+
+void
+BDICompression::readFPC(uint64_t *w, uint8_t *src, int size)
+{
+    uint8_t *pos = src + HEADER_SIZE;
+    uint8_t *end = src + size;
+    uint64_t acc = 0;
+    int accBits = 0;
+
+    for(int i=0;i<numWords*2;i++){
+        while(accBits < 35 && pos < end){
+            acc |= (uint64_t) *pos++ << accBits;
+            accBits += 8;
+        }
+
+        int pattern = acc & 7;
+        int bits = fpcDataBits[pattern];
+        uint64_t data = (acc >> 3) & (((uint64_t) 1 << bits) - 1);
+        acc >>= 3 + bits;
+        accBits -= 3 + bits;
+        assert(accBits >= 0);
+
+        uint64_t value = 0;
+        switch(pattern){
+          case FPC_ZERO:
+            break;
+          case FPC_SE4:
+            value = (data & 0x8) ? (data | 0xfffffff0) : data;
+            break;
+          case FPC_SE8:
+            value = signExtend(data, 1, 4);
+            break;
+          case FPC_SE16:
+            value = signExtend(data, 2, 4);
+            break;
+          case FPC_HIGH16:
+            value = data << 16;
+            break;
+          case FPC_TWO_SE8:
+            value = signExtend(data & 0xff, 1, 2) |
+                (signExtend(data >> 8, 1, 2) << 16);
+            break;
+          case FPC_REP_BYTES:
+            value = data * 0x01010101;
+            break;
+          case FPC_RAW:
+            value = data;
+            break;
+        }
+        setElement(w, i, 4, value);
+    }
+}
+
+int
+BDICompression::compress(uint8_t *dest, uint8_t *src, int size)
+{
+    uncompressedBytes += size;
+
+    if(size % 8 != 0 || size > MAX_WORDS * 8){
+        memcpy(dest, src, size);
+        encodingCount[BDI_UNCOMPRESSED]++;
+        compressedBytes += size;
+        return size;
+    }
+
+    numWords = size / 8;
+    memcpy(words, src, size);
+
+    uint64_t orWords = 0;
+    bool repeated = true;
+    for(int i=0;i<numWords;i++){
+        orWords |= words[i];
+        repeated = repeated && words[i] == words[0];
+    }
+
+    Encoding best = BDI_UNCOMPRESSED;
+    int bestSize = size;
+    uint64_t bestBase = 0;
+
+    if(orWords == 0){
+        best = BDI_ZEROS;
+        bestSize = HEADER_SIZE;
+    }
+    else if(repeated && HEADER_SIZE + 8 < size){
+        best = BDI_REPEATED;
+        bestSize = HEADER_SIZE + 8;
+    }
+    else{
+        for(int e=BDI_B8D1;e<=BDI_B2D1;e++){
+            uint64_t base;
+            int encSize = bdiSize((Encoding) e, base);
+            if(encSize >= 0 && encSize < bestSize){
+                best = (Encoding) e;
+                bestSize = encSize;
+                bestBase = base;
+            }
+        }
+        int encSize = fpcSize();
+        if(encSize < bestSize){
+            best = BDI_FPC;
+            bestSize = encSize;
+        }
+    }
+
+    encodingCount[best]++;
+    compressedBytes += bestSize;
+
+    if(best == BDI_UNCOMPRESSED){
+        memcpy(dest, src, size);
+        return size;
+    }
+
+    dest[0] = best;
+    dest[1] = numWords - 1;
+
+    int written = bestSize;
+    switch(best){
+      case BDI_ZEROS:
+        break;
+      case BDI_REPEATED:
+        memcpy(dest + HEADER_SIZE, &words[0], 8);
+        break;
+      case BDI_FPC:
+        written = writeFPC(dest);
+        break;
+      default:
+        written = writeBDI(dest, best, bestBase);
+    }
+    assert(written == bestSize);
+
+    return bestSize;
+}
+
+int
+BDICompression::uncompress(uint8_t *dest, uint8_t *src, int size)
+{
+    assert(size >= HEADER_SIZE);
+    Encoding enc = (Encoding) src[0];
+    numWords = src[1] + 1;
+
+    uint64_t out[MAX_WORDS];
+    switch(enc){
+      case BDI_ZEROS:
+        memset(out, 0, numWords * 8);
+        break;
+      case BDI_REPEATED:
+        memcpy(&out[0], src + HEADER_SIZE, 8);
+        for(int i=1;i<numWords;i++) out[i] = out[0];
+        break;
+      case BDI_FPC:
+        memset(out, 0, numWords * 8);
+        readFPC(out, src, size);
+        break;
+      case BDI_B8D1:
+      case BDI_B8D2:
+      case BDI_B8D4:
+      case BDI_B4D1:
+      case BDI_B4D2:
+      case BDI_B2D1:
+        memset(out, 0, numWords * 8);
+        readBDI(out, src, enc);
+        break;
+      default:
+        fatal("Unknown BDI encoding %d", enc);
+    }
+
+    memcpy(dest, out, numWords * 8);
+    return numWords * 8;
+}
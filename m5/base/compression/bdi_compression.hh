@@ -0,0 +1,114 @@
+/*
+ * bdi_compression.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef BDI_COMPRESSION_HH_
+#define BDI_COMPRESSION_HH_
+
+#include <string>
+
+#include "base/statistics.hh"
+#include "sim/host.hh"
+
+/**
+* A cache line compression scheme that combines base-delta-immediate
+* (BDI) and frequent pattern (FPC) encodings.
+*
+* The block is loaded as 64-bit words once and every candidate encoding
+* is sized with a single pass over the words:
+*  - all zeros,
+*  - one repeated 8-byte value,
+*  - BDI with 8, 4 or 2 byte values and 1, 2 or 4 byte deltas, where
+*    each value is a delta from either zero or one explicit base,
+*  - FPC, where each 32-bit word gets a 3-bit pattern prefix followed
+*    by between 0 and 32 data bits.
+* The smallest encoding is written after a two byte header holding the
+* encoding and the block size. If no encoding is smaller than the block,
+* the block is copied and the block size is returned, like
+* LZSSCompression does. Such data must not be passed to uncompress.
+*
+* Blocks must be a multiple of 8 bytes and at most 2048 bytes, other
+* blocks are always copied.
+*
+* @author Magnus Jahre
+*/
+class BDICompression
+{
+    public:
+        enum Encoding {
+            BDI_ZEROS,
+            BDI_REPEATED,
+            BDI_B8D1,
+            BDI_B8D2,
+            BDI_B8D4,
+            BDI_B4D1,
+            BDI_B4D2,
+            BDI_B2D1,
+            BDI_FPC,
+            BDI_UNCOMPRESSED,
+            BDI_NUM_ENCODINGS
+        };
+
+    private:
+        static const int HEADER_SIZE = 2;
+        static const int MAX_WORDS = 256;
+
+        static const int baseBytes[BDI_NUM_ENCODINGS];
+        static const int deltaBytes[BDI_NUM_ENCODINGS];
+
+        uint64_t words[MAX_WORDS];
+        int numWords;
+
+        uint64_t element(int i, int bytes) const;
+        void setElement(uint64_t *w, int i, int bytes, uint64_t value);
+        uint32_t word32(int i) const;
+
+        int bdiSize(Encoding enc, uint64_t &base);
+        int fpcSize();
+
+        int writeBDI(uint8_t *dest, Encoding enc, uint64_t base);
+        int writeFPC(uint8_t *dest);
+
+        void readBDI(uint64_t *w, uint8_t *src, Encoding enc);
+        void readFPC(uint64_t *w, uint8_t *src, int size);
+
+        Stats::Vector<> encodingCount;
+        Stats::Scalar<> uncompressedBytes;
+        Stats::Scalar<> compressedBytes;
+        Stats::Formula compressionRatio;
+
+    public:
+        BDICompression();
+
+        void regStats(const std::string &name);
+
+        /**
+         * Compresses the source block and stores it in the destination
+         * block. If no encoding is smaller than the source block, the
+         * block is copied.
+         * @param dest The destination block.
+         * @param src The block to be compressed.
+         * @param size The size of the source block.
+         * @return The size of the compressed block.
+         *
+         * @pre Destination has room for size bytes.
+         */
+        int compress(uint8_t *dest, uint8_t *src, int size);
+
+        /**
+         * Uncompresses the source block and stores it in the destination
+         * block.
+         * @param dest The destination block.
+         * @param src The block to be uncompressed.
+         * @param size The size of the compressed block.
+         * @return The size of the uncompressed block.
+         *
+         * @pre Destination has enough storage to hold the uncompressed block.
+         */
+        int uncompress(uint8_t *dest, uint8_t *src, int size);
+};
+
+#endif /* BDI_COMPRESSION_HH_ */
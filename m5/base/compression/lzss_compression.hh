@@ -36,6 +36,8 @@
  * LZSSCompression declarations.
  */
 
+#include <string>
+
 #include "sim/host.hh" // for uint8_t
 
 /**
@@ -76,6 +78,12 @@ class LZSSCompression
     void emitString(uint8_t *dest, uint16_t P, uint16_t L);
 
   public:
+    /**
+     * No statistics to register.
+     * @param name The name of the owning cache.
+     */
+    void regStats(const std::string &name) {}
+
     /**
      * Compresses the source block and stores it in the destination block. If
      * the compressed block grows to larger than the source block, it aborts
@@ -37,6 +37,8 @@
  * This file defines a doNothing compression algorithm.
  */
 
+#include <string>
+
 #include "base/misc.hh" // for fatal()
 #include "sim/host.hh"
 
@@ -47,6 +49,12 @@
 class NullCompression
 {
   public:
+    /**
+     * No statistics to register.
+     * @param name The name of the owning cache.
+     */
+    void regStats(const std::string &name) {}
+
     /**
      * Uncompress the data, causes a fatal since no data should be compressed.
      * @param dest The output buffer.
@@ -230,4 +230,14 @@ Hex2Int(char c)
   return 0;
 }
 
+// Spread a value with mostly zero low bits (e.g. a block address)
+// over a table with 2^bits entries.
+inline unsigned
+HashBits(uint64_t val, int bits)
+{
+    val ^= val >> 29;
+    val *= ULL(0x9E3779B97F4A7C15);
+    return bits == 0 ? 0 : (unsigned) (val >> (64 - bits));
+}
+
 #endif // __INTMATH_HH__
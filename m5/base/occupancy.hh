@@ -0,0 +1,129 @@
+/*
+ * occupancy.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef OCCUPANCY_HH_
+#define OCCUPANCY_HH_
+
+#include <cassert>
+
+#include "sim/host.hh"
+
+extern Tick curTick;
+
+/**
+* Time weighted occupancy of a queue or buffer.
+*
+* The owner reports the occupancy when it changes, and the occupancy is
+* integrated over the ticks each value was held in the same way as the
+* AvgStor statistic. This gives the same averages as sampling the
+* occupancy every tick without scheduling an event per tick.
+*
+* The averages cover the window since the last reset.
+*
+* @author Magnus Jahre
+*/
+class TimeWeightedOccupancy{
+
+private:
+	int current;
+	Tick lastChange;
+	Tick windowStart;
+
+	Tick area;
+	Tick busyTicks;
+
+	void update(){
+		assert(curTick >= lastChange);
+		Tick held = curTick - lastChange;
+		area += current * held;
+		if(current > 0) busyTicks += held;
+		lastChange = curTick;
+	}
+
+public:
+	TimeWeightedOccupancy(){
+		current = 0;
+		lastChange = curTick;
+		windowStart = curTick;
+		area = 0;
+		busyTicks = 0;
+	}
+
+	/**
+	 * Sets the occupancy.
+	 * @return The number of ticks the previous occupancy was held.
+	 */
+	Tick set(int value){
+		assert(value >= 0);
+		Tick held = curTick - lastChange;
+		update();
+		current = value;
+		return held;
+	}
+
+	Tick inc(int n = 1){
+		return set(current + n);
+	}
+
+	Tick dec(int n = 1){
+		return set(current - n);
+	}
+
+	int value() const{
+		return current;
+	}
+
+	/**
+	 * @return The sum of the occupancy over all ticks in the window.
+	 */
+	Tick getArea(){
+		update();
+		return area;
+	}
+
+	/**
+	 * @return The number of ticks in the window with a non-zero occupancy.
+	 */
+	Tick getBusyTicks(){
+		update();
+		return busyTicks;
+	}
+
+	Tick getWindowTicks() const{
+		return curTick - windowStart;
+	}
+
+	/**
+	 * @return The average occupancy over the window.
+	 */
+	double average(){
+		Tick ticks = getWindowTicks();
+		if(ticks == 0) return 0.0;
+		return (double) getArea() / (double) ticks;
+	}
+
+	/**
+	 * @return The average occupancy over the ticks the queue was not empty.
+	 */
+	double busyAverage(){
+		Tick busy = getBusyTicks();
+		if(busy == 0) return 0.0;
+		return (double) area / (double) busy;
+	}
+
+	/**
+	 * Starts a new window, the current occupancy is kept.
+	 */
+	void reset(){
+		update();
+		area = 0;
+		busyTicks = 0;
+		windowStart = curTick;
+	}
+};
+
+#endif /* OCCUPANCY_HH_ */
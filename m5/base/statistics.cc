@@ -29,6 +29,8 @@
  * DAMAGES.
  */
 
+#include <fnmatch.h>
+
 #include <iomanip>
 #include <fstream>
 #include <list>
@@ -51,6 +53,35 @@ using namespace std;
 
 namespace Stats {
 
+namespace {
+vector<string> includePatterns;
+vector<string> excludePatterns;
+
+bool
+matchAny(const vector<string> &patterns, const string &name)
+{
+    for (int i = 0; i < patterns.size(); ++i)
+	if (fnmatch(patterns[i].c_str(), name.c_str(), 0) == 0)
+	    return true;
+    return false;
+}
+}
+
+void
+setFilter(const vector<string> &include, const vector<string> &exclude)
+{
+    includePatterns = include;
+    excludePatterns = exclude;
+}
+
+bool
+filterOut(const string &name)
+{
+    if (!includePatterns.empty() && !matchAny(includePatterns, name))
+	return true;
+    return matchAny(excludePatterns, name);
+}
+
 StatData *
 DataAccess::find() const
 {
@@ -209,6 +240,12 @@ FormulaBase::str() const
     return root ? root->str() : "";
 }
 
+const StatData *
+FormulaBase::filteredStat() const
+{
+    return root ? root->filteredStat() : NULL;
+}
+
 Formula::Formula()
 {
     setInit();
@@ -278,12 +315,33 @@ check()
 	assert(data);
         if (!data->check() || !data->baseCheck())
 	    panic("stat check failed for %s\n", data->name);
+
+	// all stats are set up now, so the flags are final
+	if (data->released())
+	    data->release();
     }
 
-    int j = 0;
     for (i = Database::stats().begin(); i != end; ++i) {
 	StatData *data = *i;
+
+	// printed stats must not be calculated from released stats,
+	// since all elements of a released vector share one storage
 	if (!(data->flags & print))
+	    continue;
+
+	const StatData *dep = data->filteredStat();
+	if (!dep && data->prereq && data->prereq->released())
+	    dep = data->prereq;
+	if (dep)
+	    fatal("stat %s depends on %s, which is removed by the stat "
+		  "filter", data->name, dep->name);
+    }
+
+    // released stats keep their names for the panic on a later read
+    int j = 0;
+    for (i = Database::stats().begin(); i != end; ++i) {
+	StatData *data = *i;
+	if (!(data->flags & print) && !data->released())
 	    data->name = "__Stat" + to_string(j++);
     }
 
@@ -60,6 +60,7 @@
 
 #include "base/cprintf.hh"
 #include "base/intmath.hh"
+#include "base/misc.hh"
 #include "base/refcnt.hh"
 #include "base/str.hh"
 #include "base/stats/bin.hh"
@@ -77,6 +78,20 @@ extern Tick curTick;
 /* A namespace for all of the Statistics */
 namespace Stats {
 
+/**
+ * Sets the stat filter. A stat is kept if it matches one of the include
+ * patterns, or there are none, and matches none of the exclude patterns.
+ * The patterns are shell globs matched against the full stat name.
+ * Stats named before the filter is set are always kept.
+ */
+void setFilter(const std::vector<std::string> &include,
+	       const std::vector<std::string> &exclude);
+
+/**
+ * @return true if the stat with the given name is filtered out.
+ */
+bool filterOut(const std::string &name);
+
 /* Contains the statistic implementation details */
 //////////////////////////////////////////////////////////////////////
 //
@@ -128,6 +143,25 @@ struct StatData
     virtual bool check() const = 0;
     bool baseCheck() const;
 
+    /**
+     * @return A filtered stat this stat is calculated from, or NULL.
+     */
+    virtual const StatData *filteredStat() const { return NULL; }
+
+    /**
+     * @return true if the stat is filtered out and its storage is
+     * released when the stats are checked.
+     */
+    bool released() const
+    {
+	return (flags & filtered) && !(flags & nofilter);
+    }
+
+    /**
+     * Release the storage of a filtered stat.
+     */
+    virtual void release() { }
+
     /**
      * Visitor entry for outputing statistics data
      */
@@ -209,6 +243,7 @@ class VectorStatData : public VectorData
     virtual bool check() const { return s.check(); }
     virtual bool zero() const { return s.zero(); }
     virtual void reset() { s.reset(); }
+    virtual void release() { s.release(); }
 
     virtual size_t size() const { return s.size(); }
     virtual VCounter &value() const
@@ -310,6 +345,7 @@ class VectorDistStatData : public VectorDistData
     virtual bool binned() const { return bin_t::binned; }
     virtual bool check() const { return s.check(); }
     virtual void reset() { s.reset(); }
+    virtual void release() { s.release(); }
     virtual size_t size() const { return s.size(); }
     virtual bool zero() const { return s.zero(); }
     virtual void visit(Visit &visitor)
@@ -352,6 +388,7 @@ class Vector2dStatData : public Vector2dData
     virtual bool binned() const { return bin_t::binned; }
     virtual bool check() const { return s.check(); }
     virtual void reset() { s.reset(); }
+    virtual void release() { s.release(); }
     virtual bool zero() const { return s.zero(); }
     virtual void visit(Visit &visitor)
     {
@@ -373,6 +410,9 @@ class DataAccess
 
     void setInit();
     void setPrint();
+
+    /** Stats without vector storage have nothing to release. */
+    void release() { }
 };
 
 template <class Parent, class Child, template <class> class Data>
@@ -424,7 +464,10 @@ class Wrap : public Child
     {
 	Data<Child> *data = this->statData();
 	data->name = _name;
-	this->setPrint();
+	if (filterOut(_name))
+	    data->flags |= filtered;
+	else
+	    this->setPrint();
 	return this->self();
     }
 
@@ -976,6 +1019,10 @@ class VectorBase : public DataAccess
      * @return The total of all vector entries.
      */
     Result total() const {
+	if (bin.released())
+	    panic("%s is removed by the stat filter and cannot be read\n",
+		  statData()->name);
+
 	Result total = 0.0;
 	for (int i = 0; i < size(); ++i)
 	    total += data(i)->result(params);
@@ -1001,6 +1048,8 @@ class VectorBase : public DataAccess
   public:
     VectorBase() {}
 
+    void release() { bin.release(params); }
+
     /** Friend this class with the associated scalar proxy. */
     friend class ScalarProxy<Storage, Bin>;
 
@@ -1061,7 +1110,13 @@ class ScalarProxy
      * Return the current value of this stat as its base type.
      * @return The current value.
      */
-    Counter value() const { return data()->value(*params); }
+    Counter value() const
+    {
+	if (bin->released())
+	    panic("%s is removed by the stat filter and cannot be read\n",
+		  str());
+	return data()->value(*params);
+    }
 
     /**
      * Return the current value of this statas a result type.
@@ -1201,6 +1256,8 @@ class Vector2dBase : public DataAccess
   public:
     Vector2dBase() {}
 
+    void release() { bin.release(params); }
+
     void update(Vector2dData *data)
     {
 	int size = this->size();
@@ -1721,6 +1778,8 @@ class VectorDistBase : public DataAccess
   public:
     VectorDistBase() {}
 
+    void release() { bin.release(params); }
+
     friend class DistProxy<Storage, Bin>;
     DistProxy<Storage, Bin> operator[](int index);
     const DistProxy<Storage, Bin> operator[](int index) const;
@@ -1860,6 +1919,11 @@ class Node : public RefCounted
      *
      */
     virtual std::string str() const = 0;
+
+    /**
+     * @return A filtered stat in this subtree, or NULL.
+     */
+    virtual const StatData *filteredStat() const { return NULL; }
 };
 
 /** Reference counting pointer to a function Node. */
@@ -1891,6 +1955,12 @@ class ScalarStatNode : public Node
      *
      */
     virtual std::string str() const { return data->name; }
+
+    virtual const StatData *
+    filteredStat() const
+    {
+	return data->released() ? data : NULL;
+    }
 };
 
 template <class Storage, class Bin>
@@ -1921,6 +1991,13 @@ class ScalarProxyNode : public Node
      *
      */
     virtual std::string str() const { return proxy.str(); }
+
+    virtual const StatData *
+    filteredStat() const
+    {
+	const StatData *data = proxy.statData();
+	return data->released() ? data : NULL;
+    }
 };
 
 class VectorStatNode : public Node
@@ -1941,6 +2018,12 @@ class VectorStatNode : public Node
     virtual bool binned() const { return data->binned(); }
 
     virtual std::string str() const { return data->name; }
+
+    virtual const StatData *
+    filteredStat() const
+    {
+	return data->released() ? data : NULL;
+    }
 };
 
 template <class T>
@@ -2044,6 +2127,8 @@ class UnaryNode : public Node
     {
 	return OpString<Op>::str() + l->str();
     }
+
+    virtual const StatData *filteredStat() const { return l->filteredStat(); }
 };
 
 template <class Op>
@@ -2115,6 +2200,13 @@ class BinaryNode : public Node
     {
 	return csprintf("(%s %s %s)", l->str(), OpString<Op>::str(), r->str());
     }
+
+    virtual const StatData *
+    filteredStat() const
+    {
+	const StatData *data = l->filteredStat();
+	return data ? data : r->filteredStat();
+    }
 };
 
 template <class Op>
@@ -2168,6 +2260,8 @@ class SumNode : public Node
     {
 	return csprintf("total(%s)", l->str());
     }
+
+    virtual const StatData *filteredStat() const { return l->filteredStat(); }
 };
 
 
@@ -2597,6 +2691,11 @@ class FormulaBase : public DataAccess
     void update(StatData *);
 
     std::string str() const;
+
+    /**
+     * @return A filtered stat this formula is calculated from, or NULL.
+     */
+    const StatData *filteredStat() const;
 };
 
 class FormulaData : public VectorData
@@ -2636,6 +2735,7 @@ class FormulaStatData : public FormulaData
 	visitor.visit(*this);
     }
     virtual std::string str() const { return s.str(); }
+    virtual const StatData *filteredStat() const { return s.filteredStat(); }
 };
 
 class Temp;
@@ -2687,6 +2787,12 @@ class FormulaNode : public Node
     virtual bool binned() const { return formula.binned(); }
 
     virtual std::string str() const { return formula.str(); }
+
+    virtual const StatData *
+    filteredStat() const
+    {
+	return formula.filteredStat();
+    }
 };
 
 /**
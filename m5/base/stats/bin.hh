@@ -206,6 +206,10 @@ struct MainBin
 		s->reset();
 	    }
 	}
+
+	/** Binned storage is shared by all stats and is kept. */
+	void release(Params &params) { }
+	bool released() const { return false; }
     };
 };
 
@@ -255,27 +259,38 @@ struct NoBin
       private:
 	char *ptr;
 	int _size;
+	/** Bytes between elements, zero when the storage is released. */
+	int stride;
+
+	int count() const { return stride ? _size : 1; }
+
+	void destroy()
+	{
+	    for (int i = 0; i < count(); ++i) {
+		char *p = ptr + i * stride;
+		reinterpret_cast<Storage *>(p)->~Storage();
+	    }
+	    delete [] ptr;
+	}
 
       public:
-	VectorBin() : ptr(NULL) { }
+	VectorBin() : ptr(NULL), stride(0) { }
 	~VectorBin()
 	{
 	    if (!initialized())
 		return;
 
-	    for (int i = 0; i < _size; ++i) {
-		char *p = ptr + i * sizeof(Storage);
-		reinterpret_cast<Storage *>(p)->~Storage();
-	    }
-	    delete [] ptr;
+	    destroy();
 	}
 
 	bool initialized() const { return ptr != NULL; }
+	bool released() const { return initialized() && stride == 0; }
 	void init(int s, Params &params)
 	{
 	    assert(s > 0 && "size must be positive!");
 	    assert(!initialized());
 	    _size = s;
+	    stride = sizeof(Storage);
 	    ptr = new char[_size * sizeof(Storage)];
 	    for (int i = 0; i < _size; ++i)
 		new (ptr + i * sizeof(Storage)) Storage(params);
@@ -287,16 +302,31 @@ struct NoBin
 	{
 	    assert(initialized());
 	    assert(index >= 0 && index < size());
-	    return reinterpret_cast<Storage *>(ptr + index * sizeof(Storage));
+	    return reinterpret_cast<Storage *>(ptr + index * stride);
 	}
 	void reset()
 	{
-	    for (int i = 0; i < _size; ++i) {
-		char *p = ptr + i * sizeof(Storage);
+	    for (int i = 0; i < count(); ++i) {
+		char *p = ptr + i * stride;
 		Storage *s = reinterpret_cast<Storage *>(p);
 		s->reset();
 	    }
 	}
+
+	/**
+	 * Replaces the storage with a single element that all indices
+	 * map to. Used for stats that are never printed.
+	 */
+	void release(Params &params)
+	{
+	    if (!initialized() || stride == 0)
+		return;
+
+	    destroy();
+	    ptr = new char[sizeof(Storage)];
+	    new (ptr) Storage(params);
+	    stride = 0;
+	}
     };
 };
 
@@ -57,11 +57,15 @@ const StatFlags dist = 		0x00000080;
 const StatFlags nozero =	0x00000100;
 /** Don't print if this is NAN */
 const StatFlags nonan =		0x00000200;
+/** Removed by the stat filter, not printed and not stored. */
+const StatFlags filtered =	0x00000400;
+/** Read by the simulator, keeps its storage if filtered. */
+const StatFlags nofilter =	0x00000800;
 /** Used for SS compatability. */
 const StatFlags __substat = 	0x80000000;
 
 /** Mask of flags that can't be set directly */
-const StatFlags __reserved =	init | print | __substat;
+const StatFlags __reserved =	init | print | filtered | __substat;
 
 enum DisplayMode
 {
@@ -34,6 +34,7 @@
 
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/cprintf.hh"
 #include "base/match.hh"
 #include "sim/host.hh"
@@ -154,7 +155,10 @@ namespace Trace {
     inline void
     dataDump(Tick cycle, const std::string &name, const void *data, int len)
     {
-	theLog.append(new Trace::DataRecord(cycle, name, data, len));
+	if (binaryLog.enabled())
+	    binaryLog.dataDump(cycle, name, data, len);
+	else
+	    theLog.append(new Trace::DataRecord(cycle, name, data, len));
     }
 
     extern const std::string DefaultName;
@@ -181,6 +185,9 @@ std::ostream &DebugOut();
 // If you desire that the automatic printing not occur, use DPRINTFR
 // (R for raw)
 //
+// When the trace is written in the binary format, the arguments are
+// copied to the binary log and formatted offline by util/tracedecode.
+//
 
 #if TRACING_ON
 
@@ -194,29 +201,39 @@ do { \
         Trace::dataDump(curTick, name(), data, count);	\
 } while (0)
 
-#define __dprintf(cycle, name, format, args...) \
-    Trace::dprintf(format, (*(new cp::ArgList), args), cycle, name)
+#define __dprintf(flag, cycle, name, format, args...) \
+do { \
+    if (Trace::binaryLog.enabled()) { \
+        const std::string &__name = name; \
+        if (__name.empty() || !Trace::ignore.match(__name)) { \
+            Trace::BinaryRecord __rec(flag, cycle, __name, format); \
+            (__rec, args); \
+        } \
+    } else { \
+        Trace::dprintf(format, (*(new cp::ArgList), args), cycle, name); \
+    } \
+} while (0)
 
 #define DPRINTF(x, args...) \
 do { \
     if (Trace::IsOn(Trace::x)) \
-        __dprintf(curTick, name(), args, cp::ArgListNull()); \
+        __dprintf(Trace::x, curTick, name(), args, cp::ArgListNull()); \
 } while (0)
 
 #define DPRINTFR(x, args...) \
 do { \
     if (Trace::IsOn(Trace::x)) \
-        __dprintf((Tick)-1, string(), args, cp::ArgListNull()); \
+        __dprintf(Trace::x, (Tick)-1, string(), args, cp::ArgListNull()); \
 } while (0)
 
 #define DPRINTFN(args...) \
 do { \
-    __dprintf(curTick, name(), args, cp::ArgListNull()); \
+    __dprintf(-1, curTick, name(), args, cp::ArgListNull()); \
 } while (0)
 
 #define DPRINTFNR(args...) \
 do { \
-    __dprintf((Tick)-1, string(), args, cp::ArgListNull()); \
+    __dprintf(-1, (Tick)-1, string(), args, cp::ArgListNull()); \
 } while (0)
 
 #else // !TRACING_ON
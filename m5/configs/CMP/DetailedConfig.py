@@ -28,6 +28,8 @@ class DefaultBranchPred(BranchPred):
 class DetailedCPU(FullCPU):
 
     iq = StandardIQ(size = 64, caps = [0, 0, 0, 0])
+    if "BITMAP-ISSUE-SELECT" in env:
+        iq.bitmap_select = bool(env["BITMAP-ISSUE-SELECT"])
     iq_comm_latency = 1
     fupools = DefaultFUP()
     lsq_size = 32
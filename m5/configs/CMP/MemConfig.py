@@ -444,3 +444,19 @@ class DDR4(BaseMemory):
         static_memory_latency = True
     else:
         static_memory_latency = False
+
+# DDR4-2666 with bank groups, tFAW and refresh, timed by the ddr engine
+class DDR4Detailed(DDR4):
+    timing_model = "ddr"
+    num_ranks = 1
+    num_bank_groups = 4
+    
+    internal_row_to_row = 4 # tRRD_S
+    row_to_row_long = 7 # tRRD_L
+    internal_write_to_read = 4 # tWTR_S
+    write_to_read_long = 10 # tWTR_L
+    CAS_to_CAS_long = 7 # tCCD_L
+    four_activate_window = 28
+    rank_to_rank_switch = 2
+    refresh_interval = 10400 # 7.8 us
+    refresh_cycle_time = 467 # 350 ns, 8 Gb devices
@@ -0,0 +1,79 @@
+from m5 import *
+from MemConfig import *
+
+###############################################################################
+# Memory controller replay
+#
+# Replays the request streams recorded by a CMP run (-ERECORD-MEMORY-REQUESTS)
+# through the memory controllers without CPUs or caches, e.g.:
+#
+# ./m5.opt -ENP=4 -EREPLAY-TRACE=membus0-requests.bin -ESTATSFILE=replay.txt
+#          -EMEMORY-BUS-INTERFACE=DDR2 -EMEMORY-BUS-SCHEDULER=RDFCFS
+#          ../../configs/CMP/replay.py
+#
+# REPLAY-TRACE is a comma separated list with one stream per channel.
+# REPLAY-MLP limits the number of reads in flight per CPU (closed loop
+# replay), by default requests arrive at their recorded times.
+###############################################################################
+
+if 'STATSFILE' not in env:
+    panic('No statistics file name given! (-ESTATSFILE=foobar.txt)')
+
+if 'REPLAY-TRACE' not in env:
+    panic('No request streams given! (-EREPLAY-TRACE=membus0-requests.bin)')
+
+traces = env['REPLAY-TRACE'].split(',')
+channels = len(traces)
+
+replayMLP = 0
+if 'REPLAY-MLP' in env:
+    replayMLP = int(env['REPLAY-MLP'])
+
+HierParams.cpu_count = int(env['NP'])
+
+root = Root(clock = '4000MHz')
+
+root.membus = [ConventionalMemBus() for i in range(channels)]
+
+assert 'MEMORY-BUS-INTERFACE' in env
+assert env['MEMORY-BUS-INTERFACE'] in ["DDR2", "DDR4", "DDR4-DETAILED"], "Memory bus interface must be either DDR2, DDR4 or DDR4-DETAILED"
+if env['MEMORY-BUS-INTERFACE'] == "DDR2":
+    root.ram = [DDR2(in_bus=root.membus[i]) for i in range(channels)]
+elif env['MEMORY-BUS-INTERFACE'] == "DDR4":
+    root.ram = [DDR4(in_bus=root.membus[i]) for i in range(channels)]
+else:
+    root.ram = [DDR4Detailed(in_bus=root.membus[i]) for i in range(channels)]
+
+assert 'MEMORY-BUS-SCHEDULER' in env
+for i in range(channels):
+    if env["MEMORY-BUS-SCHEDULER"] == "RDFCFS":
+        root.membus[i].memory_controller = ReadyFirstMemoryController()
+        if "MEMORY-BUS-PAGE-POLICY" in env:
+            root.membus[i].memory_controller.page_policy = env["MEMORY-BUS-PAGE-POLICY"]
+        if "MEMORY-BUS-PRIORITY-SCHEME" in env:
+            root.membus[i].memory_controller.priority_scheme = env["MEMORY-BUS-PRIORITY-SCHEME"]
+    elif env["MEMORY-BUS-SCHEDULER"] == "FCFS":
+        root.membus[i].memory_controller = InOrderMemoryController()
+    elif env["MEMORY-BUS-SCHEDULER"] == "FBW":
+        root.membus[i].memory_controller = FixedBandwidthController()
+    else:
+        panic("Only the FCFS, RDFCFS and FBW memory bus schedulers can be replayed")
+
+if int(env['NP']) > 1 and "MEMORY-BUS-INTERFERENCE-SCHEME" in env:
+    if env["MEMORY-BUS-INTERFERENCE-SCHEME"] == "DIEF":
+        root.controllerInterference = [RDFCFSControllerInterference(memory_controller=root.membus[i].memory_controller) for i in range(channels)]
+    elif env["MEMORY-BUS-INTERFERENCE-SCHEME"] == "DuBois":
+        root.controllerInterference = [DuBoisInterference(memory_controller=root.membus[i].memory_controller) for i in range(channels)]
+    else:
+        panic("MEMORY-BUS-INTERFERENCE-SCHEME must be either DIEF or DuBois")
+    
+    for i in range(channels):
+        root.controllerInterference[i].cpu_count = int(env['NP'])
+
+root.trafficGenerators = [TrafficGenerator(membus=root.membus[i],
+                                           use_id=int(env['NP']),
+                                           replay_trace=traces[i],
+                                           replay_mlp=replayMLP)
+                          for i in range(channels)]
+
+root.stats = Statistics(text_file=env['STATSFILE'])
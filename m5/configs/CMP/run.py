@@ -123,11 +123,30 @@ def createMemBus(bankcnt, optPart, useMissBWPolicy):
     root.membus = [ConventionalMemBus() for i in range(channels)]
     
     assert 'MEMORY-BUS-INTERFACE' in env
-    assert env['MEMORY-BUS-INTERFACE'] in ["DDR2", "DDR4"], "Memory bus interface must be either DDR2 or DDR4"
+    assert env['MEMORY-BUS-INTERFACE'] in ["DDR2", "DDR4", "DDR4-DETAILED"], "Memory bus interface must be either DDR2, DDR4 or DDR4-DETAILED"
     if env['MEMORY-BUS-INTERFACE'] == "DDR2":
         root.ram = [DDR2(in_bus=root.membus[i]) for i in range(channels)]
-    else:
+    elif env['MEMORY-BUS-INTERFACE'] == "DDR4":
         root.ram = [DDR4(in_bus=root.membus[i]) for i in range(channels)]
+    else:
+        root.ram = [DDR4Detailed(in_bus=root.membus[i]) for i in range(channels)]
+    
+    if "MEMORY-ADDRESS-MAPPING" in env:
+        mapping = env["MEMORY-ADDRESS-MAPPING"]
+        assert mapping in ["page", "block", "page-xor", "block-xor"], "Memory address mapping must be page, block, page-xor or block-xor"
+        for i in range(channels):
+            if mapping.startswith("block"):
+                # The bits above the block offset select the shared cache bank
+                # and thereby the channel, bank interleaving starts above them
+                interleaveBit = 6
+                while (1 << (interleaveBit - 6)) < bankcnt:
+                    interleaveBit += 1
+                root.ram[i].bank_interleave_bit = interleaveBit
+            root.ram[i].xor_bank_hash = mapping.endswith("xor")
+    
+    if "RECORD-MEMORY-REQUESTS" in env:
+        for i in range(channels):
+            root.membus[i].arrival_trace = "membus"+str(i)+"-requests.bin"
     
     useTrafficGenerator = False
     if "GENERATE-BACKGROUND-TRAFFIC" in env:
@@ -674,7 +693,7 @@ def copyCheckpointFiles(directory):
     checkpointfiles = os.listdir(directory)
     
     for name in checkpointfiles:
-        if name != "m5.cpt" and name != "m5.cpt.old":
+        if name != "m5.cpt" and name != "m5.cpt.old" and name != "m5.cpz":
             
             if not os.path.isdir(directory+"/"+name):
                 print >> sys.stderr, "Linking/copying file "+name+" to current directory"
@@ -707,9 +726,6 @@ def copyCheckpointFiles(directory):
                             cnt += 1
                         if not successful:
                             raise Exception("Could not copy file "+str(newname)+", retried 5 times")
-                    
-                    print >> sys.stderr, "Creating clean copy of "+newname+" for simulation point restarts"
-                    shutil.copy(newname, newname+".clean")
                     continue
                 else:
                     if os.path.exists(name):
@@ -1288,6 +1304,24 @@ elif env['MEMORY-SYSTEM'] == "RingBased":
 else:
     panic("MEMORY-SYSTEM parameter must be Legacy, CrossbarBased or RingBased")
 
+if "PRIVATE-MODE-REFERENCE" in env:
+    assert int(env["NP"]) > 1, "The private mode reference is only needed in shared mode"
+    assert int(env["MEMORY-BUS-CHANNELS"]) == 1, "The private mode reference models a single memory channel"
+
+    root.privateModeReference = PrivateModeReference()
+    root.privateModeReference.interferenceManager = root.interferenceManager
+    root.privateModeReference.cpuCount = int(env["NP"])
+    root.privateModeReference.size = root.SharedCache[0].size
+    root.privateModeReference.banks = bankcnt
+    root.privateModeReference.assoc = root.SharedCache[0].assoc
+    root.privateModeReference.blockSize = root.SharedCache[0].block_size
+    root.privateModeReference.cacheLatency = root.SharedCache[0].latency
+    root.privateModeReference.memory = root.ram[0]
+    if env["PRIVATE-MODE-REFERENCE"] != "":
+        aloneTraces = env["PRIVATE-MODE-REFERENCE"].split(",")
+        assert len(aloneTraces) == int(env["NP"]), "PRIVATE-MODE-REFERENCE needs one CommittedInsts trace per core"
+        root.privateModeReference.aloneTraces = aloneTraces
+
 
 ###############################################################################
 # Workloads
@@ -32,7 +32,14 @@
 #include <fstream>
 #include <iomanip>
 
+#include <map>
+
+#include "base/callback.hh"
+#include "base/compact_trace.hh"
+#include "base/hashmap.hh"
+#include "base/output.hh"
 #include "sim/param.hh"
+#include "sim/sim_exit.hh"
 #include "encumbered/cpu/full/dyn_inst.hh"
 #include "encumbered/cpu/full/spec_state.hh"
 #include "encumbered/cpu/full/issue.hh"
@@ -136,7 +143,128 @@ Trace::InstRecord::dump(ostream &outs)
 }
 
 
+////////////////////////////////////////////////////////////////////////
+//
+//  Binary trace
+//
+//  Records start with a record type byte.  CPU names, and the PC
+//  text, disassembly and op class of each static instruction, are
+//  written once and then implied by the CPU id and the PC.  The
+//  instruction record holds a mask of the valid fields, the CPU id,
+//  the cycle and PC as deltas, the thread, and the valid fields with
+//  addresses and sequence numbers as deltas.
+//
+
+namespace {
+
+enum BinaryExeRecord {
+    ExeCPUDef = 1,
+    ExeStaticDef,
+    ExeInst
+};
+
+enum BinaryExeField {
+    ExeMisspec = 0x01,
+    ExeAddr = 0x02,
+    ExeData = 0x04,
+    ExeFetchSeq = 0x08,
+    ExeCPSeq = 0x10,
+    ExeRegs = 0x20
+};
+
+map<BaseCPU *, int> binaryCPUs;
+m5::hash_map<Addr, MachInst> binaryStatics;
+
+uint64_t lastCycle = 0;
+uint64_t lastPC = 0;
+uint64_t lastAddr = 0;
+uint64_t lastFetchSeq = 0;
+uint64_t lastCPSeq = 0;
+
+class BinaryExeTraceCallback : public Callback
+{
+  public:
+    virtual void process()
+    {
+	delete Trace::InstRecord::binaryTrace;
+	Trace::InstRecord::binaryTrace = NULL;
+    }
+};
+
+}
+
+void
+Trace::InstRecord::dumpBinary()
+{
+    CompactTraceWriter *out = binaryTrace;
+
+    map<BaseCPU *, int>::iterator cpuIt = binaryCPUs.find(cpu);
+    if (cpuIt == binaryCPUs.end()) {
+	int id = binaryCPUs.size();
+	cpuIt = binaryCPUs.insert(make_pair(cpu, id)).first;
+	out->putByte(ExeCPUDef);
+	out->putVarint(id);
+	out->putString(cpu->name());
+    }
+
+    m5::hash_map<Addr, MachInst>::iterator staticIt = binaryStatics.find(PC);
+    if (staticIt == binaryStatics.end() ||
+	staticIt->second != staticInst->machInst) {
+	binaryStatics[PC] = staticInst->machInst;
+
+	std::string sym_str;
+	Addr sym_addr;
+	if (debugSymbolTable
+	    && debugSymbolTable->findNearestSymbol(PC, sym_str, sym_addr)) {
+	    if (PC != sym_addr)
+		sym_str += csprintf("+%d", PC - sym_addr);
+	    sym_str = "@" + sym_str;
+	}
+	else {
+	    sym_str = csprintf("0x%x", PC);
+	}
+
+	out->putByte(ExeStaticDef);
+	out->putVarint(PC);
+	out->putString(sym_str);
+	out->putString(staticInst->disassemble(PC, debugSymbolTable));
+	out->putString(opClassStrings[staticInst->opClass()]);
+    }
+
+    uint8_t fields = 0;
+    if (misspeculating) fields |= ExeMisspec;
+    if (addr_valid) fields |= ExeAddr;
+    if (data_status != DataInvalid) fields |= ExeData;
+    if (fetch_seq_valid) fields |= ExeFetchSeq;
+    if (cp_seq_valid) fields |= ExeCPSeq;
+    if (regs_valid) fields |= ExeRegs;
+
+    out->putByte(ExeInst);
+    out->putByte(fields);
+    out->putVarint(cpuIt->second);
+    out->putDelta(cycle, lastCycle);
+    out->putDelta(PC, lastPC);
+    out->putVarint(thread);
+
+    if (addr_valid)
+	out->putDelta(addr, lastAddr);
+    if (data_status != DataInvalid) {
+	out->putByte(data_status);
+	out->putVarint(data.as_int);
+    }
+    if (fetch_seq_valid)
+	out->putDelta(fetch_seq, lastFetchSeq);
+    if (cp_seq_valid)
+	out->putDelta(cp_seq, lastCPSeq);
+    if (regs_valid) {
+	for (int i = 0; i < 32; ++i)
+	    out->putVarint(iregs->regs[i]);
+    }
+}
+
+
 vector<bool> Trace::InstRecord::flags(NUM_BITS);
+CompactTraceWriter *Trace::InstRecord::binaryTrace = NULL;
 
 ////////////////////////////////////////////////////////////////////////
 //
@@ -175,6 +303,10 @@ Param<bool> exe_trace_print_fetchseq(&exeTraceParams, "print_fetchseq",
 				  "print fetch sequence number", false);
 Param<bool> exe_trace_print_cp_seq(&exeTraceParams, "print_cpseq",
 				  "print correct-path sequence number", false);
+Param<string> exe_trace_format(&exeTraceParams, "format",
+			       "trace output format (text or binary)", "text");
+Param<string> exe_trace_file(&exeTraceParams, "file",
+			     "binary trace file", "exetrace.bin");
 
 //
 // Helper function for ExecutionTraceParamContext::checkParams() just
@@ -198,6 +330,25 @@ Trace::InstRecord::setParams()
 void
 ExecutionTraceParamContext::checkParams()
 {
-    Trace::InstRecord::setParams();
+    using namespace Trace;
+
+    InstRecord::setParams();
+
+    if ((string)exe_trace_format == "binary") {
+	InstRecord::binaryTrace =
+	    new CompactTraceWriter(simout.resolve(exe_trace_file), "exec", 1);
+
+	// the print options are kept so the decoder prints the same text
+	uint64_t mask = 0;
+	for (int i = 0; i < InstRecord::NUM_BITS; ++i)
+	    if (InstRecord::flags[i])
+		mask |= ULL(1) << i;
+	InstRecord::binaryTrace->putVarint(mask);
+
+	registerExitCallback(new BinaryExeTraceCallback);
+    }
+    else if ((string)exe_trace_format != "text") {
+	fatal("Unknown execution trace format %s", (string)exe_trace_format);
+    }
 }
 
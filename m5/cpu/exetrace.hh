@@ -42,6 +42,7 @@
 #include "cpu/static_inst.hh"
 
 class BaseCPU;
+class CompactTraceWriter;
 
 
 namespace Trace {
@@ -134,7 +135,10 @@ class InstRecord : public Record
 
     void setRegs(const IntRegFile &regs);
 
-    void finalize() { theLog.append(this); }
+    void finalize();
+
+    /// Writes the record to the binary trace
+    void dumpBinary();
 
     enum InstExecFlagBits {
 	TRACE_MISSPEC = 0,
@@ -151,6 +155,9 @@ class InstRecord : public Record
 
     static std::vector<bool> flags;
 
+    /// The binary trace, NULL when the trace is written as text
+    static CompactTraceWriter *binaryTrace;
+
     static void setParams();
 
     static bool traceMisspec() { return flags[TRACE_MISSPEC]; }
@@ -167,6 +174,17 @@ InstRecord::setRegs(const IntRegFile &regs)
     regs_valid = true;
 }
 
+inline void
+InstRecord::finalize()
+{
+    if (binaryTrace) {
+	dumpBinary();
+	delete this;
+    } else {
+	theLog.append(this);
+    }
+}
+
 inline
 InstRecord *
 getInstRecord(Tick cycle, ExecContext *xc, BaseCPU *cpu,
@@ -0,0 +1,13 @@
+/*
+ * bitmap_inst_queue.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include "cpu/o3/alpha_dyn_inst.hh"
+#include "cpu/o3/alpha_impl.hh"
+#include "cpu/o3/bitmap_inst_queue_impl.hh"
+
+// Force instantiation of BitmapInstQueue.
+template class BitmapInstQueue<AlphaSimpleImpl>;
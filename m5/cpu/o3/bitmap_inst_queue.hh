@@ -0,0 +1,202 @@
+/*
+ * bitmap_inst_queue.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef BITMAP_INST_QUEUE_HH_
+#define BITMAP_INST_QUEUE_HH_
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/timebuf.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/iq_bitmap.hh"
+#include "sim/host.hh"
+
+/**
+ * An instruction queue built from a fixed array of entries and bit
+ * vectors, with the same interface as InstructionQueue.
+ *
+ * Each instruction occupies one entry while it waits to issue. Instead
+ * of priority queues and linked dependency lists, the queue keeps
+ *  - one ready bit vector per instruction class,
+ *  - an age matrix where row i has a bit set for every entry that is
+ *    older than entry i, so the oldest of a set of candidates is the
+ *    candidate whose row has no candidate bits set, and
+ *  - a dependency matrix with one row per physical register, where a
+ *    bit is set for every entry waiting for that register.
+ * Non-speculative instructions are marked in a separate bit vector.
+ * None of these allocate memory after construction, and waking up or
+ * squashing an instruction is a few bit operations.
+ *
+ * Memory instructions are tracked for register dependences like all
+ * other instructions, but are handed to the memory dependence unit
+ * when their registers are ready, exactly as in InstructionQueue.
+ */
+template <class Impl>
+class BitmapInstQueue
+{
+  public:
+    //Typedefs from the Impl.
+    typedef typename Impl::FullCPU FullCPU;
+    typedef typename Impl::DynInstPtr DynInstPtr;
+    typedef typename Impl::Params Params;
+
+    typedef typename Impl::CPUPol::MemDepUnit_TYPE MemDepUnit;
+    typedef typename Impl::CPUPol::IssueStruct_TYPE IssueStruct;
+    typedef typename Impl::CPUPol::TimeStruct TimeStruct;
+
+    BitmapInstQueue(Params &params);
+
+    void regStats();
+
+    void setCPU(FullCPU *cpu);
+
+    void setIssueToExecuteQueue(TimeBuffer<IssueStruct> *i2eQueue);
+
+    void setTimeBuffer(TimeBuffer<TimeStruct> *tb_ptr);
+
+    unsigned numFreeEntries();
+
+    bool isFull();
+
+    void insert(DynInstPtr &new_inst);
+
+    void insertNonSpec(DynInstPtr &new_inst);
+
+    void advanceTail(DynInstPtr &inst);
+
+    void scheduleReadyInsts();
+
+    void scheduleNonSpec(const InstSeqNum &inst);
+
+    void wakeDependents(DynInstPtr &completed_inst);
+
+    void violation(DynInstPtr &store, DynInstPtr &faulting_load);
+
+    void squash();
+
+    void doSquash();
+
+    void stopSquash();
+
+  private:
+    /** Pointer to the CPU. */
+    FullCPU *cpu;
+
+    /** The memory dependence unit. */
+    MemDepUnit memDepUnit;
+
+    /** The queue to the execute stage. */
+    TimeBuffer<IssueStruct> *issueToExecuteQueue;
+
+    /** The backwards time buffer. */
+    TimeBuffer<TimeStruct> *timeBuffer;
+
+    /** Wire to read information from timebuffer. */
+    typename TimeBuffer<TimeStruct>::wire fromCommit;
+
+    /** The instruction classes that have their own ready bit vector. */
+    enum InstClass {
+        Int,
+        Float,
+        Branch,
+        Misc,
+        Memory,
+        NumReadyClasses = Memory
+    };
+
+    /** The instruction held by each entry. */
+    std::vector<DynInstPtr> insts;
+
+    /** The class of the instruction in each entry. */
+    std::vector<InstClass> instClass;
+
+    /** Entries that are not in use. */
+    std::vector<int> freeList;
+
+    /** Entries holding an instruction. */
+    IQBitmap valid;
+
+    /** Entries holding a memory instruction. */
+    IQBitmap memInsts;
+
+    /** Entries holding a non-speculative instruction not yet scheduled. */
+    IQBitmap nonSpecInsts;
+
+    /** Entries ready to issue, per instruction class. */
+    IQBitmap ready[NumReadyClasses];
+
+    /** Row i holds the entries that are older than entry i. */
+    std::vector<IQBitmap> ageMatrix;
+
+    /** Row r holds the entries waiting for physical register r. */
+    std::vector<IQBitmap> dependMatrix;
+
+    /** Scratch vector for the issue candidates. */
+    IQBitmap candidates;
+
+    /** Number of free IQ entries left. */
+    unsigned freeEntries;
+
+    /** The number of entries in the instruction queue. */
+    unsigned numEntries;
+
+    /** Issue widths per class and in total. */
+    unsigned intWidth;
+    unsigned floatWidth;
+    unsigned branchWidth;
+    unsigned memoryWidth;
+    unsigned totalWidth;
+
+    /** The number of physical registers in the CPU. */
+    unsigned numPhysRegs;
+    unsigned numPhysIntRegs;
+    unsigned numPhysFloatRegs;
+
+    /** Delay between commit stage and the IQ. */
+    unsigned commitToIEWDelay;
+
+    /** The sequence number of the squashed instruction. */
+    InstSeqNum squashedSeqNum;
+
+    /** Secondary scoreboard, true if the register has been written. */
+    std::vector<bool> regScoreboard;
+
+    int allocateEntry(DynInstPtr &inst);
+    void freeEntry(int entry);
+    int findEntry(DynInstPtr &inst);
+
+    /** @return The oldest entry among the candidates, or -1. */
+    int selectOldest(const IQBitmap &cands);
+
+    void addToDependents(int entry);
+    void removeFromDependents(int entry);
+    void createDependency(DynInstPtr &new_inst);
+
+    void addIfReady(int entry);
+
+    /** Debugging function to dump the dependency matrix. */
+    void dumpDependGraph();
+
+    /** Debugging function to dump the ready and non-spec lists. */
+    void dumpLists();
+
+    Stats::Scalar<> iqInstsAdded;
+    Stats::Scalar<> iqNonSpecInstsAdded;
+    Stats::Scalar<> iqIntInstsIssued;
+    Stats::Scalar<> iqFloatInstsIssued;
+    Stats::Scalar<> iqBranchInstsIssued;
+    Stats::Scalar<> iqMemInstsIssued;
+    Stats::Scalar<> iqMiscInstsIssued;
+    Stats::Scalar<> iqSquashedInstsIssued;
+    Stats::Scalar<> iqLoopSquashStalls;
+    Stats::Scalar<> iqSquashedInstsExamined;
+    Stats::Scalar<> iqSquashedOperandsExamined;
+    Stats::Scalar<> iqSquashedNonSpecRemoved;
+};
+
+#endif /* BITMAP_INST_QUEUE_HH_ */
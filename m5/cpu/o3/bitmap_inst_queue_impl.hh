@@ -0,0 +1,736 @@
+/*
+ * bitmap_inst_queue_impl.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <vector>
+
+#include "sim/root.hh"
+
+#include "cpu/o3/bitmap_inst_queue.hh"
+
+template <class Impl>
+BitmapInstQueue<Impl>::BitmapInstQueue(Params &params)
+    : memDepUnit(params),
+      numEntries(params.numIQEntries),
+      intWidth(params.executeIntWidth),
+      floatWidth(params.executeFloatWidth),
+      branchWidth(params.executeBranchWidth),
+      memoryWidth(params.executeMemoryWidth),
+      totalWidth(params.issueWidth),
+      numPhysIntRegs(params.numPhysIntRegs),
+      numPhysFloatRegs(params.numPhysFloatRegs),
+      commitToIEWDelay(params.commitToIEWDelay)
+{
+    freeEntries = numEntries;
+    numPhysRegs = numPhysIntRegs + numPhysFloatRegs;
+    squashedSeqNum = 0;
+
+    DPRINTF(IQ, "IQ: There are %i physical registers.\n", numPhysRegs);
+
+    insts.resize(numEntries);
+    instClass.resize(numEntries, Misc);
+
+    // Hand out the lowest entries first
+    for (int i = numEntries - 1; i >= 0; --i) {
+        freeList.push_back(i);
+    }
+
+    valid.resize(numEntries);
+    memInsts.resize(numEntries);
+    nonSpecInsts.resize(numEntries);
+    candidates.resize(numEntries);
+    for (int i = 0; i < NumReadyClasses; ++i) {
+        ready[i].resize(numEntries);
+    }
+
+    ageMatrix.resize(numEntries);
+    for (int i = 0; i < numEntries; ++i) {
+        ageMatrix[i].resize(numEntries);
+    }
+
+    // As in InstructionQueue, all registers start out as unready; rename
+    // tells the instruction which of its registers are ready.
+    dependMatrix.resize(numPhysRegs);
+    for (int i = 0; i < numPhysRegs; ++i) {
+        dependMatrix[i].resize(numEntries);
+    }
+    regScoreboard.resize(numPhysRegs, false);
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::regStats()
+{
+    iqInstsAdded
+        .name(name() + ".iqInstsAdded")
+        .desc("Number of instructions added to the IQ (excludes non-spec)")
+        .prereq(iqInstsAdded);
+
+    iqNonSpecInstsAdded
+        .name(name() + ".iqNonSpecInstsAdded")
+        .desc("Number of non-speculative instructions added to the IQ")
+        .prereq(iqNonSpecInstsAdded);
+
+    iqIntInstsIssued
+        .name(name() + ".iqIntInstsIssued")
+        .desc("Number of integer instructions issued")
+        .prereq(iqIntInstsIssued);
+
+    iqFloatInstsIssued
+        .name(name() + ".iqFloatInstsIssued")
+        .desc("Number of float instructions issued")
+        .prereq(iqFloatInstsIssued);
+
+    iqBranchInstsIssued
+        .name(name() + ".iqBranchInstsIssued")
+        .desc("Number of branch instructions issued")
+        .prereq(iqBranchInstsIssued);
+
+    iqMemInstsIssued
+        .name(name() + ".iqMemInstsIssued")
+        .desc("Number of memory instructions issued")
+        .prereq(iqMemInstsIssued);
+
+    iqMiscInstsIssued
+        .name(name() + ".iqMiscInstsIssued")
+        .desc("Number of miscellaneous instructions issued")
+        .prereq(iqMiscInstsIssued);
+
+    iqSquashedInstsIssued
+        .name(name() + ".iqSquashedInstsIssued")
+        .desc("Number of squashed instructions issued")
+        .prereq(iqSquashedInstsIssued);
+
+    iqLoopSquashStalls
+        .name(name() + ".iqLoopSquashStalls")
+        .desc("Number of times issue loop had to restart due to squashed "
+              "inst; mainly for profiling")
+        .prereq(iqLoopSquashStalls);
+
+    iqSquashedInstsExamined
+        .name(name() + ".iqSquashedInstsExamined")
+        .desc("Number of squashed instructions iterated over during squash;"
+              " mainly for profiling")
+        .prereq(iqSquashedInstsExamined);
+
+    iqSquashedOperandsExamined
+        .name(name() + ".iqSquashedOperandsExamined")
+        .desc("Number of squashed operands that are examined and possibly "
+              "removed from graph")
+        .prereq(iqSquashedOperandsExamined);
+
+    iqSquashedNonSpecRemoved
+        .name(name() + ".iqSquashedNonSpecRemoved")
+        .desc("Number of squashed non-spec instructions that were removed")
+        .prereq(iqSquashedNonSpecRemoved);
+
+    // Tell mem dependence unit to reg stats as well.
+    memDepUnit.regStats();
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::setCPU(FullCPU *cpu_ptr)
+{
+    cpu = cpu_ptr;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::setIssueToExecuteQueue(
+                        TimeBuffer<IssueStruct> *i2e_ptr)
+{
+    DPRINTF(IQ, "IQ: Set the issue to execute queue.\n");
+    issueToExecuteQueue = i2e_ptr;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::setTimeBuffer(TimeBuffer<TimeStruct> *tb_ptr)
+{
+    DPRINTF(IQ, "IQ: Set the time buffer.\n");
+    timeBuffer = tb_ptr;
+
+    fromCommit = timeBuffer->getWire(-commitToIEWDelay);
+}
+
+template <class Impl>
+unsigned
+BitmapInstQueue<Impl>::numFreeEntries()
+{
+    return freeEntries;
+}
+
+template <class Impl>
+bool
+BitmapInstQueue<Impl>::isFull()
+{
+    return freeEntries == 0;
+}
+
+template <class Impl>
+int
+BitmapInstQueue<Impl>::allocateEntry(DynInstPtr &inst)
+{
+    assert(freeEntries != 0);
+    assert(!freeList.empty());
+
+    int entry = freeList.back();
+    freeList.pop_back();
+    --freeEntries;
+
+    // Instructions enter the IQ in program order, so every valid entry
+    // is older than the new one.  Clear the column of the previous
+    // occupant, which might have been older than some of them.
+    for (int i = valid.findNext(0); i != -1; i = valid.findNext(i + 1)) {
+        ageMatrix[i].clear(entry);
+    }
+    ageMatrix[entry] = valid;
+
+    valid.set(entry);
+    insts[entry] = inst;
+
+    if (inst->isControl()) {
+        instClass[entry] = Branch;
+    } else if (inst->isMemRef()) {
+        instClass[entry] = Memory;
+        memInsts.set(entry);
+    } else if (inst->isInteger()) {
+        instClass[entry] = Int;
+    } else if (inst->isFloating()) {
+        instClass[entry] = Float;
+    } else {
+        instClass[entry] = Misc;
+    }
+
+    return entry;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::freeEntry(int entry)
+{
+    assert(valid.test(entry));
+
+    insts[entry] = NULL;
+    valid.clear(entry);
+    memInsts.clear(entry);
+    nonSpecInsts.clear(entry);
+    for (int i = 0; i < NumReadyClasses; ++i) {
+        ready[i].clear(entry);
+    }
+
+    freeList.push_back(entry);
+    ++freeEntries;
+    assert(freeEntries <= numEntries);
+}
+
+template <class Impl>
+int
+BitmapInstQueue<Impl>::findEntry(DynInstPtr &inst)
+{
+    for (int i = memInsts.findNext(0); i != -1; i = memInsts.findNext(i + 1)) {
+        if (insts[i] == inst) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::insert(DynInstPtr &new_inst)
+{
+    // Make sure the instruction is valid
+    assert(new_inst);
+
+    DPRINTF(IQ, "IQ: Adding instruction PC %#x to the IQ.\n",
+            new_inst->readPC());
+
+    int entry = allocateEntry(new_inst);
+
+    // Look through its source registers (physical regs), and mark any
+    // dependencies.
+    addToDependents(entry);
+
+    // Have this instruction set itself as the producer of its destination
+    // register(s).
+    createDependency(new_inst);
+
+    // If it's a memory instruction, add it to the memory dependency
+    // unit.
+    if (new_inst->isMemRef()) {
+        memDepUnit.insert(new_inst);
+    } else {
+        addIfReady(entry);
+    }
+
+    ++iqInstsAdded;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::insertNonSpec(DynInstPtr &inst)
+{
+    // Make sure the instruction is valid
+    assert(inst);
+
+    DPRINTF(IQ, "IQ: Adding non-speculative instruction PC %#x to the IQ.\n",
+            inst->readPC());
+
+    int entry = allocateEntry(inst);
+    nonSpecInsts.set(entry);
+
+    createDependency(inst);
+
+    if (inst->isMemRef()) {
+        memDepUnit.insertNonSpec(inst);
+    }
+
+    ++iqNonSpecInstsAdded;
+}
+
+// The IQ does not keep an iterator into the CPU's instruction list, so
+// an instruction that bypasses the IQ only needs to claim its
+// destination registers.
+template <class Impl>
+void
+BitmapInstQueue<Impl>::advanceTail(DynInstPtr &inst)
+{
+    // Make sure the instruction is valid
+    assert(inst);
+
+    DPRINTF(IQ, "IQ: Instruction PC %#x bypasses the IQ.\n",
+            inst->readPC());
+
+    createDependency(inst);
+}
+
+template <class Impl>
+int
+BitmapInstQueue<Impl>::selectOldest(const IQBitmap &cands)
+{
+    for (int i = cands.findNext(0); i != -1; i = cands.findNext(i + 1)) {
+        if (!ageMatrix[i].intersects(cands)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::scheduleReadyInsts()
+{
+    DPRINTF(IQ, "IQ: Attempting to schedule ready instructions from "
+                "the IQ.\n");
+
+    int int_issued = 0;
+    int float_issued = 0;
+    int branch_issued = 0;
+    int memory_issued = 0;
+    int total_issued = 0;
+
+    IssueStruct *i2e_info = issueToExecuteQueue->access(0);
+
+    while (total_issued < totalWidth) {
+        // Gather the ready entries of all classes with issue bandwidth
+        // left and find the oldest of them.
+        candidates.clearAll();
+        if (int_issued < intWidth) candidates |= ready[Int];
+        if (float_issued < floatWidth) candidates |= ready[Float];
+        if (branch_issued < branchWidth) candidates |= ready[Branch];
+        candidates |= ready[Misc];
+
+        int oldest = selectOldest(candidates);
+
+        if (oldest != -1 && insts[oldest]->isSquashed()) {
+            // The entry is removed when the IQ squashes
+            ready[instClass[oldest]].clear(oldest);
+            ++iqLoopSquashStalls;
+            continue;
+        }
+
+        // Memory instructions are ordered by the memory dependence unit
+        DynInstPtr mem_head_inst;
+        if (!memDepUnit.empty() && memory_issued < memoryWidth) {
+            mem_head_inst = memDepUnit.top();
+
+            if (mem_head_inst->isSquashed()) {
+                memDepUnit.pop();
+                ++iqLoopSquashStalls;
+                continue;
+            }
+        }
+
+        DynInstPtr issuing_inst = NULL;
+
+        if (mem_head_inst &&
+            (oldest == -1 || mem_head_inst->seqNum < insts[oldest]->seqNum)) {
+            issuing_inst = mem_head_inst;
+            memDepUnit.pop();
+            ++memory_issued;
+
+            int entry = findEntry(issuing_inst);
+            assert(entry != -1);
+            freeEntry(entry);
+
+            DPRINTF(IQ, "IQ: Issuing memory instruction PC %#x.\n",
+                    issuing_inst->readPC());
+        } else if (oldest != -1) {
+            issuing_inst = insts[oldest];
+
+            switch (instClass[oldest]) {
+              case Int:
+                ++int_issued;
+                DPRINTF(IQ, "IQ: Issuing integer instruction PC %#x.\n",
+                        issuing_inst->readPC());
+                break;
+
+              case Float:
+                ++float_issued;
+                DPRINTF(IQ, "IQ: Issuing float instruction PC %#x.\n",
+                        issuing_inst->readPC());
+                break;
+
+              case Branch:
+                ++branch_issued;
+                DPRINTF(IQ, "IQ: Issuing branch instruction PC %#x.\n",
+                        issuing_inst->readPC());
+                break;
+
+              case Misc:
+                ++iqMiscInstsIssued;
+                DPRINTF(IQ, "IQ: Issuing a miscellaneous instruction "
+                        "PC %#x.\n", issuing_inst->readPC());
+                break;
+
+              default:
+                panic("IQ: Memory instruction in a ready list");
+            }
+
+            freeEntry(oldest);
+        } else {
+            DPRINTF(IQ, "IQ: Not able to schedule any more instructions.\n");
+            break;
+        }
+
+        i2e_info->insts[total_issued] = issuing_inst;
+        i2e_info->size++;
+
+        issuing_inst->setIssued();
+
+        ++total_issued;
+    }
+
+    iqIntInstsIssued += int_issued;
+    iqFloatInstsIssued += float_issued;
+    iqBranchInstsIssued += branch_issued;
+    iqMemInstsIssued += memory_issued;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::scheduleNonSpec(const InstSeqNum &inst)
+{
+    DPRINTF(IQ, "IQ: Marking nonspeculative instruction with sequence "
+            "number %i as ready to execute.\n", inst);
+
+    int entry = nonSpecInsts.findNext(0);
+    while (entry != -1 && insts[entry]->seqNum != inst) {
+        entry = nonSpecInsts.findNext(entry + 1);
+    }
+
+    assert(entry != -1);
+
+    nonSpecInsts.clear(entry);
+
+    // Mark this instruction as ready to issue.
+    insts[entry]->setCanIssue();
+
+    // Now schedule the instruction.
+    if (!insts[entry]->isMemRef()) {
+        addIfReady(entry);
+    } else {
+        memDepUnit.nonSpecInstReady(insts[entry]);
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::wakeDependents(DynInstPtr &completed_inst)
+{
+    DPRINTF(IQ, "IQ: Waking dependents of completed instruction.\n");
+
+    // Tell the memory dependence unit to wake any dependents on this
+    // instruction if it is a memory instruction.
+    if (completed_inst->isMemRef()) {
+        memDepUnit.wakeDependents(completed_inst);
+    }
+
+    for (int dest_reg_idx = 0;
+         dest_reg_idx < completed_inst->numDestRegs();
+         dest_reg_idx++)
+    {
+        PhysRegIndex dest_reg =
+            completed_inst->renamedDestRegIdx(dest_reg_idx);
+
+        // Misc registers are not renamed and have no row in the
+        // dependency matrix.
+        if (dest_reg >= numPhysRegs) {
+            continue;
+        }
+
+        DPRINTF(IQ, "IQ: Waking any dependents on register %i.\n",
+                (int) dest_reg);
+
+        IQBitmap &waiting = dependMatrix[dest_reg];
+        for (int i = waiting.findNext(0); i != -1; i = waiting.findNext(i + 1)) {
+            DynInstPtr &inst = insts[i];
+
+            DPRINTF(IQ, "IQ: Waking up a dependent instruction, PC%#x.\n",
+                    inst->readPC());
+
+            // An instruction can read the register through more than one
+            // operand, and each of them was waiting.
+            for (int src_reg_idx = 0;
+                 src_reg_idx < inst->numSrcRegs();
+                 src_reg_idx++)
+            {
+                if (inst->renamedSrcRegIdx(src_reg_idx) == dest_reg &&
+                    !inst->isReadySrcRegIdx(src_reg_idx)) {
+                    inst->markSrcRegReady();
+                }
+            }
+
+            addIfReady(i);
+        }
+        waiting.clearAll();
+
+        // Mark the scoreboard as having that register ready.
+        regScoreboard[dest_reg] = true;
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::violation(DynInstPtr &store,
+                                 DynInstPtr &faulting_load)
+{
+    memDepUnit.violation(store, faulting_load);
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::squash()
+{
+    DPRINTF(IQ, "IQ: Starting to squash instructions in the IQ.\n");
+
+    // Read instruction sequence number of last instruction out of the
+    // time buffer.
+    squashedSeqNum = fromCommit->commitInfo.doneSeqNum;
+
+    if (freeEntries != numEntries) {
+        doSquash();
+    }
+
+    // Also tell the memory dependence unit to squash.
+    memDepUnit.squash(squashedSeqNum);
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::doSquash()
+{
+    // Make sure the squashed sequence number is valid.
+    assert(squashedSeqNum != 0);
+
+    DPRINTF(IQ, "IQ: Squashing instructions in the IQ.\n");
+
+    // Squash all instructions younger than the squashed sequence number.
+    for (int i = valid.findNext(0); i != -1; i = valid.findNext(i + 1)) {
+        DynInstPtr squashed_inst = insts[i];
+
+        ++iqSquashedInstsExamined;
+
+        if (squashed_inst->seqNum <= squashedSeqNum) {
+            continue;
+        }
+
+        if (!squashed_inst->isNonSpeculative()) {
+            removeFromDependents(i);
+        } else {
+            ++iqSquashedNonSpecRemoved;
+        }
+
+        squashed_inst->setSquashedInIQ();
+        squashed_inst->setIssued();
+        squashed_inst->setCanCommit();
+
+        freeEntry(i);
+        ++iqSquashedInstsIssued;
+
+        DPRINTF(IQ, "IQ: Instruction PC %#x squashed.\n",
+                squashed_inst->readPC());
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::stopSquash()
+{
+    // Clear up the squash variables to ensure that squashing doesn't
+    // get called improperly.
+    squashedSeqNum = 0;
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::addToDependents(int entry)
+{
+    DynInstPtr &new_inst = insts[entry];
+
+    // Loop through the instruction's source registers, adding
+    // them to the dependency matrix if they are not ready.
+    for (int src_reg_idx = 0;
+         src_reg_idx < new_inst->numSrcRegs();
+         src_reg_idx++)
+    {
+        if (new_inst->isReadySrcRegIdx(src_reg_idx)) {
+            continue;
+        }
+
+        PhysRegIndex src_reg = new_inst->renamedSrcRegIdx(src_reg_idx);
+
+        // Check the IQ's scoreboard to make sure the register
+        // hasn't become ready while the instruction was in flight
+        // between stages.
+        if (src_reg >= numPhysRegs) {
+            continue;
+        } else if (!regScoreboard[src_reg]) {
+            DPRINTF(IQ, "IQ: Instruction PC %#x has src reg %i that "
+                    "is being added to the dependency chain.\n",
+                    new_inst->readPC(), src_reg);
+
+            dependMatrix[src_reg].set(entry);
+        } else {
+            DPRINTF(IQ, "IQ: Instruction PC %#x has src reg %i that "
+                    "became ready before it reached the IQ.\n",
+                    new_inst->readPC(), src_reg);
+            new_inst->markSrcRegReady();
+        }
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::removeFromDependents(int entry)
+{
+    DynInstPtr &inst = insts[entry];
+
+    for (int src_reg_idx = 0;
+         src_reg_idx < inst->numSrcRegs();
+         src_reg_idx++)
+    {
+        PhysRegIndex src_reg = inst->renamedSrcRegIdx(src_reg_idx);
+
+        if (src_reg < numPhysRegs) {
+            dependMatrix[src_reg].clear(entry);
+        }
+
+        ++iqSquashedOperandsExamined;
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::createDependency(DynInstPtr &new_inst)
+{
+    for (int dest_reg_idx = 0;
+         dest_reg_idx < new_inst->numDestRegs();
+         dest_reg_idx++)
+    {
+        PhysRegIndex dest_reg = new_inst->renamedDestRegIdx(dest_reg_idx);
+
+        // Misc registers are not renamed, and instructions using them
+        // execute at commit.
+        if (dest_reg >= numPhysRegs) {
+            continue;
+        }
+
+        if (dependMatrix[dest_reg].any()) {
+            dumpDependGraph();
+            panic("IQ: Dependency graph not empty!");
+        }
+
+        // Mark the scoreboard to say it's not yet ready.
+        regScoreboard[dest_reg] = false;
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::addIfReady(int entry)
+{
+    DynInstPtr &inst = insts[entry];
+
+    if (!inst->readyToIssue()) {
+        return;
+    }
+
+    if (instClass[entry] == Memory) {
+        DPRINTF(IQ, "IQ: Checking if memory instruction can issue.\n");
+
+        // Message to the mem dependence unit that this instruction has
+        // its registers ready.
+        memDepUnit.regsReady(inst);
+    } else {
+        DPRINTF(IQ, "IQ: Instruction is ready to issue, putting it onto "
+                "the ready list, PC %#x.\n", inst->readPC());
+
+        ready[instClass[entry]].set(entry);
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::dumpDependGraph()
+{
+    for (int i = 0; i < numPhysRegs; ++i) {
+        cprintf("dependMatrix[%i]: consumer: ", i);
+
+        IQBitmap &waiting = dependMatrix[i];
+        for (int j = waiting.findNext(0); j != -1; j = waiting.findNext(j + 1)) {
+            cprintf("%#x ", insts[j]->readPC());
+        }
+
+        cprintf("\n");
+    }
+}
+
+template <class Impl>
+void
+BitmapInstQueue<Impl>::dumpLists()
+{
+    const char *names[NumReadyClasses] = { "integer", "float", "branch",
+                                           "misc" };
+
+    for (int c = 0; c < NumReadyClasses; ++c) {
+        cprintf("Ready %s list: ", names[c]);
+        for (int i = ready[c].findNext(0); i != -1;
+             i = ready[c].findNext(i + 1)) {
+            cprintf("%#x ", insts[i]->readPC());
+        }
+        cprintf("\n");
+    }
+
+    cprintf("Non speculative list: ");
+    for (int i = nonSpecInsts.findNext(0); i != -1;
+         i = nonSpecInsts.findNext(i + 1)) {
+        cprintf("%#x ", insts[i]->readPC());
+    }
+    cprintf("\n");
+}
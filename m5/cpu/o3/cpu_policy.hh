@@ -32,6 +32,7 @@
 #ifndef __CPU_O3_CPU_CPU_POLICY_HH__
 #define __CPU_O3_CPU_CPU_POLICY_HH__
 
+#include "cpu/o3/bitmap_inst_queue.hh"
 #include "cpu/o3/bpred_unit.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/inst_queue.hh"
@@ -50,6 +51,8 @@
 
 #include "cpu/o3/comm.hh"
 
+#include "config/bitmap_iq.hh"
+
 template<class Impl>
 struct SimpleCPUPolicy
 {
@@ -58,7 +61,11 @@ struct SimpleCPUPolicy
     typedef SimpleFreeList FreeList;
     typedef SimpleRenameMap RenameMap;
     typedef ROB<Impl> ROB_TYPE;
+#if BITMAP_IQ
+    typedef BitmapInstQueue<Impl> IQ;
+#else
     typedef InstructionQueue<Impl> IQ;
+#endif
     typedef MemDepUnit<StoreSet, Impl> MemDepUnit_TYPE;
     typedef LDSTQ<Impl> LDSTQ_TYPE;
     
@@ -0,0 +1,100 @@
+/*
+ * iq_bitmap.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef IQ_BITMAP_HH_
+#define IQ_BITMAP_HH_
+
+#include <cassert>
+#include <vector>
+
+#include "sim/host.hh"
+
+/**
+* A fixed size bit vector with one bit per instruction queue entry. It
+* is used for the ready lists, the rows of the age matrix and the rows
+* of the dependency matrix of the BitmapInstQueue.
+*
+* @author Magnus Jahre
+*/
+class IQBitmap
+{
+    private:
+        std::vector<uint64_t> words;
+        int numBits;
+
+        static int lowestBit(uint64_t w){
+            int pos = 0;
+            while((w & 1) == 0){
+                w >>= 1;
+                pos++;
+            }
+            return pos;
+        }
+
+    public:
+        IQBitmap() : numBits(0) {}
+
+        void resize(int bits){
+            numBits = bits;
+            words.assign((bits + 63) / 64, 0);
+        }
+
+        int size() const { return numBits; }
+
+        bool test(int i) const {
+            assert(i >= 0 && i < numBits);
+            return (words[i >> 6] >> (i & 63)) & 1;
+        }
+
+        void set(int i){
+            assert(i >= 0 && i < numBits);
+            words[i >> 6] |= (uint64_t) 1 << (i & 63);
+        }
+
+        void clear(int i){
+            assert(i >= 0 && i < numBits);
+            words[i >> 6] &= ~((uint64_t) 1 << (i & 63));
+        }
+
+        void clearAll(){
+            for(int i=0;i<words.size();i++) words[i] = 0;
+        }
+
+        bool any() const {
+            for(int i=0;i<words.size();i++) if(words[i] != 0) return true;
+            return false;
+        }
+
+        bool intersects(const IQBitmap &other) const {
+            assert(other.words.size() == words.size());
+            for(int i=0;i<words.size();i++){
+                if((words[i] & other.words[i]) != 0) return true;
+            }
+            return false;
+        }
+
+        IQBitmap &operator|=(const IQBitmap &other){
+            assert(other.words.size() == words.size());
+            for(int i=0;i<words.size();i++) words[i] |= other.words[i];
+            return *this;
+        }
+
+        /** @return The lowest set bit at or after from, or -1. */
+        int findNext(int from) const {
+            if(from >= numBits) return -1;
+            int w = from >> 6;
+            uint64_t bits = words[w] & (~(uint64_t) 0 << (from & 63));
+            while(bits == 0){
+                w++;
+                if(w == words.size()) return -1;
+                bits = words[w];
+            }
+            return (w << 6) + lowestBit(bits);
+        }
+};
+
+#endif /* IQ_BITMAP_HH_ */
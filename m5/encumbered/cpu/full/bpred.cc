@@ -61,6 +61,8 @@
 #include "cpu/smt.hh"
 #include "encumbered/cpu/full/bpred.hh"
 #include "encumbered/cpu/full/cpu.hh"
+#include "encumbered/cpu/full/ittage.hh"
+#include "encumbered/cpu/full/tage.hh"
 #include "sim/builder.hh"
 #include "sim/host.hh"
 #include "sim/stats.hh"
@@ -109,7 +111,18 @@ BranchPred::BranchPred(const string &_name,
 		       unsigned int _conf_pred_ctr_bits,
 		       int _conf_pred_ctr_thresh,
 		       bool _conf_pred_xor,
-		       ConfCounterType _conf_pred_ctr_type)
+		       ConfCounterType _conf_pred_ctr_type,
+		       unsigned int tage_budget,
+		       unsigned int tage_tables,
+		       unsigned int tage_tag_bits,
+		       unsigned int tage_min_hist,
+		       unsigned int tage_max_hist,
+		       IndirectPredClass _ind_class,
+		       unsigned int ittage_budget,
+		       unsigned int ittage_tables,
+		       unsigned int ittage_tag_bits,
+		       unsigned int ittage_min_hist,
+		       unsigned int ittage_max_hist)
     : SimObject(_name),
       cpu(NULL),	// initialized later via setCPU()
       bp_class(_bp_class),
@@ -131,7 +144,11 @@ BranchPred::BranchPred(const string &_name,
       conf_pred_ctr_bits(_conf_pred_ctr_bits),
       conf_pred_ctr_thresh(_conf_pred_ctr_thresh),
       conf_pred_xor(_conf_pred_xor),
-      conf_pred_ctr_type(_conf_pred_ctr_type)
+      conf_pred_ctr_type(_conf_pred_ctr_type),
+      ind_class(_ind_class),
+      history(NULL),
+      tage(NULL),
+      ittage(NULL)
 {
     int i;
 
@@ -231,6 +248,23 @@ BranchPred::BranchPred(const string &_name,
 	    meta_pred_table[i] = 1;
     }
 
+    if (bp_class == BPredTageSCL || ind_class == IndirectITTage) {
+	/* the tables register their folded histories with the history,
+	 * so it is set up last */
+	history = new BranchHistory;
+
+	if (bp_class == BPredTageSCL)
+	    tage = new TageSCL(history, tage_budget, tage_tables,
+			       tage_tag_bits, tage_min_hist, tage_max_hist);
+
+	if (ind_class == IndirectITTage)
+	    ittage = new ITTage(history, ittage_budget, ittage_tables,
+				ittage_tag_bits, ittage_min_hist,
+				ittage_max_hist);
+
+	history->init();
+    }
+
     /* allocate BTB */
     if (!btb_sets || !IS_POWER_OF_TWO(btb_sets))
 	fatal("number of BTB sets must be non-zero and a power of two");
@@ -343,6 +377,23 @@ BranchPred::regStats( )
 	.flags(total)
 	;
 
+    used_ittage.init(cpu->number_of_threads);
+    ittage_correct.init(cpu->number_of_threads);
+
+    if (ittage) {
+	used_ittage
+	    .name(name() + ".used_ittage")
+	    .desc("num committed branches using target from ITTAGE")
+	    .flags(total)
+	    ;
+
+	ittage_correct
+	    .name(name() + ".ittage_correct")
+	    .desc("num correct ITTAGE predictions")
+	    .flags(total)
+	    ;
+    }
+
     switch (bp_class) {
     case BPredComb:
 	pred_state_table_size = 64;	/* bit patterns */
@@ -353,6 +404,11 @@ BranchPred::regStats( )
 	pred_state_table_size = 16;
 	break;
 
+    case BPredTageSCL:
+	/* no counter state to classify predictions by */
+	pred_state_table_size = 1;
+	break;
+
     default:
 	fatal("bad bpred class");
     }
@@ -458,6 +514,15 @@ BranchPred::regFormulas()
 	;
     ras_accuracy = ras_correct / used_ras;
 
+    if (ittage) {
+	ittage_accuracy
+	    .name(name() + ".ittage_accuracy")
+	    .desc("fraction of ITTAGE targets correct")
+	    .flags(total)
+	    ;
+	ittage_accuracy = ittage_correct / used_ittage;
+    }
+
     if (conf_pred_enable) {
 	conf_sens
 	    .name(name() + ".conf.sens")
@@ -648,6 +713,12 @@ BranchPred::lookup(int thread,
     /* we'll set these later if necessary */
     brstate->used_btb = 0;
     brstate->used_ras = 0;
+    brstate->used_ittage = 0;
+    brstate->loop_entry = -1;
+
+    /* remember the TAGE/ITTAGE history before this branch for repair */
+    if (history)
+	history->save(thread, brstate);
 
 #if BP_VERBOSE
     ccprintf(cerr, "BR: %#08X (cycle %n) ", baddr, curTick);
@@ -666,6 +737,21 @@ BranchPred::lookup(int thread,
 
 #if BP_VERBOSE
 	ccprintf(cerr, "UNCOND ");
+#endif
+    } else if (tage) {
+	pred_taken = tage->lookup(thread, baddr, brstate);
+
+	brstate->pred_state = 0;
+	brstate->conf_result = CONF_NULL;
+	if (confidence)
+	    *confidence = CONF_NULL;
+
+	/* save RAS TOS index and value for speculation recovery */
+	brstate->ras_tos = retAddrStack[thread].tos;
+	brstate->ras_value = retAddrStack[thread].stack[brstate->ras_tos];
+
+#if BP_VERBOSE
+	ccprintf(cerr, "TAGE   ");
 #endif
     } else {
 	/* branch bits used as index */
@@ -811,6 +897,17 @@ BranchPred::lookup(int thread,
 	}
     }
 
+    /* ITTAGE predicts indirect jumps other than returns; it has to see
+     * the history from before this branch */
+    Addr ittage_target = 0;
+    if (ittage && brInst->isIndirectCtrl() && !brInst->isReturn() &&
+	ittage->lookup(thread, baddr, brstate, &ittage_target))
+	brstate->used_ittage = 1;
+
+    /* speculatively update the TAGE/ITTAGE history */
+    if (history)
+	history->push(thread, pred_taken, baddr);
+
 
     /*
      * If branch is predicted not taken, there's no need to check the
@@ -869,6 +966,14 @@ BranchPred::lookup(int thread,
 #endif
 	}
     }
+    if (brstate->used_ittage) {
+#if BP_VERBOSE
+	ccprintf(cerr, "ITTAGE=%#08X\n", ittage_target);
+#endif
+	*pred_target_ptr = ittage_target;
+	return Predict_Taken_With_Target;
+    }
+
     /* predicted taken, not a return: do BTB lookup */
     index = ((baddr >> BranchPredAddrShiftAmt) & (btb.sets - 1)) * btb.assoc;
 
@@ -906,6 +1011,7 @@ BranchPred::lookup(int thread,
 void
 BranchPred::recover(int thread,
 		    Addr baddr,	/* branch address */
+		    Addr correct_target, /* resolved next PC */
 		    BPredUpdateRec *brstate)
 {				/* pred state pointer */
 #if BP_VERBOSE
@@ -931,6 +1037,29 @@ BranchPred::recover(int thread,
     retAddrStack[thread].tos = brstate->ras_tos;
     retAddrStack[thread].stack[brstate->ras_tos] = brstate->ras_value;
     global_hist_reg[thread] = brstate->global_hist;
+
+    if (history) {
+	bool taken = correct_target != baddr + sizeof(MachInst);
+
+	history->restore(thread, brstate);
+	history->push(thread, taken, baddr);
+
+	if (tage)
+	    tage->recover(baddr, taken, brstate);
+    }
+}
+
+void
+BranchPred::fixup(int thread,
+		  Addr baddr,	/* branch address */
+		  BPredUpdateRec *brstate)
+{				/* pred state pointer */
+    if (!brstate->used_predictor || !history)
+	return;
+
+    /* the branch was predicted taken, and it still is */
+    history->restore(thread, brstate);
+    history->push(thread, true, baddr);
 }
 
 /*
@@ -1014,6 +1143,13 @@ BranchPred::update( int thread,	/* thread ID */
 #endif
 	}
 
+	/*
+	 *  UPDATE TAGE-SC-L PREDICTOR
+	 *
+	 */
+	if (tage)
+	    tage->update(baddr, taken, brstate);
+
 	/*
 	 *  UPDATE LOCAL PREDICTOR
 	 *
@@ -1194,6 +1330,16 @@ BranchPred::update( int thread,	/* thread ID */
 #endif
     }
 
+    if (ittage && brInst->isIndirectCtrl() && !brInst->isReturn()) {
+	if (brstate->used_ittage) {
+	    used_ittage[thread]++;
+	    if (correct)
+		ittage_correct[thread]++;
+	}
+
+	ittage->update(baddr, btarget, correct, brstate);
+    }
+
     if (taken) {
 	if (brstate->used_ras) {
 	    /* used RAS... */
@@ -1331,13 +1477,30 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(BranchPred)
     Param<int> conf_pred_ctr_thresh;
     Param<bool> conf_pred_xor;
     SimpleEnumParam<ConfCounterType> conf_pred_ctr_type;
+    Param<unsigned> tage_budget;
+    Param<unsigned> tage_tables;
+    Param<unsigned> tage_tag_bits;
+    Param<unsigned> tage_min_hist;
+    Param<unsigned> tage_max_hist;
+    SimpleEnumParam<IndirectPredClass> indirect_class;
+    Param<unsigned> ittage_budget;
+    Param<unsigned> ittage_tables;
+    Param<unsigned> ittage_tag_bits;
+    Param<unsigned> ittage_min_hist;
+    Param<unsigned> ittage_max_hist;
 
 END_DECLARE_SIM_OBJECT_PARAMS(BranchPred)
 
 // parameter strings for enum BPredClass
 const char *bpred_class_strings[] =
 {
-    "hybrid", "global", "local"
+    "hybrid", "global", "local", "tage-sc-l"
+};
+
+// parameter strings for enum IndirectPredClass
+const char *indirect_pred_class_strings[] =
+{
+    "btb", "ittage"
 };
 
 // parameter strings for enum ConfCounterType
@@ -1368,7 +1531,19 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(BranchPred)
     INIT_PARAM(conf_pred_ctr_thresh, "confidence predictor threshold"),
     INIT_PARAM(conf_pred_xor, "XOR confidence predictor bits"),
     INIT_ENUM_PARAM(conf_pred_ctr_type, "confidence predictor type",
-		    conf_counter_type_strings)
+		    conf_counter_type_strings),
+    INIT_PARAM_DFLT(tage_budget, "TAGE-SC-L storage budget in KB", 64),
+    INIT_PARAM_DFLT(tage_tables, "number of TAGE tagged tables", 12),
+    INIT_PARAM_DFLT(tage_tag_bits, "TAGE tag bits", 12),
+    INIT_PARAM_DFLT(tage_min_hist, "shortest TAGE history", 4),
+    INIT_PARAM_DFLT(tage_max_hist, "longest TAGE history", 640),
+    INIT_ENUM_PARAM_DFLT(indirect_class, "indirect target predictor",
+			 indirect_pred_class_strings, IndirectBTB),
+    INIT_PARAM_DFLT(ittage_budget, "ITTAGE storage budget in KB", 64),
+    INIT_PARAM_DFLT(ittage_tables, "number of ITTAGE tagged tables", 8),
+    INIT_PARAM_DFLT(ittage_tag_bits, "ITTAGE tag bits", 12),
+    INIT_PARAM_DFLT(ittage_min_hist, "shortest ITTAGE history", 4),
+    INIT_PARAM_DFLT(ittage_max_hist, "longest ITTAGE history", 300)
 
 END_INIT_SIM_OBJECT_PARAMS(BranchPred)
 
@@ -1387,6 +1562,8 @@ CREATE_SIM_OBJECT(BranchPred)
     bool need_global = pred_class == BPredComb || pred_class == BPredGlobal;
     bool need_meta = pred_class == BPredComb;
     bool need_conf = conf_pred_enable;
+    bool need_tage = pred_class == BPredTageSCL;
+    bool need_ittage = indirect_class == IndirectITTage;
 
     return new BranchPred(getInstanceName(),
 			  pred_class,
@@ -1406,7 +1583,18 @@ CREATE_SIM_OBJECT(BranchPred)
 			  need_conf ? conf_pred_ctr_bits : 0,
 			  need_conf ? conf_pred_ctr_thresh : 0,
 			  need_conf ? conf_pred_xor : false,
-			  need_conf ? conf_pred_ctr_type : CNT_RESET);
+			  need_conf ? conf_pred_ctr_type : CNT_RESET,
+			  need_tage ? tage_budget : 0,
+			  need_tage ? tage_tables : 0,
+			  need_tage ? tage_tag_bits : 0,
+			  need_tage ? tage_min_hist : 0,
+			  need_tage ? tage_max_hist : 0,
+			  indirect_class,
+			  need_ittage ? ittage_budget : 0,
+			  need_ittage ? ittage_tables : 0,
+			  need_ittage ? ittage_tag_bits : 0,
+			  need_ittage ? ittage_min_hist : 0,
+			  need_ittage ? ittage_max_hist : 0);
 }
 
 REGISTER_SIM_OBJECT("BranchPred", BranchPred)
@@ -67,15 +67,26 @@
 
 // forward decls
 class FullCPU;
+class BranchHistory;
+class TageSCL;
+class ITTage;
 
 // branch predictor types
 enum BPredClass {
     BPredComb,			// combined predictor (McFarling/21264)
     BPredGlobal,		// 2-level w/global history
     BPredLocal,			// 2-level w/local history
+    BPredTageSCL,		// TAGE-SC-L (see tage.hh)
     BPred_NUM
 };
 
+// indirect target predictor types
+enum IndirectPredClass {
+    IndirectBTB,		// targets from the BTB
+    IndirectITTage,		// ITTAGE, backed by the BTB (see ittage.hh)
+    IndirectPred_NUM
+};
+
 enum ConfCounterType {
     CNT_RESET,			//  Resetting counter
     CNT_SAT			//  Saturating counter
@@ -135,7 +146,18 @@ class BranchPred : public SimObject
 	       unsigned int conf_pred_ctr_bits,
 	       int conf_pred_ctr_thresh, // < 0 means static assignment
 	       bool conf_pred_xor,
-	       ConfCounterType conf_pred_ctr_type);
+	       ConfCounterType conf_pred_ctr_type,
+	       unsigned int tage_budget, // TAGE-SC-L storage in KB
+	       unsigned int tage_tables,
+	       unsigned int tage_tag_bits,
+	       unsigned int tage_min_hist,
+	       unsigned int tage_max_hist,
+	       IndirectPredClass ind_class,
+	       unsigned int ittage_budget, // ITTAGE storage in KB
+	       unsigned int ittage_tables,
+	       unsigned int ittage_tag_bits,
+	       unsigned int ittage_min_hist,
+	       unsigned int ittage_max_hist);
 
     FullCPU *cpu;
 
@@ -176,6 +198,14 @@ class BranchPred : public SimObject
     unsigned int conf_pred_xor;
     unsigned int conf_pred_ctr_type;
 
+    IndirectPredClass ind_class;	// type of indirect predictor
+
+    // speculative history of the TAGE-SC-L and ITTAGE predictors, NULL
+    // if neither is used
+    BranchHistory *history;
+    TageSCL *tage;
+    ITTage *ittage;
+
     // stats
     //Counter lookups[SMT_MAX_THREADS];	// Counts all lookups
     Stats::Vector<> lookups;
@@ -197,6 +227,10 @@ class BranchPred : public SimObject
     Stats::Vector<> used_ras;
     // num correct return-address predictions
     Stats::Vector<> ras_correct;
+    // number of committed instrs using a target from ITTAGE
+    Stats::Vector<> used_ittage;
+    // num correct ITTAGE predictions
+    Stats::Vector<> ittage_correct;
     unsigned pred_state_table_size;
     Stats::Vector<> pred_state[NUM_PRED_STATE_ENTRIES];
 
@@ -205,6 +239,7 @@ class BranchPred : public SimObject
     Stats::Formula btb_hit_rate;
     Stats::Formula btb_accuracy;
     Stats::Formula ras_accuracy;
+    Stats::Formula ittage_accuracy;
     Stats::Formula conf_sens;
     Stats::Formula conf_pvp;
     Stats::Formula conf_spec;
@@ -238,12 +273,24 @@ class BranchPred : public SimObject
     // Speculative execution can corrupt the ret-addr stack.  So for
     // each lookup we return the top-of-stack (TOS) at that point; a
     // mispredicted branch, as part of its recovery, restores the TOS
-    // using this value -- hopefully this uncorrupts the stack.
+    // using this value -- hopefully this uncorrupts the stack.  The
+    // TAGE-SC-L and ITTAGE history is rewound to the branch and
+    // updated with its resolved direction.
     void
     recover(int thread_number,
 	    Addr baddr,	// branch address
+	    Addr correct_target, // resolved next PC
 	    BPredUpdateRec *dir_update_ptr);
 
+    // A direct branch that missed in the BTB was redirected at decode.
+    // The branches fetched behind it on the fall-through path have
+    // updated the TAGE-SC-L and ITTAGE history, so rewind it to the
+    // branch.  The other predictors are left as they are.
+    void
+    fixup(int thread_number,
+	  Addr baddr,	// branch address
+	  BPredUpdateRec *dir_update_ptr);
+
     // update the branch predictor, only useful for stateful predictors;
     // updates entry for instruction type OP at address BADDR.  BTB only
     // gets updated for branches which are taken.  Inst was determined to
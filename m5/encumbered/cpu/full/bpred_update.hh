@@ -92,6 +92,13 @@ enum conf_pred {
     CONF_HIGH
 };
 
+// Most tagged tables a TAGE or ITTAGE predictor can have.
+const int BPredMaxTaggedTables = 16;
+
+// Most folded histories: TAGE and ITTAGE each fold every table's
+// history for the index and two tags.
+const int BPredMaxFolds = 2 * 3 * BPredMaxTaggedTables;
+
 // Per-dynamic-branch predictor information, used for update,
 // recovery, and statistics.
 struct BPredUpdateRec
@@ -111,6 +118,30 @@ struct BPredUpdateRec
     unsigned int pred_state:6;	// meta/local/global bits
     unsigned int used_ras:1;
     unsigned int used_btb:1;
+    unsigned int used_ittage:1;
+
+    // TAGE-SC-L and ITTAGE: the global history before this branch, used
+    // to repair the history, and the entries read by the lookup, used
+    // to update the tables at commit.  A branch is either conditional
+    // or indirect, so TAGE and ITTAGE share the tagged table fields.
+    int hist_ptr;
+    uint64_t hist_recent;
+    unsigned int path_hist;
+    uint16_t folded_hist[BPredMaxFolds];
+    uint16_t tagged_index[BPredMaxTaggedTables];
+    uint16_t tagged_tag[BPredMaxTaggedTables];
+    int provider;		// longest matching table, -1 if none
+    int alt_provider;		// next longest matching table
+    int sc_sum;
+    int loop_entry;		// -1 if the loop predictor missed
+    unsigned int loop_iter;	// speculative iteration before this branch
+    unsigned int provider_pred:1;
+    unsigned int alt_pred:1;
+    unsigned int tage_pred:1;
+    unsigned int provider_weak:1;
+    unsigned int sc_pred:1;
+    unsigned int loop_valid:1;
+    unsigned int loop_pred:1;
 };
 
 #endif // __ENCUMBERED_CPU_FULL_BPRED_UPDATE_HH
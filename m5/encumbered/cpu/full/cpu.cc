@@ -566,6 +566,15 @@ FullCPU::FullCPU(Params *p,
     issue_starting_fu_pool = 0;
     issue_current_fupool_for_sb = 0;
 
+    //  Bitmap issue selection checks FU availability against the pool
+    //  the IQ issues to, so that pool must be fixed
+    for (int i = 0; i < numIQueues; ++i) {
+	if (IQ[i]->bitmap_select() &&
+	    (numIQueues != numFUPools || prioritize_issue || inorder_issue))
+	    fatal("Bitmap issue selection needs one FU pool per IQ and "
+		  "no prioritized or in-order issue");
+    }
+
     issue_bandwidth.resize(SMT_MAX_THREADS);
     issue_bandwidth = _issue_bandwidth;
 
@@ -596,6 +605,14 @@ FullCPU::FullCPU(Params *p,
     //  The ROB is a MachineQueue<ROBStation>
     ROB.init(this, ROB_size, numIQueues);
 
+    //  Instructions live in the ROB, the IFQ or the decode pipe. Size
+    //  the pool so that the whole window fits in the initial chunk.
+    instPool = new DynInstPool(name() + ".instPool",
+			       ROB_size + ifq_size
+			       + decode_dispatch_latency * decode_width
+			       + number_of_threads * fetch_width,
+			       sizeof(DynInst));
+
     rob_cap.resize(SMT_MAX_THREADS);
     rob_cap = _rob_caps;
 
@@ -757,6 +774,8 @@ FullCPU::~FullCPU()
     for (int i = 0; i < number_of_threads; ++i)
 	delete thread[i];
 
+    delete instPool;
+
     //
     //  Second, delete the SimObjects that we received as a pointer
     //
@@ -847,6 +866,7 @@ FullCPU::regStats()
     fetchRegStats();
     storebuffer->regStats();
     decodeQueue->regStats();
+    instPool->regStats();
     dispatchRegStats();
     issueRegStats();
     writebackRegStats();
@@ -41,6 +41,7 @@
 #include "cpu/base.hh"
 #include "cpu/smt.hh"
 #include "encumbered/cpu/full/bpred.hh"
+#include "encumbered/cpu/full/dyn_inst_pool.hh"
 #include "encumbered/cpu/full/fetch.hh"
 #include "encumbered/cpu/full/floss_reasons.hh"
 #include "encumbered/cpu/full/fu_pool.hh"
@@ -436,8 +437,13 @@ public:
 	BaseIQ **IQ;
 	BaseIQ *LSQ;
 	class MachineQueue<ROBStation> ROB;
+
 	StoreBuffer *storebuffer;
 
+	// Storage for this CPU's in-flight DynInsts
+	DynInstPool *instPool;
+
+
 	unsigned numIQueues;  //  ?????
 	unsigned IQNumSlots;  //  ?????
 
@@ -1542,6 +1542,10 @@ FullCPU::fixup_btb_miss(DynInst *inst)
 	inst->recover_inst = false;
 	inst->xc->spec_mode--;
 
+	//  Undo the history updates of the squashed fall-through path
+	if (branch_pred)
+	    branch_pred->fixup(thread_number, inst->PC, &inst->dir_update);
+
 	//  Correct the PC for the BTB miss
 	inst->xc->regs.pc = inst->branchTarget();
 
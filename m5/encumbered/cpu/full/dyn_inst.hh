@@ -41,6 +41,7 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/static_inst.hh"
 #include "encumbered/cpu/full/bpred_update.hh"
+#include "encumbered/cpu/full/dyn_inst_pool.hh"
 #include "encumbered/cpu/full/op_class.hh"
 #include "encumbered/cpu/full/spec_memory.hh"
 #include "encumbered/cpu/full/spec_state.hh"
@@ -129,6 +130,18 @@ class DynInst : public FastAlloc
     DynInst(StaticInstPtr<TheISA> &_staticInst);
     ~DynInst();
 
+    // FullCPU allocates its instructions from a per-CPU DynInstPool
+    // (see fetch.cc). Plain new still works and goes to the heap.
+    // Either way, delete returns the object to where it came from.
+    static void *operator new(size_t sz)
+    { return DynInstPool::allocateUnpooled(sz); }
+    static void *operator new(size_t sz, DynInstPool &pool)
+    { return pool.allocate(sz); }
+    static void operator delete(void *p, size_t sz)
+    { DynInstPool::deallocate(p); }
+    static void operator delete(void *p, DynInstPool &pool)
+    { DynInstPool::deallocate(p); }
+
     bool spec_mem_write;	// Did this instruction do a spec write?
 
     void squash();
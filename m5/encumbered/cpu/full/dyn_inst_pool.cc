@@ -0,0 +1,79 @@
+/*
+ * dyn_inst_pool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <cstdlib>
+
+#include "base/misc.hh"
+#include "base/trace.hh"
+#include "encumbered/cpu/full/dyn_inst_pool.hh"
+
+using namespace std;
+
+DynInstPool::DynInstPool(const string &name, unsigned initial_slots,
+                         size_t obj_size)
+    : _name(name), objSize(obj_size), freeHead(0), freeCount(0),
+      totalSlots(0), maxInUse(0)
+{
+    slotSize = (HeaderSize + objSize + LineSize - 1) & ~(size_t)(LineSize - 1);
+
+    if (initial_slots == 0)
+        initial_slots = 1;
+    grow(initial_slots);
+}
+
+DynInstPool::~DynInstPool()
+{
+    for (int i = 0; i < chunks.size(); i++)
+        free(chunks[i]);
+}
+
+void
+DynInstPool::regStats()
+{
+    using namespace Stats;
+
+    peak_in_use
+	.scalar(maxInUse)
+	.name(_name + ":peak_in_use")
+	.desc("largest number of instructions allocated at once")
+	;
+
+    slots
+	.scalar(totalSlots)
+	.name(_name + ":slots")
+	.desc("number of instruction slots in the pool")
+	;
+}
+
+void
+DynInstPool::grow(unsigned slots)
+{
+    char *chunk = NULL;
+    if (posix_memalign((void **)&chunk, LineSize, slots * slotSize) != 0)
+        fatal("%s: could not allocate %d instruction slots", _name, slots);
+    chunks.push_back(chunk);
+
+    // Linearize the ring so the slots that are already free keep their
+    // recycling order ahead of the new ones
+    vector<char *> ring(totalSlots + slots, NULL);
+    for (unsigned i = 0; i < freeCount; i++)
+        ring[i] = freeRing[(freeHead + i) % freeRing.size()];
+
+    for (unsigned i = 0; i < slots; i++) {
+        char *slot = chunk + i * slotSize;
+        ((SlotHeader *)slot)->pool = this;
+        ring[freeCount + i] = slot;
+    }
+
+    freeRing.swap(ring);
+    freeHead = 0;
+    freeCount += slots;
+    totalSlots += slots;
+
+    DPRINTF(Fetch, "%s: grew instruction pool by %d slots to %d slots\n",
+            _name, slots, totalSlots);
+}
@@ -0,0 +1,139 @@
+/*
+ * dyn_inst_pool.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef __ENCUMBERED_CPU_FULL_DYN_INST_POOL_HH__
+#define __ENCUMBERED_CPU_FULL_DYN_INST_POOL_HH__
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+
+/**
+ * Per-CPU slab allocator for DynInst objects.
+ *
+ * All slots live in a few large, cache-line aligned chunks sized after
+ * the instruction window (ROB, IFQ and decode pipe), so the in-flight
+ * instructions of one CPU occupy a compact region of host memory.
+ * Free slots are kept in a FIFO ring. Instructions are allocated in
+ * fetch order and mostly freed in commit order, so slots are recycled
+ * in program order and the same window-sized region is reused over
+ * and over. Squashed instructions return their slots to the ring
+ * immediately.
+ *
+ * Each slot starts with a small header that points back to the owning
+ * pool. This lets DynInst::operator delete find the pool, so existing
+ * "delete inst" call sites do not need to know where an instruction
+ * was allocated. If more instructions are in flight than the initial
+ * estimate allows for, the pool grows by another chunk instead of
+ * failing.
+ */
+class DynInstPool
+{
+  private:
+    struct SlotHeader
+    {
+        DynInstPool *pool;
+    };
+
+    /** Offset of the object from the start of its slot. */
+    static const int HeaderSize = 16;
+    static const int LineSize = 64;
+
+    std::string _name;
+
+    size_t objSize;
+    size_t slotSize;
+
+    std::vector<char *> chunks;
+
+    /** Ring of free slots, oldest freed first. */
+    std::vector<char *> freeRing;
+    unsigned freeHead;
+    unsigned freeCount;
+
+    unsigned totalSlots;
+    unsigned maxInUse;
+
+    Stats::Value peak_in_use;
+    Stats::Value slots;
+
+    void grow(unsigned slots);
+
+  public:
+    DynInstPool(const std::string &name, unsigned initial_slots,
+                size_t obj_size);
+    ~DynInstPool();
+
+    const std::string &name() const { return _name; }
+
+    void *allocate(size_t sz);
+
+    /** Return p to the pool it came from (or to the heap). */
+    static void deallocate(void *p);
+
+    /** Allocate an object that does not belong to any pool. */
+    static void *allocateUnpooled(size_t sz);
+
+    unsigned capacity() const { return totalSlots; }
+    unsigned inUse() const { return totalSlots - freeCount; }
+    unsigned peakInUse() const { return maxInUse; }
+
+    void regStats();
+
+  private:
+    void release(char *slot);
+};
+
+inline void *
+DynInstPool::allocate(size_t sz)
+{
+    assert(sz <= objSize);
+
+    if (freeCount == 0)
+        grow(totalSlots);
+
+    char *slot = freeRing[freeHead];
+    freeHead = (freeHead + 1) % freeRing.size();
+    --freeCount;
+
+    if (inUse() > maxInUse)
+        maxInUse = inUse();
+
+    return slot + HeaderSize;
+}
+
+inline void
+DynInstPool::release(char *slot)
+{
+    assert(freeCount < freeRing.size());
+    freeRing[(freeHead + freeCount) % freeRing.size()] = slot;
+    ++freeCount;
+}
+
+inline void
+DynInstPool::deallocate(void *p)
+{
+    char *slot = (char *)p - HeaderSize;
+    DynInstPool *pool = ((SlotHeader *)slot)->pool;
+
+    if (pool)
+        pool->release(slot);
+    else
+        ::operator delete(slot);
+}
+
+inline void *
+DynInstPool::allocateUnpooled(size_t sz)
+{
+    char *slot = (char *)::operator new(sz + HeaderSize);
+    ((SlotHeader *)slot)->pool = NULL;
+    return slot + HeaderSize;
+}
+
+#endif // __ENCUMBERED_CPU_FULL_DYN_INST_POOL_HH__
@@ -819,9 +819,10 @@ FullCPU::fetchOneInst(int thread_number)
     }
 
     //
-    // Allocate a DynInst object and populate it
+    // Allocate a DynInst object from this CPU's instruction pool and
+    // populate it
     //
-    DynInst *inst = new DynInst(si);
+    DynInst *inst = new (*instPool) DynInst(si);
 
     inst->fetch_seq = next_fetch_seq++;
 
@@ -1909,7 +1910,7 @@ FullCPU::fetchRegStats()
 	.init(number_of_threads)
 	.name(name() + ".FETCH:count")
 	.desc("Number of instructions fetched")
-	.flags(total)
+	.flags(total | nofilter)
 	;
     fetched_branch
 	.init(number_of_threads)
@@ -127,8 +127,10 @@ FuncUnitPool::FuncUnitPool(string name, vector<FUDesc *> paramList)
 
     freeList.clear();
 
-    for (int i = 0; i < Num_OpClasses; ++i)
+    for (int i = 0; i < Num_OpClasses; ++i) {
 	maxOpLatencies[i] = 0;
+	freeUnits[i] = 0;
+    }
 
     //
     //  Iterate through the list of FUDescData structures
@@ -173,6 +175,7 @@ FuncUnitPool::FuncUnitPool(string name, vector<FUDesc *> paramList)
 	    s << (*i)->name() << "(0)";
 	    fu->name = s.str();
 	    freeList.push_back(fu);
+	    markFree(fu, true);
 
 	    for (int c = 1; c < (*i)->number; ++c) {
 		ostringstream s;
@@ -182,6 +185,7 @@ FuncUnitPool::FuncUnitPool(string name, vector<FUDesc *> paramList)
 		s << (*i)->name() << "(" << c << ")";
 		fu2->name = s.str();
 		freeList.push_back(fu2);
+		markFree(fu2, true);
 	    }
 	}
     }
@@ -234,6 +238,10 @@ FuncUnitPool::getUnit(OpClass capability)
     if (!capabilityList[capability])
 	return -2;
 
+    //  All units with this capability are busy
+    if (freeUnits[capability] == 0)
+	return -1;
+
     //  Search for the capability from the FU's in the free list
     freeListIterator i = freeList.begin();
     freeListIterator end = freeList.end();
@@ -250,6 +258,7 @@ FuncUnitPool::getUnit(OpClass capability)
 	    //
 	    busyList[issuelat - 1].push_back(*i);
 
+	    markFree(*i, false);
 	    freeList.erase(i);  // !!invalidates iterator
 
 	    //  return the number of cycles before the result is available
@@ -268,13 +277,30 @@ FuncUnitPool::tick()
     if (!busyList[0].empty()) {
 	list<FuncUnit *>::iterator i = busyList[0].begin();
 	list<FuncUnit *>::iterator end = busyList[0].end();
-	for (; i != end; ++i)
+	for (; i != end; ++i) {
 	    freeList.push_front(*i);
+	    markFree(*i, true);
+	}
     }
 
     busyList.advance();  // clears out the list at offset zero
 }
 
+void
+FuncUnitPool::markFree(FuncUnit *fu, bool free)
+{
+    for (int c = 0; c < Num_OpClasses; ++c) {
+	if (fu->provides((OpClass)c)) {
+	    if (free) {
+		++freeUnits[c];
+	    } else {
+		assert(freeUnits[c] > 0);
+		--freeUnits[c];
+	    }
+	}
+    }
+}
+
 void
 FuncUnitPool::dump()
 {
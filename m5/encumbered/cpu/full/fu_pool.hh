@@ -124,6 +124,12 @@ class FuncUnitPool : public SimObject
 
     std::bitset<Num_OpClasses> capabilityList;
 
+    //  Number of free units that provide each op class. Lets getUnit()
+    //  reject a request without walking the free list.
+    unsigned freeUnits[Num_OpClasses];
+
+    void markFree(FuncUnit *fu, bool free);
+
   public:
     int numFU;
     // TODO: possibly convert to array of lists indexed by capability
@@ -137,6 +143,11 @@ class FuncUnitPool : public SimObject
     void annotateMemoryUnits(unsigned hit_latency);
     int getUnit(OpClass capability);
 
+    //  True if getUnit() would fail with -1 for this op class
+    bool busy(OpClass capability) {
+	return capabilityList[capability] && freeUnits[capability] == 0;
+    }
+
     void tick();
     void dump();
 
@@ -81,6 +81,7 @@ struct IQStation
     IQStation() {
 	in_LSQ = ea_comp = false;
 	queued = squashed = false;
+	class_prev = class_next = 0;
 	//  blocked = false;
 
 	lsq_entry = iq_entry = 0;
@@ -118,6 +119,8 @@ struct IQStation
 
     /* instruction status */
     bool queued;		/* operands ready and queued */
+    iterator class_prev;	/* per-op-class ready list links, only */
+    iterator class_next;	/*   used by the bitmap issue selection */
     bool squashed;		/* operation has been squashed */
     //    bool blocked;
 
@@ -280,7 +280,7 @@ BaseIQ::regStats(unsigned threads)
 	.init(threads)
 	.name(prefix + "peak_occupancy")
 	.desc("Peak IQ occupancy")
-	.flags(total)
+	.flags(total | nofilter)
 	;
 
     current_count
@@ -51,6 +51,7 @@
 struct ROBStation;
 struct IQStation;
 class FullCPU;
+class FuncUnitPool;
 struct NewChainInfo;
 struct GenericPredictor;
 class ChainInfoTableBase;
@@ -218,6 +219,16 @@ class BaseIQ : public SimObject
     //  and will remain valid until the next time this call is made
     virtual rq_iterator issuable_list() = 0;
 
+    //  Instruction selection for the issue stage. The default walks the
+    //  issuable list in order. An IQ may instead skip the instructions
+    //  that cannot issue to the given FU pool this cycle.
+    virtual bool bitmap_select() { return false; }
+    virtual rq_iterator select_issuable(FuncUnitPool *pool) {
+	return issuable_list();
+    }
+    //  The next instruction to try after i failed to issue
+    virtual rq_iterator select_next(rq_iterator &i) { return i.next(); }
+
     //
     //  Handle the removal of the specified instruction from both
     //  the instruction queue and the ready queue
@@ -302,6 +302,9 @@ class RQ_Seg_Policy {
 			    res_list<IQStation>::iterator &first,
 			    res_list<IQStation>::iterator &second,
 			    bool use_thread_priorities);
+
+    // entries are sorted by destination segment first
+    static bool age_ordered(bool use_thread_priorities) { return false; }
 };
 
 //
@@ -314,6 +317,10 @@ class RQ_Issue_Policy {
 			    res_list<IQStation>::iterator &first,
 			    res_list<IQStation>::iterator &second,
 			    bool use_thread_priorities);
+
+    static bool age_ordered(bool use_thread_priorities) {
+	return !use_thread_priorities;
+    }
 };
 
 #endif // __ENCUMBERED_CPU_FULL_IQ_SEGMENTED_IQ_SEG_HH__
@@ -1552,7 +1552,7 @@ SegmentedIQ::regModelStats(unsigned num_threads)
 	.init(num_threads)
 	.name(n+"chains_peak")
 	.desc("maximum number of chains in use")
-	.flags(total)
+	.flags(total | nofilter)
 	;
 
     deadlock_events
@@ -473,6 +473,10 @@ class RQSeznecPolicy
 
 	return rv;
     }
+
+    static bool age_ordered(bool use_thread_priorities) {
+	return !use_thread_priorities;
+    }
 };
 
 
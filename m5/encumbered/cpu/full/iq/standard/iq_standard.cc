@@ -51,7 +51,8 @@ using namespace std;
 //==========================================================================
 
 StandardIQ::StandardIQ(string _name, unsigned _size, int pri,
-		       bool _caps_valid, vector<unsigned> _caps)
+		       bool _caps_valid, vector<unsigned> _caps,
+		       bool _bitmap_select)
     : BaseIQ(_name, _caps_valid, _caps)
 {
     string n2(_name);
@@ -71,6 +72,19 @@ StandardIQ::StandardIQ(string _name, unsigned _size, int pri,
     n2 = n2 + ":RQ";
     ready_list = new ready_queue_t<IQStation, iq_standard_readyq_policy>
 	(&cpu, n2.c_str(), _size, pri_issue);
+
+    //  the per-class lists are ordered by age only
+    use_bitmap_select = _bitmap_select;
+    if (use_bitmap_select && pri_issue)
+	fatal("%s: bitmap issue selection does not support prioritized "
+	      "issue", _name);
+
+    for (int c = 0; c < Num_OpClasses; ++c) {
+	class_head[c] = 0;
+	class_tail[c] = 0;
+	class_cursor[c] = 0;
+    }
+    select_pool = NULL;
 }
 
 StandardIQ::~StandardIQ()
@@ -246,6 +260,9 @@ StandardIQ::squash(BaseIQ::iterator &e)
 					e->seq);
 
 			ready_list->remove(e->rq_entry);
+
+			if (use_bitmap_select)
+				class_remove(e);
 		}
 	}
 
@@ -253,6 +270,141 @@ StandardIQ::squash(BaseIQ::iterator &e)
 };
 
 
+//
+//  Bitmap issue selection
+//
+void
+StandardIQ::class_enqueue(iterator &q)
+{
+    OpClass c = select_class(q);
+
+    //  newly ready instructions are usually the youngest of their class
+    iterator p = class_tail[c];
+    while (p.notnull() && q->seq < p->seq)
+	p = p->class_prev;
+
+    q->class_prev = p;
+    if (p.notnull()) {
+	q->class_next = p->class_next;
+	p->class_next = q;
+    } else {
+	q->class_next = class_head[c];
+	class_head[c] = q;
+    }
+
+    if (q->class_next.notnull())
+	q->class_next->class_prev = q;
+    else
+	class_tail[c] = q;
+
+    ready_classes.set(c);
+}
+
+void
+StandardIQ::class_remove(iterator &q)
+{
+    OpClass c = select_class(q);
+
+    if (class_cursor[c] == q) {
+	class_cursor[c] = q->class_next;
+	if (class_cursor[c].isnull())
+	    cursor_classes.reset(c);
+    }
+
+    if (q->class_prev.notnull())
+	q->class_prev->class_next = q->class_next;
+    else
+	class_head[c] = q->class_next;
+
+    if (q->class_next.notnull())
+	q->class_next->class_prev = q->class_prev;
+    else
+	class_tail[c] = q->class_prev;
+
+    q->class_prev = q->class_next = 0;
+
+    if (class_head[c].isnull())
+	ready_classes.reset(c);
+}
+
+BaseIQ::rq_iterator
+StandardIQ::select_issuable(FuncUnitPool *pool)
+{
+    if (!use_bitmap_select)
+	return issuable_list();
+
+    select_pool = pool;
+    cursor_classes = ready_classes;
+    for (int c = 0; c < Num_OpClasses; ++c)
+	class_cursor[c] = class_head[c];
+
+    return select();
+}
+
+BaseIQ::rq_iterator
+StandardIQ::select_next(rq_iterator &i)
+{
+    if (!use_bitmap_select)
+	return i.next();
+
+    //  the failed instruction is the cursor of its class
+    iterator q = *i;
+    OpClass c = select_class(q);
+    assert(class_cursor[c] == q);
+
+    class_cursor[c] = q->class_next;
+    if (class_cursor[c].isnull())
+	cursor_classes.reset(c);
+
+    return select();
+}
+
+//
+//  Pick the oldest untried instruction among the classes that can
+//  issue. A class is dropped for the rest of the cycle when its FU is
+//  busy or when its oldest untried instruction is too young, since the
+//  younger ones in the class were dispatched even later. Instructions
+//  skipped this way are not counted in the FU busy and unissued stats.
+//
+BaseIQ::rq_iterator
+StandardIQ::select()
+{
+    assert(select_pool);
+
+    iterator best = 0;
+    for (int c = 0; c < Num_OpClasses; ++c) {
+	if (!cursor_classes[c])
+	    continue;
+
+	iterator q = class_cursor[c];
+	assert(q.notnull());
+
+	if (select_pool->busy((OpClass)c)) {
+	    if (cpu->floss_state.issue_end_cause[0] == ISSUE_CAUSE_NOT_SET) {
+		cpu->floss_state.issue_end_cause[0] = ISSUE_FU;
+		cpu->floss_state.issue_fu[0][0] = (OpClass)c;
+	    }
+	    cursor_classes.reset(c);
+	    continue;
+	}
+
+	if (curTick < q->dispatch_timestamp + cpu->dispatch_to_issue_latency) {
+	    if (cpu->floss_state.issue_end_cause[0] == ISSUE_CAUSE_NOT_SET)
+		cpu->floss_state.issue_end_cause[0] = ISSUE_AGE;
+	    cursor_classes.reset(c);
+	    continue;
+	}
+
+	if (best.isnull() || q->seq < best->seq)
+	    best = q;
+    }
+
+    if (best.isnull())
+	return 0;
+    return best->rq_entry;
+}
+
+
 //
 //  Every-cycle IQ stats
 //
@@ -322,6 +474,7 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(StandardIQ)
     Param<int> size;
     Param<bool> prioritized_issue;
     VectorParam<unsigned> caps;
+    Param<bool> bitmap_select;
 
 END_DECLARE_SIM_OBJECT_PARAMS(StandardIQ)
 
@@ -331,7 +484,9 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(StandardIQ)
     INIT_PARAM(size, "number of entries"),
     INIT_PARAM_DFLT(prioritized_issue, "use thread priorities in issue",
 		    false),
-    INIT_PARAM(caps, "IQ caps")
+    INIT_PARAM(caps, "IQ caps"),
+    INIT_PARAM_DFLT(bitmap_select, "select ready instructions through "
+		    "per-op-class bitmaps", false)
 
 END_INIT_SIM_OBJECT_PARAMS(StandardIQ)
 
@@ -340,7 +495,7 @@ CREATE_SIM_OBJECT(StandardIQ)
 {
     return new StandardIQ(getInstanceName(),
 			  size, prioritized_issue,
-			  caps.isValid(), caps);
+			  caps.isValid(), caps, bitmap_select);
 }
 
 REGISTER_SIM_OBJECT("StandardIQ", StandardIQ)
@@ -37,11 +37,13 @@
 #ifndef __ENCUMBERED_CPU_FULL_IQ_STANDARD_HH__
 #define __ENCUMBERED_CPU_FULL_IQ_STANDARD_HH__
 
+#include <bitset>
 #include <string>
 #include <vector>
 
 #include "encumbered/cpu/full/iq/iq_station.hh"
 #include "encumbered/cpu/full/iq/iqueue.hh"
+#include "encumbered/cpu/full/op_class.hh"
 #include "encumbered/cpu/full/readyq.hh"
 #include "encumbered/cpu/full/thread.hh"
 
@@ -86,6 +88,11 @@ class iq_standard_readyq_policy
 
 	return rv;
     }
+
+    // true if goes_before() only compares sequence numbers
+    static bool age_ordered(bool use_thread_priorities) {
+	return !use_thread_priorities;
+    }
 };
 
 //
@@ -149,11 +156,43 @@ class StandardIQ : public BaseIQ
     typedef BaseIQ::rq_iterator rq_iterator;
     typedef BaseIQ::iterator    iterator;
 
+    //
+    //  Bitmap issue selection
+    //
+    //  The ready instructions are also kept in one age-ordered list per
+    //  op class. Selection only looks at the oldest untried instruction
+    //  of each class whose bit is set in the ready-class bitmap and
+    //  that has a free FU, so instructions waiting for a busy FU are
+    //  never visited.
+    //
+    bool use_bitmap_select;
+
+    iterator class_head[Num_OpClasses];
+    iterator class_tail[Num_OpClasses];
+    std::bitset<Num_OpClasses> ready_classes;
+
+    //  Next instruction to try in each class this cycle
+    iterator class_cursor[Num_OpClasses];
+    std::bitset<Num_OpClasses> cursor_classes;
+
+    FuncUnitPool *select_pool;
+
+    static OpClass select_class(iterator &q) {
+	//  faulting no-ops issue to an integer ALU, see iq_issue()
+	OpClass c = q->opClass();
+	return c == No_OpClass ? IntAluOp : c;
+    }
+
+    void class_enqueue(iterator &q);
+    void class_remove(iterator &q);
+    rq_iterator select();
+
 
   public:
     //  Constructor
     StandardIQ(std::string _name, unsigned _size, int pri,
-	       bool _caps_valid, std::vector<unsigned> _caps);
+	       bool _caps_valid, std::vector<unsigned> _caps,
+	       bool _bitmap_select);
 
     ~StandardIQ();
 
@@ -179,10 +218,17 @@ class StandardIQ : public BaseIQ
 
 	    //  Remove IQ element (& associated RQ entry)
 	    squash(*p);
+
+	    if (use_bitmap_select)
+		next = select();
 	}
 	return next;
     }
 
+    virtual bool bitmap_select() { return use_bitmap_select; }
+    virtual rq_iterator select_issuable(FuncUnitPool *pool);
+    virtual rq_iterator select_next(rq_iterator &i);
+
     virtual unsigned ready_count() {return ready_list->count(); }
 
     virtual void regModelStats(unsigned num_threads);
@@ -225,6 +271,9 @@ class StandardIQ : public BaseIQ
     virtual void ready_list_enqueue(iterator &q) {
 	q->rq_entry = ready_list->enqueue(q);
 	q->queued = true;
+
+	if (use_bitmap_select)
+	    class_enqueue(q);
     }
 };
 
@@ -1302,8 +1302,9 @@ FullCPU::issue()
 				}
 			}
 
-			//  save this for non-prioritized issue
-			iq_rq_iterator[q] = IQ[q]->issuable_list();
+			//  save this for non-prioritized issue (bitmap selection
+			//  requires one FU pool per IQ)
+			iq_rq_iterator[q] = IQ[q]->select_issuable(FUPools[q % numFUPools]);
 		}
 
 		hp_done[q] = false;
@@ -1616,7 +1617,8 @@ FullCPU::issue()
 				--n_ready;
 			} else {
 				//  this instruction didn't issue, so point to the next one
-				iq_rq_iterator[current_iq] = iq_rq_iterator[current_iq].next();
+				iq_rq_iterator[current_iq]
+							   = IQ[current_iq]->select_next(iq_rq_iterator[current_iq]);
 			}
 			break;
 
@@ -2008,7 +2010,7 @@ FullCPU::issueRegStats()
 	.init(number_of_threads)
 	.name(name() + ".COM:count")
 	.desc("Number of instructions committed")
-	.flags(total)
+	.flags(total | nofilter)
 	;
 
 	stat_com_swp
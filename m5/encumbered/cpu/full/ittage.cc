@@ -0,0 +1,174 @@
+/*
+ * ittage.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <cmath>
+#include <cstdlib>
+
+#include "base/misc.hh"
+#include "encumbered/cpu/full/ittage.hh"
+
+using namespace std;
+
+ITTage::ITTage(BranchHistory *_history, int budget_kb, int num_tables,
+               int tag_bits, int min_hist, int max_hist)
+    : history(_history), numTables(num_tables), tagBits(tag_bits)
+{
+    if (numTables < 1 || numTables > BPredMaxTaggedTables)
+        fatal("ITTAGE needs between 1 and %d tagged tables",
+              BPredMaxTaggedTables);
+    if (tagBits < 2 || tagBits > 16)
+        fatal("ITTAGE tags must be between 2 and 16 bits");
+    if (min_hist < 1 || max_hist < min_hist)
+        fatal("ITTAGE history lengths must satisfy 1 <= min <= max");
+
+    // the full target is stored, besides the tag and the confidence and
+    // useful counters
+    long budget = (long)budget_kb * 8 * 1024;
+    int entry_bits = sizeof(Addr) * 8 + tagBits + 2 + 1;
+    for (indexBits = 16; indexBits >= 4; --indexBits) {
+        if (((long)numTables * entry_bits << indexBits) <= budget)
+            break;
+    }
+    if (indexBits < 4)
+        fatal("ITTAGE budget of %dKB is too small for %d tables",
+              budget_kb, numTables);
+
+    for (int i = 0; i < numTables; ++i) {
+        int length = min_hist;
+        if (numTables > 1)
+            length = (int)(min_hist * pow((double)max_hist / min_hist,
+                                          (double)i / (numTables - 1)) + 0.5);
+        if (i > 0 && length <= histLength[i - 1])
+            length = histLength[i - 1] + 1;
+        histLength.push_back(length);
+
+        indexFold.push_back(history->addFold(length, indexBits));
+        tagFold0.push_back(history->addFold(length, tagBits));
+        tagFold1.push_back(history->addFold(length, tagBits - 1));
+    }
+
+    Entry empty;
+    empty.target = 0;
+    empty.tag = 0;
+    empty.conf = 0;
+    empty.u = 0;
+    tables.assign(numTables, vector<Entry>(1 << indexBits, empty));
+
+    updates = 0;
+    seed = 0;
+}
+
+bool
+ITTage::lookup(int thread, Addr pc, BPredUpdateRec *rec, Addr *target)
+{
+    unsigned pcb = pc >> BranchPredAddrShiftAmt;
+    unsigned path = history->path(thread);
+
+    rec->provider = -1;
+    rec->alt_provider = -1;
+    for (int i = 0; i < numTables; ++i) {
+        int path_len = histLength[i] < BranchHistory::PathBits ?
+            histLength[i] : BranchHistory::PathBits;
+        unsigned path_bits = path & ((1 << path_len) - 1);
+
+        unsigned index = pcb ^ (pcb >> (abs(indexBits - i) + 1));
+        index ^= history->fold(thread, indexFold[i]);
+        index ^= path_bits ^ (path_bits >> indexBits);
+        rec->tagged_index[i] = index & ((1 << indexBits) - 1);
+
+        unsigned tag = pcb ^ history->fold(thread, tagFold0[i]) ^
+            (history->fold(thread, tagFold1[i]) << 1);
+        rec->tagged_tag[i] = tag & ((1 << tagBits) - 1);
+    }
+
+    for (int i = numTables - 1; i >= 0; --i) {
+        if (tables[i][rec->tagged_index[i]].tag == rec->tagged_tag[i]) {
+            if (rec->provider < 0) {
+                rec->provider = i;
+            } else {
+                rec->alt_provider = i;
+                break;
+            }
+        }
+    }
+
+    if (rec->provider < 0)
+        return false;
+
+    const Entry &e = tables[rec->provider][rec->tagged_index[rec->provider]];
+    rec->provider_weak = e.conf == 0;
+    if (rec->provider_weak && rec->alt_provider >= 0) {
+        int alt = rec->alt_provider;
+        *target = tables[alt][rec->tagged_index[alt]].target;
+    } else {
+        *target = e.target;
+    }
+
+    return true;
+}
+
+void
+ITTage::update(Addr pc, Addr target, bool correct, BPredUpdateRec *rec)
+{
+    if (rec->provider >= 0) {
+        int p = rec->provider;
+        Entry &e = tables[p][rec->tagged_index[p]];
+
+        // skip the update if the entry was replaced since the lookup
+        if (e.tag == rec->tagged_tag[p]) {
+            int alt = rec->alt_provider;
+            bool alt_correct = alt >= 0 &&
+                tables[alt][rec->tagged_index[alt]].tag ==
+                rec->tagged_tag[alt] &&
+                tables[alt][rec->tagged_index[alt]].target == target;
+
+            if (e.target == target) {
+                if (!alt_correct)
+                    e.u = 1;
+                if (e.conf < 3)
+                    e.conf++;
+            } else if (e.conf > 0) {
+                e.conf--;
+            } else {
+                e.target = target;
+                if (alt_correct)
+                    e.u = 0;
+            }
+        }
+    }
+
+    if (!correct && rec->provider < numTables - 1)
+        allocate(target, rec);
+
+    // age the useful bits so that entries can be replaced eventually
+    if ((++updates & ((1 << UResetLog) - 1)) == 0) {
+        for (int i = 0; i < numTables; ++i)
+            for (int j = 0; j < tables[i].size(); ++j)
+                tables[i][j].u = 0;
+    }
+}
+
+void
+ITTage::allocate(Addr target, BPredUpdateRec *rec)
+{
+    int start = rec->provider + 1;
+    if (start < numTables - 1 && random())
+        start++;
+
+    for (int i = start; i < numTables; ++i) {
+        Entry &e = tables[i][rec->tagged_index[i]];
+        if (e.u == 0) {
+            e.target = target;
+            e.tag = rec->tagged_tag[i];
+            e.conf = 0;
+            return;
+        }
+    }
+
+    for (int i = start; i < numTables; ++i)
+        tables[i][rec->tagged_index[i]].u = 0;
+}
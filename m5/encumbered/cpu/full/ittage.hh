@@ -0,0 +1,83 @@
+/*
+ * ittage.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef __ENCUMBERED_CPU_FULL_ITTAGE_HH__
+#define __ENCUMBERED_CPU_FULL_ITTAGE_HH__
+
+#include <vector>
+
+#include "encumbered/cpu/full/bpred_update.hh"
+#include "encumbered/cpu/full/tage.hh"
+#include "sim/host.hh"
+
+/**
+ * ITTAGE indirect branch target predictor (Seznec, CBP 2011).
+ *
+ * Tagged tables with geometrically increasing global history lengths
+ * hold branch targets with a confidence counter. The longest matching
+ * table provides the target, or the next longest one if the provider
+ * has no confidence yet. Branches that miss in all tables use the BTB,
+ * which takes the place of the tagless base table.
+ *
+ * The tables share the speculative history of the TAGE-SC-L predictor.
+ * The table size is the largest that fits the storage budget.
+ *
+ * @author Magnus Jahre
+ */
+class ITTage
+{
+  private:
+    static const int UResetLog = 18;
+
+    struct Entry
+    {
+        Addr target;
+        uint16_t tag;
+        uint8_t conf;
+        uint8_t u;
+    };
+
+    BranchHistory *history;
+
+    int numTables;
+    int indexBits;
+    int tagBits;
+    std::vector<int> histLength;
+    std::vector<int> indexFold;
+    std::vector<int> tagFold0;
+    std::vector<int> tagFold1;
+    std::vector<std::vector<Entry> > tables;
+
+    unsigned updates;
+    unsigned seed;
+
+    bool random()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 1;
+    }
+
+    void allocate(Addr target, BPredUpdateRec *rec);
+
+  public:
+    ITTage(BranchHistory *history, int budget_kb, int num_tables,
+           int tag_bits, int min_hist, int max_hist);
+
+    /**
+     * Looks up the target of the indirect branch at pc. Returns false
+     * if no table has an entry for it.
+     */
+    bool lookup(int thread, Addr pc, BPredUpdateRec *rec, Addr *target);
+
+    /**
+     * Trains the predictor with the target of a committed branch.
+     * correct tells if the target used at fetch was right.
+     */
+    void update(Addr pc, Addr target, bool correct, BPredUpdateRec *rec);
+};
+
+#endif // __ENCUMBERED_CPU_FULL_ITTAGE_HH__
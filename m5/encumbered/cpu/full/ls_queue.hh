@@ -50,6 +50,8 @@ class lsq_readyq_policy
 			    bool use_thread_priorities) {
 	return (first->seq < second->seq);
     }
+
+    static bool age_ordered(bool use_thread_priorities) { return true; }
 };
 
 
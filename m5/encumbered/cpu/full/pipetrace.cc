@@ -46,10 +46,22 @@ const char * const PipeTrace::stageNames[] = {"IF", "DA", "EX", "WB", "CT"};
 
 PipeTrace::PipeTrace(const std::string &name, const std::string &filename,
 		     std::string &_range, bool exit_mode, bool statsValid,
-		     std::vector<std::string> _stats)
+		     std::vector<std::string> _stats, bool binary)
     : SimObject(name), range(_range), exit_when_done(exit_mode)
 {
-    outfile = simout.find(filename);
+    if (binary) {
+	outfile = NULL;
+	binaryTrace = new CompactTraceWriter(simout.resolve(filename),
+					     "pipe", 1);
+    } else {
+	outfile = simout.find(filename);
+	binaryTrace = NULL;
+    }
+    lastCycle = 0;
+    lastSeq = 0;
+    lastCPSeq = 0;
+    lastPC = 0;
+    lastAddr = 0;
     active = false;
     useStats = statsValid;
 
@@ -91,6 +103,7 @@ PipeTrace::regStats()
 //
 PipeTrace::~PipeTrace()
 {
+    delete binaryTrace;
 }
 
 
@@ -106,7 +119,12 @@ PipeTrace::newCycle(Tick cycle)
     if (cycle == range) {
 	active = true;
 
-	*outfile << "@ " << dec << cycle << "\n";
+	if (binaryTrace) {
+	    binaryTrace->putByte(CycleRecord);
+	    binaryTrace->putDelta(cycle, lastCycle);
+	} else {
+	    *outfile << "@ " << dec << cycle << "\n";
+	}
 
 #if 0
 	/**
@@ -128,6 +146,8 @@ PipeTrace::newCycle(Tick cycle)
 	if (cycle > range) {
 	    delete outfile;
 	    outfile = NULL;
+	    delete binaryTrace;
+	    binaryTrace = NULL;
 
 	    if (exit_when_done)
 		exit_status = true;
@@ -138,12 +158,48 @@ PipeTrace::newCycle(Tick cycle)
 }
 
 
+//
+//  The thread and correct path sequence number that end each line
+//
+void
+PipeTrace::putInstTag(DynInst *inst)
+{
+    binaryTrace->putVarint(inst->thread_number);
+    binaryTrace->putDelta(inst->correctPathSeq, lastCPSeq);
+}
+
+
 void
 PipeTrace::newInst(DynInst *inst)
 {
     if (!active)
 	return;
 
+    if (binaryTrace) {
+	Addr pc = inst->PC;
+	m5::hash_map<Addr, MachInst>::iterator it = binaryStatics.find(pc);
+	if (it == binaryStatics.end() ||
+	    it->second != inst->staticInst->machInst) {
+	    binaryStatics[pc] = inst->staticInst->machInst;
+	    binaryTrace->putByte(StaticRecord);
+	    binaryTrace->putVarint(pc);
+	    binaryTrace->putString(inst->staticInst->disassemble(pc));
+	}
+
+	binaryTrace->putByte(NewInstRecord);
+	binaryTrace->putDelta(inst->fetch_seq, lastSeq);
+	binaryTrace->putDelta(pc, lastPC);
+	binaryTrace->putVarint(inst->spec_mode);
+	if (inst->eff_addr == MemReq::inval_addr) {
+	    binaryTrace->putByte(0);
+	} else {
+	    binaryTrace->putByte(1);
+	    binaryTrace->putDelta(inst->eff_addr, lastAddr);
+	}
+	putInstTag(inst);
+	return;
+    }
+
     string s;
 
     *outfile << "+ " << dec << inst->fetch_seq
@@ -175,6 +231,17 @@ PipeTrace::moveInst(DynInst *inst, stageID new_stage, unsigned events,
     //  make sure we have a sensible value for miss latency...
     unsigned lat = events ? miss_latency : 0;
 
+    if (binaryTrace) {
+	binaryTrace->putByte(MoveInstRecord);
+	binaryTrace->putDelta(inst->fetch_seq, lastSeq);
+	binaryTrace->putByte(new_stage);
+	binaryTrace->putVarint(events);
+	binaryTrace->putVarint(lat);
+	binaryTrace->putVarint(longest_event);
+	putInstTag(inst);
+	return;
+    }
+
     *outfile << "* " << dec << inst->fetch_seq << " " << stageNames[new_stage];
 
     //	outfile->setf(ios::hex);
@@ -195,6 +262,13 @@ PipeTrace::deleteInst(DynInst *inst)
     if (!active)
 	return;
 
+    if (binaryTrace) {
+	binaryTrace->putByte(DeleteInstRecord);
+	binaryTrace->putDelta(inst->fetch_seq, lastSeq);
+	putInstTag(inst);
+	return;
+    }
+
     *outfile << "- " << dec << inst->fetch_seq
 	     << "  [T"
 	     << dec << inst->thread_number << ", CP#"
@@ -214,6 +288,7 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(PipeTrace)
     Param<string> range;
     Param<bool> exit_when_done;
     VectorParam<string> statistics;
+    Param<string> format;
 
 END_DECLARE_SIM_OBJECT_PARAMS(PipeTrace)
 
@@ -224,7 +299,8 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(PipeTrace)
     INIT_PARAM(range, "range of cycles to trace"),
     INIT_PARAM(exit_when_done,
 	       "terminate simulation when done collecting ptrace data"),
-    INIT_PARAM(statistics, "stats to include in pipe-trace")
+    INIT_PARAM(statistics, "stats to include in pipe-trace"),
+    INIT_PARAM_DFLT(format, "trace output format (text or binary)", "text")
 
 END_INIT_SIM_OBJECT_PARAMS(PipeTrace)
 
@@ -233,9 +309,13 @@ CREATE_SIM_OBJECT(PipeTrace)
 {
     vector<string> stats = statistics;
 
+    if ((string)format != "text" && (string)format != "binary")
+	fatal("Unknown pipe trace format %s", (string)format);
+
     PipeTrace *rv = new PipeTrace(getInstanceName(), file,
 				  range, exit_when_done,
-				  stats.size() > 0, stats);
+				  stats.size() > 0, stats,
+				  (string)format == "binary");
 
     return rv;
 }
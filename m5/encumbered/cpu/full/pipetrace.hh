@@ -36,6 +36,8 @@
 #include <string>
 #include <vector>
 
+#include "base/compact_trace.hh"
+#include "base/hashmap.hh"
 #include "base/str.hh"
 #include "base/range.hh"
 #include "cpu/inst_seq.hh"
@@ -66,6 +68,21 @@ class PipeTrace : public SimObject
     std::ostream *outfile;
     Range<Tick> range;
 
+    /**
+     * The binary trace, NULL when the trace is written as text. The
+     * disassembly of each static instruction is written once, and
+     * ticks, sequence numbers and addresses are written as deltas.
+     */
+    CompactTraceWriter *binaryTrace;
+    m5::hash_map<Addr, MachInst> binaryStatics;
+    uint64_t lastCycle;
+    uint64_t lastSeq;
+    uint64_t lastCPSeq;
+    uint64_t lastPC;
+    uint64_t lastAddr;
+
+    void putInstTag(DynInst *inst);
+
     bool active;
 
     bool exit_when_done;
@@ -75,9 +92,18 @@ class PipeTrace : public SimObject
     std::vector<std::string> stat_names;
 
   public:
+    enum BinaryRecord {
+	CycleRecord = 1,
+	StaticRecord,
+	NewInstRecord,
+	MoveInstRecord,
+	DeleteInstRecord
+    };
+
     PipeTrace(const std::string &name, const std::string &filename,
 	      std::string &_range, bool exit_mode,
-	      bool statsValid, std::vector<std::string> _stats);
+	      bool statsValid, std::vector<std::string> _stats,
+	      bool binary);
     ~PipeTrace();
 
     //  This actually finishes initializing the stat tables for lookup
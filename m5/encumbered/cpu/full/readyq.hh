@@ -244,7 +244,23 @@ class ready_queue_t : public ready_queue_base_t<T>
     {
 	iterator p;
 
-	if (this->queue->head().notnull()) {
+	if (P::age_ordered(prioritize) && this->queue->tail().notnull()) {
+	    //  If the policy orders purely by age, newly ready
+	    //  instructions are usually among the youngest. Search from
+	    //  the tail so that insertion does not have to walk the
+	    //  whole ready queue.
+	    for (iterator i = this->queue->tail(); i.notnull(); i = i.prev()) {
+		if (P::goes_before(*cpu_ptr_ptr, *i, q, prioritize)) {
+		    p = this->queue->insert_after(i);
+		    break;
+		}
+	    }
+
+	    if (p.isnull()) {
+		//  Older than everything in the queue
+		p = this->queue->insert_after(0);
+	    }
+	} else if (this->queue->head().notnull()) {
 	    //  Find the correct place for this entry and return an iterator
 	    //  to it...
 	    for (iterator i = this->queue->head(); i.notnull(); i = i.next()) {
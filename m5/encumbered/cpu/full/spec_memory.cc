@@ -42,12 +42,126 @@
 using namespace std;
 
 SpeculativeMemory::SpeculativeMemory(const string &n, FunctionalMemory *c)
-    : FunctionalMemory(n), child(c)
+    : FunctionalMemory(n), slots(1024), slotMask(1023), slotsUsed(0),
+      epoch(1), versions(1024), versionsUsed(0), freeVersions(-1), child(c)
 {}
 
 SpeculativeMemory::~SpeculativeMemory()
 {}
 
+int
+SpeculativeMemory::insertSlot(Addr addr)
+{
+    unsigned slot = homeSlot(addr);
+    while (validSlot(slot)) {
+	if (slots[slot].addr == addr)
+	    return slot;
+	slot = (slot + 1) & slotMask;
+    }
+
+    // keep the table at most half full so the probe sequences stay short
+    if (2 * (slotsUsed + 1) > slots.size()) {
+	growSlots();
+	return insertSlot(addr);
+    }
+
+    slots[slot].addr = addr;
+    slots[slot].epoch = epoch;
+    slots[slot].newest = -1;
+    slots[slot].oldest = -1;
+    slotsUsed++;
+
+    return slot;
+}
+
+void
+SpeculativeMemory::removeSlot(unsigned slot)
+{
+    // Move the following blocks of the probe sequence back into the
+    // hole, so lookups never have to skip deleted slots. A block can
+    // move unless its home slot lies between the hole and the block.
+    unsigned hole = slot;
+    unsigned next = (hole + 1) & slotMask;
+    while (validSlot(next)) {
+	unsigned home = homeSlot(slots[next].addr);
+	if (((next - home) & slotMask) >= ((next - hole) & slotMask)) {
+	    slots[hole] = slots[next];
+	    hole = next;
+	}
+	next = (next + 1) & slotMask;
+    }
+
+    slots[hole].epoch = 0;
+    slotsUsed--;
+}
+
+void
+SpeculativeMemory::growSlots()
+{
+    vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    slotMask = slots.size() - 1;
+
+    for (int i = 0; i < old.size(); ++i) {
+	if (old[i].epoch != epoch)
+	    continue;
+
+	unsigned slot = homeSlot(old[i].addr);
+	while (validSlot(slot))
+	    slot = (slot + 1) & slotMask;
+	slots[slot] = old[i];
+    }
+}
+
+int
+SpeculativeMemory::allocVersion()
+{
+    if (freeVersions >= 0) {
+	int version = freeVersions;
+	freeVersions = versions[version].older;
+	return version;
+    }
+
+    if (versionsUsed == versions.size())
+	versions.resize(versions.size() * 2);
+
+    return versionsUsed++;
+}
+
+void
+SpeculativeMemory::popOldest(unsigned slot)
+{
+    int version = slots[slot].oldest;
+    assert(version >= 0);
+
+    int newer = versions[version].newer;
+    if (newer >= 0) {
+	versions[newer].older = -1;
+	slots[slot].oldest = newer;
+    } else {
+	removeSlot(slot);
+    }
+
+    versions[version].older = freeVersions;
+    freeVersions = version;
+}
+
+void
+SpeculativeMemory::clear()
+{
+    // Slots from earlier epochs are free, so the table only has to be
+    // touched when the epoch counter wraps.
+    if (++epoch == 0) {
+	for (int i = 0; i < slots.size(); ++i)
+	    slots[i].epoch = 0;
+	epoch = 1;
+    }
+
+    slotsUsed = 0;
+    versionsUsed = 0;
+    freeVersions = -1;
+}
+
 bool
 SpeculativeMemory::read_block(Addr addr, Block &data)
 {
@@ -56,14 +170,14 @@ SpeculativeMemory::read_block(Addr addr, Block &data)
 
     mem_block_test(addr);
 
-    hash_citer_t iter = table.find(addr);
-    if (iter == table.end()){
+    int slot = findSlot(addr);
+    if (slot < 0){
     	DPRINTF(FuncMem, "Block address 0x%x not found in the speculative memory\n", addr);
     	return false;
     }
 
     DPRINTF(FuncMem, "Block address 0x%x is in the speculative memory\n", addr);
-    data = iter->second.front();
+    data = versions[slots[slot].newest].data;
 
     return true;
 }
@@ -76,7 +190,20 @@ SpeculativeMemory::write_block(Addr addr, Block data)
 
     mem_block_test(addr);
 
-    table[addr].push_front(data);
+    int slot = insertSlot(addr);
+    int version = allocVersion();
+    int newest = slots[slot].newest;
+
+    versions[version].data = data;
+    versions[version].newer = -1;
+    versions[version].older = newest;
+
+    if (newest >= 0)
+	versions[newest].newer = version;
+    else
+	slots[slot].oldest = version;
+    slots[slot].newest = version;
+
     return true;
 }
 
@@ -88,15 +215,13 @@ SpeculativeMemory::erase_block(Addr addr)
 
     mem_block_test(addr);
 
-    hash_iter_t iter = table.find(addr);
-    if (iter == table.end()) {
+    int slot = findSlot(addr);
+    if (slot < 0) {
 	panic("Trying to erase a block that isn't there!");
 	return false;
     }
 
-    iter->second.pop_back();
-    if (iter->second.empty())
-	table.erase(iter);
+    popOldest(slot);
 
     return true;
 }
@@ -109,12 +234,12 @@ SpeculativeMemory::writeback_block(MemReqPtr &req)
 
     mem_block_test(req->vaddr);
 
-    hash_iter_t iter = table.find(req->vaddr);
-    if (iter == table.end()) {
+    int slot = findSlot(req->vaddr);
+    if (slot < 0) {
 	panic("Trying to writeback a block that isn't there!");
 	return Machine_Check_Fault;
     }
-    Block data = iter->second.back();
+    Block data = versions[slots[slot].oldest].data;
 
     Fault fault = child->write(req, data);
     if (fault != No_Fault)
@@ -122,9 +247,7 @@ SpeculativeMemory::writeback_block(MemReqPtr &req)
 	      "need some sort of coherence between threads.  (Or something\n"
 	      "likethat)");
 
-    iter->second.pop_back();
-    if (iter->second.empty())
-	table.erase(iter);
+    popOldest(slot);
 
     return No_Fault;
 }
@@ -166,19 +289,18 @@ SpeculativeMemory::write(MemReqPtr &req, const uint8_t *data)
 void
 SpeculativeMemory::writeback()
 {
-    while (!table.empty()) {
-	hash_iter_t iter = table.begin();
+    for (int i = 0; i < slots.size(); ++i) {
+	if (!validSlot(i))
+	    continue;
 
-	Addr addr = iter->first;
-	Block data = iter->second.front();
+	Addr addr = slots[i].addr;
+	Block data = versions[slots[i].newest].data;
 	mem_block_test(addr);
 
 	// We're setting the thread to zero here.  The thread is only currently
 	// used on a store conditional though.
 	MemReqPtr req = new MemReq(addr, 0, sizeof(Block));
 	child->write(req, data);
-
-	table.erase(iter);
     }
 
     clear();
@@ -193,12 +315,11 @@ SpeculativeMemory::prot_read(Addr addr, uint8_t *p, int size)
     int offset = addr & (sizeof(uint64_t) - 1);
     if (offset) {
 	int len = min((int)(sizeof(uint64_t) - offset), size);
-	hash_citer_t iter =
-	    table.find(addr & ~((uint64_t)sizeof(uint64_t) - 1));
-	if (iter == table.end())
+	int slot = findSlot(addr & ~((uint64_t)sizeof(uint64_t) - 1));
+	if (slot < 0)
 	    child->prot_read(addr, p, len);
 	else {
-	    uint64_t data = iter->second.front();
+	    uint64_t data = versions[slots[slot].newest].data;
 	    memcpy(p, ((char *)&data) + offset, len);
 	}
 	addr += len;
@@ -213,11 +334,11 @@ SpeculativeMemory::prot_read(Addr addr, uint8_t *p, int size)
 	fatal("Invalid address!");
 
     while (size > sizeof(uint64_t)) {
-	hash_citer_t iter = table.find(addr);
-	if (iter == table.end())
+	int slot = findSlot(addr);
+	if (slot < 0)
 	    child->prot_read(addr, p, sizeof(uint64_t));
 	else {
-	    uint64_t data = iter->second.front();
+	    uint64_t data = versions[slots[slot].newest].data;
 	    memcpy(p, &data, sizeof(uint64_t));
 	}
 	addr += sizeof(uint64_t);
@@ -225,11 +346,11 @@ SpeculativeMemory::prot_read(Addr addr, uint8_t *p, int size)
 	size -= sizeof(uint64_t);
     }
 
-    hash_citer_t iter = table.find(addr);
-    if (iter == table.end())
+    int slot = findSlot(addr);
+    if (slot < 0)
 	child->prot_read(addr, p, size);
     else {
-	uint64_t data = iter->second.front();
+	uint64_t data = versions[slots[slot].newest].data;
 	memcpy(p, &data, size);
     }
 #endif
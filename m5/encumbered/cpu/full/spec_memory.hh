@@ -33,29 +33,49 @@
 #define __ENCUMBERED_CPU_FULL_SPEC_MEMORY_HH__
 
 #include <cassert>
-#include <deque>
+#include <vector>
 
-#include "base/hashmap.hh"
 #include "mem/functional/functional.hh"
 
-struct HashAddr {
-    size_t operator()(Addr addr) const {
-	return (addr >> 24) ^ (addr >> 16) ^ (addr >> 8) ^
-	    (addr & (sizeof(Addr)-1));
-    }
-};
-
 class SpeculativeMemory : public FunctionalMemory
 {
   public:
     typedef uint64_t Block;
 
   protected:
-    typedef std::deque<Block> data_queue;
-    typedef m5::hash_map<Addr, data_queue, HashAddr> htable_t;
-    typedef htable_t::iterator hash_iter_t;
-    typedef htable_t::const_iterator hash_citer_t;
-    htable_t table;
+    /**
+     * One version of a block. The versions of a block form a doubly
+     * linked list from the newest to the oldest through indices into
+     * the version pool.
+     */
+    struct Version
+    {
+	Block data;
+	int newer;
+	int older;
+    };
+
+    /**
+     * A block in the open addressed table. A slot is only in use if its
+     * epoch is the current epoch, so clear() empties the whole table by
+     * starting a new epoch.
+     */
+    struct Slot
+    {
+	Addr addr;
+	unsigned epoch;
+	int newest;
+	int oldest;
+    };
+
+    std::vector<Slot> slots;
+    unsigned slotMask;
+    int slotsUsed;
+    unsigned epoch;
+
+    std::vector<Version> versions;
+    int versionsUsed;
+    int freeVersions;
 
     FunctionalMemory *child;
 
@@ -64,6 +84,35 @@ class SpeculativeMemory : public FunctionalMemory
 	return addr & ~((Addr)(sizeof(Block) - 1));
     }
 
+    unsigned homeSlot(Addr addr) const
+    {
+	return (unsigned)(((addr >> 3) * 0x9e3779b97f4a7c15ULL) >> 32) &
+	    slotMask;
+    }
+
+    bool validSlot(unsigned slot) const
+    {
+	return slots[slot].epoch == epoch;
+    }
+
+    int findSlot(Addr addr) const
+    {
+	unsigned slot = homeSlot(addr);
+	while (validSlot(slot)) {
+	    if (slots[slot].addr == addr)
+		return slot;
+	    slot = (slot + 1) & slotMask;
+	}
+	return -1;
+    }
+
+    int insertSlot(Addr addr);
+    void removeSlot(unsigned slot);
+    void growSlots();
+
+    int allocVersion();
+    void popOldest(unsigned slot);
+
     bool read_block(Addr addr, Block &data);
     bool write_block(Addr addr, Block data);
     bool erase_block(Addr addr);
@@ -108,25 +157,14 @@ SpeculativeMemory::erase(Addr addr)
     addr = block_addr(addr);
     mem_block_test(addr);
 
-    hash_iter_t iter = table.find(addr);
-    if (iter == table.end())
+    int slot = findSlot(addr);
+    if (slot < 0)
 	return false;
 
-    assert(!(iter->second.empty()));
-    iter->second.pop_back();
-    if (iter->second.empty()) {
-	table.erase(iter);
-    }
-
+    popOldest(slot);
     return true;
 }
 
-inline void
-SpeculativeMemory::clear()
-{
-    table.clear();
-}
-
 //
 // Ideally these would be template functions, but you can't make
 // template functions virtual.
@@ -0,0 +1,538 @@
+/*
+ * tage.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+#include "base/misc.hh"
+#include "encumbered/cpu/full/tage.hh"
+
+using namespace std;
+
+BranchHistory::BranchHistory()
+{
+    mask = 0;
+    maxLength = 0;
+    for (int i = 0; i < SMT_MAX_THREADS; ++i)
+        threads[i].bits = NULL;
+}
+
+BranchHistory::~BranchHistory()
+{
+    for (int i = 0; i < SMT_MAX_THREADS; ++i)
+        delete [] threads[i].bits;
+}
+
+int
+BranchHistory::addFold(int length, int width)
+{
+    assert(threads[0].bits == NULL);
+    assert(width > 0 && width <= 16);
+    assert(folds.size() < BPredMaxFolds);
+
+    Fold f;
+    f.length = length;
+    f.width = width;
+    f.outPoint = length % width;
+    folds.push_back(f);
+
+    if (length > maxLength)
+        maxLength = length;
+
+    return folds.size() - 1;
+}
+
+void
+BranchHistory::init()
+{
+    int size = 1;
+    while (size < maxLength + Slack)
+        size <<= 1;
+    mask = size - 1;
+
+    for (int i = 0; i < SMT_MAX_THREADS; ++i) {
+        ThreadHistory &t = threads[i];
+        t.bits = new uint8_t[size];
+        for (int j = 0; j < size; ++j)
+            t.bits[j] = 0;
+        t.ptr = 0;
+        t.recent = 0;
+        t.path = 0;
+        t.folded.assign(folds.size(), 0);
+    }
+}
+
+void
+BranchHistory::save(int thread, BPredUpdateRec *rec) const
+{
+    const ThreadHistory &t = threads[thread];
+    rec->hist_ptr = t.ptr;
+    rec->hist_recent = t.recent;
+    rec->path_hist = t.path;
+    for (int i = 0; i < folds.size(); ++i)
+        rec->folded_hist[i] = t.folded[i];
+}
+
+void
+BranchHistory::push(int thread, bool taken, Addr pc)
+{
+    ThreadHistory &t = threads[thread];
+
+    t.ptr = (t.ptr - 1) & mask;
+    t.bits[t.ptr] = taken;
+    t.recent = (t.recent << 1) | taken;
+    t.path = ((t.path << 1) | ((pc >> BranchPredAddrShiftAmt) & 1)) &
+        ((1 << PathBits) - 1);
+
+    // shift in the new bit and fold the bit that fell out of the
+    // history back out
+    for (int i = 0; i < folds.size(); ++i) {
+        const Fold &f = folds[i];
+        unsigned c = (t.folded[i] << 1) | taken;
+        c ^= (unsigned)bit(t, f.length) << f.outPoint;
+        c ^= c >> f.width;
+        t.folded[i] = c & ((1 << f.width) - 1);
+    }
+}
+
+void
+BranchHistory::restore(int thread, const BPredUpdateRec *rec)
+{
+    ThreadHistory &t = threads[thread];
+
+    t.ptr = rec->hist_ptr;
+    t.recent = rec->hist_recent;
+    t.path = rec->path_hist;
+    for (int i = 0; i < folds.size(); ++i)
+        t.folded[i] = rec->folded_hist[i];
+}
+
+TageSCL::TageSCL(BranchHistory *_history, int budget_kb, int num_tables,
+                 int tag_bits, int min_hist, int max_hist)
+    : history(_history), numTables(num_tables), tagBits(tag_bits)
+{
+    if (numTables < 1 || numTables > BPredMaxTaggedTables)
+        fatal("TAGE-SC-L needs between 1 and %d tagged tables",
+              BPredMaxTaggedTables);
+    if (tagBits < 2 || tagBits > 16)
+        fatal("TAGE-SC-L tags must be between 2 and 16 bits");
+    if (min_hist < 1 || max_hist < min_hist)
+        fatal("TAGE-SC-L history lengths must satisfy 1 <= min <= max");
+
+    // Fit the tagged tables into what is left of the budget. The base
+    // predictor has twice as many entries as a tagged table and each
+    // corrector table half as many.
+    long budget = (long)budget_kb * 8 * 1024;
+    int entry_bits = 3 + tagBits + 2;
+    for (indexBits = 16; indexBits >= 4; --indexBits) {
+        long bits = (long)numTables * entry_bits << indexBits;
+        bits += 2L << (indexBits + 1);
+        bits += (long)ScTables * ScCounterBits << (indexBits - 1);
+        bits += (long)LoopEntryBits << LoopBits;
+        if (bits <= budget)
+            break;
+    }
+    if (indexBits < 4)
+        fatal("TAGE-SC-L budget of %dKB is too small for %d tables",
+              budget_kb, numTables);
+
+    // geometric history lengths
+    for (int i = 0; i < numTables; ++i) {
+        int length = min_hist;
+        if (numTables > 1)
+            length = (int)(min_hist * pow((double)max_hist / min_hist,
+                                          (double)i / (numTables - 1)) + 0.5);
+        if (i > 0 && length <= histLength[i - 1])
+            length = histLength[i - 1] + 1;
+        histLength.push_back(length);
+
+        indexFold.push_back(history->addFold(length, indexBits));
+        tagFold0.push_back(history->addFold(length, tagBits));
+        tagFold1.push_back(history->addFold(length, tagBits - 1));
+    }
+
+    TaggedEntry empty;
+    empty.ctr = 0;
+    empty.tag = 0;
+    empty.u = 0;
+    tables.assign(numTables, vector<TaggedEntry>(1 << indexBits, empty));
+
+    // initialize to weakly taken
+    baseBits = indexBits + 1;
+    base.assign(1 << baseBits, 2);
+
+    useAltOnNa = 0;
+    updates = 0;
+    seed = 0;
+
+    LoopEntry free_loop;
+    free_loop.tag = 0;
+    free_loop.pastIter = 0;
+    free_loop.commitIter = 0;
+    free_loop.specIter = 0;
+    free_loop.conf = 0;
+    free_loop.age = 0;
+    free_loop.dir = false;
+    loops.assign(1 << LoopBits, free_loop);
+    loopUse = 0;
+
+    scBits = indexBits - 1;
+    for (int i = 0; i < ScTables; ++i)
+        sc[i].assign(1 << scBits, 0);
+    scThreshold = 35;
+    scThresholdCtr = 0;
+}
+
+unsigned
+TageSCL::taggedIndex(int thread, unsigned pcb, int table) const
+{
+    int path_len = histLength[table] < BranchHistory::PathBits ?
+        histLength[table] : BranchHistory::PathBits;
+    unsigned path = history->path(thread) & ((1 << path_len) - 1);
+
+    unsigned index = pcb ^ (pcb >> (abs(indexBits - table) + 1));
+    index ^= history->fold(thread, indexFold[table]);
+    index ^= path ^ (path >> indexBits);
+
+    return index & ((1 << indexBits) - 1);
+}
+
+unsigned
+TageSCL::taggedTag(int thread, unsigned pcb, int table) const
+{
+    unsigned tag = pcb ^ history->fold(thread, tagFold0[table]) ^
+        (history->fold(thread, tagFold1[table]) << 1);
+    return tag & ((1 << tagBits) - 1);
+}
+
+unsigned
+TageSCL::scIndex(unsigned pcb, int table, uint64_t recent,
+                 bool tage_pred) const
+{
+    // table 0 is a bias table, the others use 4, 8, 16 and 32 bits of
+    // global history
+    unsigned index = pcb ^ (pcb >> scBits);
+    if (table > 0) {
+        uint64_t hist = recent & ((1ULL << (2 << table)) - 1);
+        for (; hist != 0; hist >>= scBits)
+            index ^= (unsigned)hist;
+        index ^= table;
+    }
+
+    return ((index << 1) | tage_pred) & ((1 << scBits) - 1);
+}
+
+bool
+TageSCL::lookup(int thread, Addr pc, BPredUpdateRec *rec)
+{
+    unsigned pcb = pc >> BranchPredAddrShiftAmt;
+
+    rec->provider = -1;
+    rec->alt_provider = -1;
+    for (int i = 0; i < numTables; ++i) {
+        rec->tagged_index[i] = taggedIndex(thread, pcb, i);
+        rec->tagged_tag[i] = taggedTag(thread, pcb, i);
+    }
+    for (int i = numTables - 1; i >= 0; --i) {
+        if (tables[i][rec->tagged_index[i]].tag == rec->tagged_tag[i]) {
+            if (rec->provider < 0) {
+                rec->provider = i;
+            } else {
+                rec->alt_provider = i;
+                break;
+            }
+        }
+    }
+
+    /*
+     * TAGE
+     */
+    int base_ctr = base[pcb & ((1 << baseBits) - 1)];
+    bool base_pred = base_ctr >= 2;
+
+    if (rec->alt_provider >= 0) {
+        int alt = rec->alt_provider;
+        rec->alt_pred = tables[alt][rec->tagged_index[alt]].ctr >= 0;
+    } else {
+        rec->alt_pred = base_pred;
+    }
+
+    // confidence of TAGE as a centered counter value
+    int tage_conf;
+    if (rec->provider >= 0) {
+        int p = rec->provider;
+        int ctr = tables[p][rec->tagged_index[p]].ctr;
+        rec->provider_pred = ctr >= 0;
+        rec->provider_weak = ctr == 0 || ctr == -1;
+        rec->tage_pred = (rec->provider_weak && useAltOnNa >= 0) ?
+            rec->alt_pred : rec->provider_pred;
+        tage_conf = 2 * ctr + 1;
+    } else {
+        rec->provider_pred = base_pred;
+        rec->provider_weak = false;
+        rec->tage_pred = base_pred;
+        tage_conf = 2 * base_ctr - 3;
+    }
+
+    bool pred = rec->tage_pred;
+
+    /*
+     * L
+     */
+    rec->loop_valid = false;
+    rec->loop_entry = findLoop(pcb);
+    if (rec->loop_entry >= 0) {
+        const LoopEntry &loop = loops[rec->loop_entry];
+        rec->loop_iter = loop.specIter;
+        if (loop.conf == LoopMaxConf) {
+            rec->loop_valid = true;
+            rec->loop_pred =
+                loop.specIter == loop.pastIter ? !loop.dir : loop.dir;
+        }
+    }
+
+    /*
+     * SC
+     */
+    int sum = tage_conf * TageWeight;
+    for (int i = 0; i < ScTables; ++i)
+        sum += 2 * sc[i][scIndex(pcb, i, rec->hist_recent,
+                                 rec->tage_pred)] + 1;
+    rec->sc_sum = sum;
+    rec->sc_pred = sum >= 0;
+
+    if (rec->loop_valid && loopUse >= 0)
+        pred = rec->loop_pred;
+    else if (rec->sc_pred != rec->tage_pred && abs(sum) >= scThreshold)
+        pred = rec->sc_pred;
+
+    if (rec->loop_entry >= 0)
+        advanceLoop(loops[rec->loop_entry], pred);
+
+    return pred;
+}
+
+int
+TageSCL::findLoop(unsigned pcb) const
+{
+    int first = loopSet(pcb) * LoopWays;
+    for (int i = first; i < first + LoopWays; ++i) {
+        if (loops[i].tag == loopTag(pcb))
+            return i;
+    }
+    return -1;
+}
+
+void
+TageSCL::advanceLoop(LoopEntry &e, bool taken)
+{
+    if (taken == e.dir) {
+        if (e.specIter < LoopMaxIter)
+            e.specIter++;
+    } else {
+        e.specIter = 0;
+    }
+}
+
+void
+TageSCL::recover(Addr pc, bool taken, const BPredUpdateRec *rec)
+{
+    if (rec->loop_entry < 0)
+        return;
+
+    unsigned pcb = pc >> BranchPredAddrShiftAmt;
+    LoopEntry &e = loops[rec->loop_entry];
+    if (e.tag != loopTag(pcb))
+        return;
+
+    e.specIter = rec->loop_iter;
+    advanceLoop(e, taken);
+}
+
+void
+TageSCL::update(Addr pc, bool taken, BPredUpdateRec *rec)
+{
+    unsigned pcb = pc >> BranchPredAddrShiftAmt;
+
+    updateSC(pcb, taken, rec);
+    updateLoop(pcb, taken, rec);
+
+    /*
+     * TAGE
+     */
+    bool alloc = rec->tage_pred != taken;
+
+    if (rec->provider >= 0) {
+        int p = rec->provider;
+        TaggedEntry &e = tables[p][rec->tagged_index[p]];
+
+        // skip the update if the entry was replaced since the lookup
+        if (e.tag == rec->tagged_tag[p]) {
+            if (rec->provider_weak) {
+                // a new entry that predicted correctly needs no help
+                if (rec->provider_pred == taken)
+                    alloc = false;
+                if (rec->provider_pred != rec->alt_pred)
+                    satUpdate(useAltOnNa, rec->alt_pred == taken, -8, 7);
+            }
+
+            // the alternate prediction learns while the provider is not
+            // yet useful
+            if (e.u == 0) {
+                int alt = rec->alt_provider;
+                if (alt >= 0) {
+                    TaggedEntry &a = tables[alt][rec->tagged_index[alt]];
+                    if (a.tag == rec->tagged_tag[alt])
+                        satUpdate(a.ctr, taken, -4, 3);
+                } else {
+                    satUpdate(base[pcb & ((1 << baseBits) - 1)], taken, 0, 3);
+                }
+            }
+
+            satUpdate(e.ctr, taken, -4, 3);
+
+            if (rec->provider_pred != rec->alt_pred)
+                satUpdate(e.u, rec->provider_pred == taken, 0, 3);
+        }
+    } else {
+        satUpdate(base[pcb & ((1 << baseBits) - 1)], taken, 0, 3);
+    }
+
+    if (alloc && rec->provider < numTables - 1)
+        allocate(taken, rec);
+
+    // age the useful bits so that entries can be replaced eventually
+    if ((++updates & ((1 << UResetLog) - 1)) == 0) {
+        for (int i = 0; i < numTables; ++i)
+            for (int j = 0; j < tables[i].size(); ++j)
+                tables[i][j].u >>= 1;
+    }
+}
+
+void
+TageSCL::allocate(bool taken, BPredUpdateRec *rec)
+{
+    // sometimes skip a table so that not every branch ends up in the
+    // table just above its provider
+    int start = rec->provider + 1;
+    if (start < numTables - 1 && random())
+        start++;
+
+    for (int i = start; i < numTables; ++i) {
+        TaggedEntry &e = tables[i][rec->tagged_index[i]];
+        if (e.u == 0) {
+            e.tag = rec->tagged_tag[i];
+            e.ctr = taken ? 0 : -1;
+            return;
+        }
+    }
+
+    for (int i = start; i < numTables; ++i) {
+        TaggedEntry &e = tables[i][rec->tagged_index[i]];
+        if (e.u > 0)
+            e.u--;
+    }
+}
+
+void
+TageSCL::updateSC(unsigned pcb, bool taken, BPredUpdateRec *rec)
+{
+    // Adapt the threshold to how well overriding TAGE works out
+    if (rec->sc_pred != rec->tage_pred && abs(rec->sc_sum) >= scThreshold) {
+        satUpdate(scThresholdCtr, rec->sc_pred != taken, -32, 31);
+        if (scThresholdCtr == 31) {
+            scThreshold++;
+            scThresholdCtr = 0;
+        } else if (scThresholdCtr == -32 && scThreshold > 1) {
+            scThreshold--;
+            scThresholdCtr = 0;
+        }
+    }
+
+    if (rec->sc_pred == taken && abs(rec->sc_sum) >= scThreshold)
+        return;
+
+    int max = (1 << (ScCounterBits - 1)) - 1;
+    for (int i = 0; i < ScTables; ++i) {
+        int8_t &ctr = sc[i][scIndex(pcb, i, rec->hist_recent,
+                                    rec->tage_pred)];
+        satUpdate(ctr, taken, -max - 1, max);
+    }
+}
+
+void
+TageSCL::updateLoop(unsigned pcb, bool taken, BPredUpdateRec *rec)
+{
+    int entry = findLoop(pcb);
+
+    if (entry < 0) {
+        // try to catch a loop exit that TAGE missed, in a way that has
+        // not been useful for a while
+        if (rec->tage_pred == taken)
+            return;
+
+        int first = loopSet(pcb) * LoopWays;
+        for (int i = first; i < first + LoopWays; ++i) {
+            LoopEntry &e = loops[i];
+            if (e.age == 0) {
+                e.tag = loopTag(pcb);
+                e.dir = !taken;
+                e.pastIter = 0;
+                e.commitIter = 0;
+                e.specIter = 0;
+                e.conf = 0;
+                e.age = LoopMaxAge;
+                return;
+            }
+        }
+        for (int i = first; i < first + LoopWays; ++i)
+            loops[i].age--;
+        return;
+    }
+
+    LoopEntry &e = loops[entry];
+
+    if (rec->loop_valid) {
+        if (rec->loop_pred != rec->tage_pred) {
+            satUpdate(loopUse, rec->loop_pred == taken, -64, 63);
+            if (rec->loop_pred == taken && e.age < LoopMaxAge)
+                e.age++;
+        }
+        if (rec->loop_pred != taken) {
+            // the trip count changed: start over
+            e.conf = 0;
+            e.age = 0;
+            e.pastIter = 0;
+            e.commitIter = 0;
+            return;
+        }
+    }
+
+    if (taken == e.dir) {
+        if (++e.commitIter > LoopMaxIter) {
+            // not a loop we can track
+            e.conf = 0;
+            e.age = 0;
+            e.commitIter = 0;
+        }
+    } else {
+        if (e.commitIter == e.pastIter) {
+            if (e.conf < LoopMaxConf)
+                e.conf++;
+            // very short trips are as likely to be a random branch
+            if (e.pastIter < 3) {
+                e.conf = 0;
+                e.age = 0;
+            }
+        } else {
+            e.pastIter = e.commitIter;
+            e.conf = 0;
+        }
+        e.commitIter = 0;
+    }
+}
@@ -0,0 +1,245 @@
+/*
+ * tage.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef __ENCUMBERED_CPU_FULL_TAGE_HH__
+#define __ENCUMBERED_CPU_FULL_TAGE_HH__
+
+#include <vector>
+
+#include "cpu/smt.hh"
+#include "encumbered/cpu/full/bpred_update.hh"
+#include "sim/host.hh"
+
+/**
+ * Speculative global branch history for the TAGE-SC-L and ITTAGE
+ * predictors.
+ *
+ * Every control instruction shifts its predicted direction into the
+ * history at fetch and one bit of its address into the path history.
+ * The predictors index their tables with folded (compressed) copies of
+ * the history, which are kept up to date incrementally.
+ *
+ * Before a branch changes the history, save() stores the history
+ * position and the folded histories in the branch's BPredUpdateRec. A
+ * misprediction rewinds the history to that position with restore()
+ * and pushes the resolved outcome. The history buffer is much longer
+ * than the longest history used, so the bits older than an in-flight
+ * branch are still there when it recovers.
+ *
+ * @author Magnus Jahre
+ */
+class BranchHistory
+{
+  public:
+    static const int PathBits = 16;
+
+  private:
+    /** Room for the history shifted in by wrong-path branches. */
+    static const int Slack = 4096;
+
+    struct Fold
+    {
+        int length;
+        int width;
+        int outPoint;
+    };
+
+    struct ThreadHistory
+    {
+        uint8_t *bits;
+        int ptr;
+        uint64_t recent;
+        unsigned path;
+        std::vector<unsigned> folded;
+    };
+
+    std::vector<Fold> folds;
+    ThreadHistory threads[SMT_MAX_THREADS];
+    int mask;
+    int maxLength;
+
+    bool bit(const ThreadHistory &t, int age) const
+    {
+        return t.bits[(t.ptr + age) & mask];
+    }
+
+  public:
+    BranchHistory();
+    ~BranchHistory();
+
+    /**
+     * Registers a folded copy of the newest length history bits that
+     * is width bits wide. All folds must be added before init().
+     */
+    int addFold(int length, int width);
+
+    /** Allocates the history buffers. */
+    void init();
+
+    unsigned fold(int thread, int id) const
+    {
+        return threads[thread].folded[id];
+    }
+
+    /** The newest 64 history bits, newest in bit 0. */
+    uint64_t recent(int thread) const { return threads[thread].recent; }
+
+    unsigned path(int thread) const { return threads[thread].path; }
+
+    void save(int thread, BPredUpdateRec *rec) const;
+
+    void push(int thread, bool taken, Addr pc);
+
+    /** Rewinds the history to where it was before rec's branch. */
+    void restore(int thread, const BPredUpdateRec *rec);
+};
+
+/**
+ * TAGE-SC-L conditional branch predictor (Seznec, CBP 2016).
+ *
+ * TAGE: a bimodal base predictor and tagged tables indexed with
+ * geometrically increasing global history lengths. The longest matching
+ * table provides the prediction, unless its entry is newly allocated
+ * and the alternate prediction has proven better for such entries.
+ * Entries are allocated in longer tables on mispredictions.
+ *
+ * SC: a statistical corrector that sums signed counters indexed with
+ * the address, the TAGE prediction and short global histories, plus a
+ * term for the confidence of TAGE. It reverts the TAGE prediction when
+ * the sum strongly disagrees.
+ *
+ * L: a set associative loop predictor for branches with a constant
+ * trip count. Its iteration counts are advanced speculatively at
+ * lookup. A mispredicted branch restores the count of its own entry on
+ * recovery.
+ *
+ * The tagged table size is the largest that fits the storage budget
+ * together with the base predictor, the corrector and the loop table.
+ * All tables are shared by the hardware threads.
+ *
+ * @author Magnus Jahre
+ */
+class TageSCL
+{
+  private:
+    static const int LoopBits = 6;
+    static const int LoopWays = 4;
+    static const int LoopTagBits = 10;
+    static const int LoopMaxIter = 1023;
+    static const int LoopMaxConf = 3;
+    static const int LoopMaxAge = 7;
+    static const int LoopEntryBits = LoopTagBits + 3 * 10 + 2 + 3 + 1;
+
+    static const int ScTables = 5;
+    static const int ScCounterBits = 6;
+    static const int TageWeight = 8;
+
+    static const int UResetLog = 18;
+
+    struct TaggedEntry
+    {
+        int8_t ctr;
+        uint16_t tag;
+        uint8_t u;
+    };
+
+    struct LoopEntry
+    {
+        uint16_t tag;
+        uint16_t pastIter;
+        uint16_t commitIter;
+        uint16_t specIter;
+        uint8_t conf;
+        uint8_t age;
+        bool dir;
+    };
+
+    BranchHistory *history;
+
+    int numTables;
+    int indexBits;
+    int tagBits;
+    std::vector<int> histLength;
+    std::vector<int> indexFold;
+    std::vector<int> tagFold0;
+    std::vector<int> tagFold1;
+    std::vector<std::vector<TaggedEntry> > tables;
+
+    int baseBits;
+    std::vector<uint8_t> base;
+
+    int useAltOnNa;
+    unsigned updates;
+    unsigned seed;
+
+    std::vector<LoopEntry> loops;
+    int loopUse;
+
+    int scBits;
+    std::vector<int8_t> sc[ScTables];
+    int scThreshold;
+    int scThresholdCtr;
+
+    unsigned taggedIndex(int thread, unsigned pcb, int table) const;
+    unsigned taggedTag(int thread, unsigned pcb, int table) const;
+    unsigned scIndex(unsigned pcb, int table, uint64_t recent,
+                     bool tage_pred) const;
+
+    unsigned loopSet(unsigned pcb) const
+    {
+        return (pcb ^ (pcb >> LoopBits)) & ((1 << LoopBits) / LoopWays - 1);
+    }
+
+    unsigned loopTag(unsigned pcb) const
+    {
+        return (pcb / ((1 << LoopBits) / LoopWays)) &
+            ((1 << LoopTagBits) - 1);
+    }
+
+    bool random()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 1;
+    }
+
+    int findLoop(unsigned pcb) const;
+    void advanceLoop(LoopEntry &e, bool taken);
+    void updateLoop(unsigned pcb, bool taken, BPredUpdateRec *rec);
+    void updateSC(unsigned pcb, bool taken, BPredUpdateRec *rec);
+    void allocate(bool taken, BPredUpdateRec *rec);
+
+  public:
+    TageSCL(BranchHistory *history, int budget_kb, int num_tables,
+            int tag_bits, int min_hist, int max_hist);
+
+    /** Predicts the direction of the conditional branch at pc. */
+    bool lookup(int thread, Addr pc, BPredUpdateRec *rec);
+
+    /** Repairs the loop predictor after rec's branch mispredicted. */
+    void recover(Addr pc, bool taken, const BPredUpdateRec *rec);
+
+    /** Trains the predictor with the outcome of a committed branch. */
+    void update(Addr pc, bool taken, BPredUpdateRec *rec);
+};
+
+/**
+ * Update a signed saturating counter.
+ */
+template <class T>
+inline void
+satUpdate(T &ctr, bool incr, int min, int max)
+{
+    if (incr) {
+        if (ctr < max)
+            ++ctr;
+    } else {
+        if (ctr > min)
+            --ctr;
+    }
+}
+
+#endif // __ENCUMBERED_CPU_FULL_TAGE_HH__
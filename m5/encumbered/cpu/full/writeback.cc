@@ -492,7 +492,8 @@ BranchRecoveryEvent::process()
 	xc->regs.npc = correct_PC + sizeof(MachInst);
 
 	if (staticInst->isControl() && cpu->branch_pred)
-		cpu->branch_pred->recover(thread_number, branch_PC, &dir_update);
+		cpu->branch_pred->recover(thread_number, branch_PC, correct_PC,
+				&dir_update);
 
 	//
 	//  Only clear the pending flag if this event is the lowest
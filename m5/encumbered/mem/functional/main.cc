@@ -125,6 +125,8 @@ MainMemory::MainMemory(const string &n, int _maxMemMB, int _cpuID, int _victimEn
 	break_size = 4;
 
 	curFileEnd = 0;
+	haveSnapshot = false;
+	snapshotEnd = 0;
 	stringstream tmp;
 	tmp << "diskpages" << cpuID << ".bin";
 	diskpages.open(tmp.str().c_str(), ios::binary | ios::trunc | ios::out | ios::in);
@@ -153,6 +155,10 @@ MainMemory::VictimEntry::reset(){
 MainMemory::~MainMemory()
 {
 	diskpages.close();
+
+	map<uint64_t, uint8_t*>::iterator it = snapshotPages.begin();
+	for( ; it != snapshotPages.end(); it++) delete [] it->second;
+
 	delete blob;
 	delete pblob;
 	delete ptab;
@@ -316,6 +322,8 @@ MainMemory::writeDiskEntry(Addr oldAddr, uint8_t* page){
 
 	DPRINTF(FuncMem, "Writing page addr %x to disk at offset %d\n", d.pageAddress, d.offset);
 
+	if(d.offset < snapshotEnd) saveSnapshotPage(d.offset);
+
 	assert(diskpages.good());
 	diskpages.seekp(d.offset);
 	diskpages.write((char*) page, VMPageSize);
@@ -323,6 +331,39 @@ MainMemory::writeDiskEntry(Addr oldAddr, uint8_t* page){
 }
 
 
+void
+MainMemory::saveSnapshotPage(uint64_t offset){
+	if(dirtySnapshotPages.count(offset) > 0) return;
+	dirtySnapshotPages.insert(offset);
+
+	// the file still holds the snapshot contents until the first write
+	// to this page, keep the copy for all later restarts
+	if(snapshotPages.find(offset) == snapshotPages.end()){
+		uint8_t* page = new uint8_t[VMPageSize];
+		assert(diskpages.good());
+		diskpages.seekg(offset);
+		diskpages.read((char*) page, VMPageSize);
+		assert(diskpages.good());
+		snapshotPages[offset] = page;
+	}
+}
+
+void
+MainMemory::restoreSnapshot(){
+	DPRINTF(Restart, "Restoring %d of %d snapshot pages in diskpages\n",
+			dirtySnapshotPages.size(), snapshotEnd / VMPageSize);
+
+	set<uint64_t>::iterator it = dirtySnapshotPages.begin();
+	for( ; it != dirtySnapshotPages.end(); it++){
+		assert(snapshotPages.find(*it) != snapshotPages.end());
+		assert(diskpages.good());
+		diskpages.seekp(*it);
+		diskpages.write((char*) snapshotPages[*it], VMPageSize);
+		assert(diskpages.good());
+	}
+	dirtySnapshotPages.clear();
+}
+
 void
 MainMemory::readDiskEntry(int diskEntryIndex){
 
@@ -752,6 +793,7 @@ MainMemory::generateID(const char* prefix, int index, int linkedListNum){
 void
 MainMemory::clearDiskpages(){
 	DPRINTF(Restart, "Clearing diskEntries and closing diskpages...\n");
+	if(diskpages.is_open()) restoreSnapshot();
 	curFileEnd = 0;
 	diskEntries.clear();
 	diskpages.close();
@@ -790,23 +832,55 @@ MainMemory::unserialize(Checkpoint *cp, const std::string &section){
 	// read diskpage metadata
 	string filename;
 	UNSERIALIZE_SCALAR(filename);
-	DPRINTF(Restart, "Unserializing page file %s\n", filename);
-	ifstream pagefile(filename.c_str(),  ios::binary);
-	if(!pagefile.is_open()) fatal("could not read file %s", filename.c_str());
 
-	int numIndexes = *((int*) readEntry(sizeof(int), pagefile));
+	if(haveSnapshot && filename == snapshotPagefile){
+		// restart, the metadata is unchanged since the first unserialize
+		DPRINTF(Restart, "Restoring page file %s from snapshot\n", filename);
+		diskEntries = snapshotEntries;
+		curFileEnd = diskEntries.size();
+		return;
+	}
+
+	// binary checkpoints carry the page index themselves
+	vector<int64_t> addrs, offsets;
+	if(cp->findArray(section, "diskpage_addrs", addrs)
+	   && cp->findArray(section, "diskpage_offsets", offsets)){
+		DPRINTF(Restart, "Unserializing page index from checkpoint\n");
+		if(addrs.size() != offsets.size()) fatal("corrupt page index in checkpoint");
+		for(int i=0;i<addrs.size();i++){
+			DiskEntry d;
+			d.pageAddress = addrs[i];
+			d.offset = offsets[i];
+			diskEntries.push_back(d);
+		}
+		curFileEnd = diskEntries.size();
+	}
+	else{
+		DPRINTF(Restart, "Unserializing page file %s\n", filename);
+		ifstream pagefile(filename.c_str(),  ios::binary);
+		if(!pagefile.is_open()) fatal("could not read file %s", filename.c_str());
+
+		int numIndexes = *((int*) readEntry(sizeof(int), pagefile));
 
-	while(curFileEnd < numIndexes){
-		DiskEntry d;
-		d.pageAddress = *((Addr*) readEntry(sizeof(Addr), pagefile));
-		d.offset = *((uint64_t*) readEntry(sizeof(uint64_t), pagefile));
+		while(curFileEnd < numIndexes){
+			DiskEntry d;
+			d.pageAddress = *((Addr*) readEntry(sizeof(Addr), pagefile));
+			d.offset = *((uint64_t*) readEntry(sizeof(uint64_t), pagefile));
 
-		diskEntries.push_back(d);
+			diskEntries.push_back(d);
 
-		curFileEnd += 1;
+			curFileEnd += 1;
+		}
+
+		pagefile.close();
 	}
 
-	pagefile.close();
+	// take the restart snapshot, the diskpages file is clean at this point
+	assert(!haveSnapshot);
+	haveSnapshot = true;
+	snapshotEnd = curFileEnd * VMPageSize;
+	snapshotPagefile = filename;
+	snapshotEntries = diskEntries;
 
 //	addr = 0x12a01de30;
 //	data = 0;
@@ -821,9 +895,6 @@ MainMemory::removeMemoryFiles(){
 	stringstream filename;
 	filename << "diskpages-cpt" << cpuID << ".bin";
 	removeMemoryFile(filename.str());
-
-	filename << ".clean";
-	removeMemoryFile(filename.str());
 }
 
 void
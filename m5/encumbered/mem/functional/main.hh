@@ -89,6 +89,8 @@
 #define __MAIN_MEMORY_HH__
 
 #include <fstream>
+#include <map>
+#include <set>
 
 #include "mem/functional/functional.hh"
 
@@ -211,6 +213,20 @@ protected:
 	std::fstream diskpages;
 	uint64_t curFileEnd;
 
+	// Restart snapshot of the checkpointed diskpages file. Pages in the
+	// checkpointed region are saved in memory before they are first
+	// overwritten, so clearDiskpages() can restore the file by writing
+	// back only the pages touched since the last restart.
+	bool haveSnapshot;
+	uint64_t snapshotEnd;
+	std::string snapshotPagefile;
+	std::vector<DiskEntry> snapshotEntries;
+	std::map<uint64_t, uint8_t*> snapshotPages;
+	std::set<uint64_t> dirtySnapshotPages;
+
+	void saveSnapshotPage(uint64_t offset);
+	void restoreSnapshot();
+
 	int allocatedVictims;
 	std::vector<VictimEntry> victimBuffer;
 
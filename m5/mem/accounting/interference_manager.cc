@@ -2,6 +2,7 @@
 #include "interference_manager.hh"
 
 #include "sim/builder.hh"
+#include "mem/accounting/private_mode_reference.hh"
 
 using namespace std;
 
@@ -78,6 +79,7 @@ InterferenceManager::InterferenceManager(std::string _name,
 
 	missBandwidthPolicy = NULL;
 	cacheInterference = NULL;
+	privateModeReference = NULL;
 
 	traceStarted = false;
 
@@ -220,7 +222,7 @@ InterferenceManager::regStats(){
 		.init(intManCPUCount)
 		.name(name() + ".requests")
 		.desc("total number of requests")
-		.flags(total);
+		.flags(total | nofilter);
 
 	avgRoundTripLatency
 		.name(name() + ".avg_round_trip_latency")
@@ -718,6 +720,21 @@ InterferenceManager::registerCacheInterferenceObj(CacheInterference* ci){
 	cacheInterference = ci;
 }
 
+void
+InterferenceManager::registerPrivateModeReference(PrivateModeReference* reference){
+	assert(privateModeReference == NULL);
+	privateModeReference = reference;
+}
+
+void
+InterferenceManager::addSharedCacheAccess(MemReqPtr& req){
+	if(privateModeReference == NULL) return;
+	if(req->cmd != Read && req->cmd != Writeback) return;
+
+	bool measured = req->cmd == Read && !req->instructionMiss && !checkForStore(req);
+	privateModeReference->addAccess(req, measured);
+}
+
 void
 InterferenceManager::registerMissBandwidthPolicy(BasePolicy* policy){
 	assert(missBandwidthPolicy == NULL);
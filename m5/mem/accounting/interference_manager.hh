@@ -24,6 +24,7 @@ class Bus;
 class MSHROccupancy;
 class OverlapStatistics;
 class PerformanceModel;
+class PrivateModeReference;
 
 #include <vector>
 
@@ -290,6 +291,8 @@ public:
 
 	CacheInterference* cacheInterference;
 
+	PrivateModeReference* privateModeReference;
+
 	typedef enum{
 			InterconnectEntry,
 			InterconnectRequestQueue,
@@ -382,6 +385,14 @@ public:
 
 	void addCacheResult(MemReqPtr& req);
 
+	void registerPrivateModeReference(PrivateModeReference* reference);
+
+	PrivateModeReference* getPrivateModeReference(){
+		return privateModeReference;
+	}
+
+	void addSharedCacheAccess(MemReqPtr& req);
+
 	PerformanceMeasurement buildInterferenceMeasurement(int period);
 
 	void registerMissBandwidthPolicy(BasePolicy* policy);
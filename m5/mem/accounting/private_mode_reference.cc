@@ -0,0 +1,356 @@
+/*
+ * private_mode_reference.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <algorithm>
+#include <fstream>
+
+#include "mem/accounting/private_mode_reference.hh"
+#include "mem/accounting/interference_manager.hh"
+#include "mem/timing/base_memory.hh"
+#include "base/intmath.hh"
+#include "base/str.hh"
+#include "sim/builder.hh"
+
+using namespace std;
+
+PrivateModeReference::PrivateModeReference(string _name,
+		                                   InterferenceManager* _intManager,
+		                                   int _cpuCount,
+		                                   int _size,
+		                                   int _banks,
+		                                   int _assoc,
+		                                   int _blockSize,
+		                                   Tick _cacheLatency,
+		                                   Tick _transferLatency,
+		                                   BaseMemory* _memory,
+		                                   vector<string> _aloneTraces,
+		                                   bool _useThreads)
+: SimObject(_name){
+
+	cpuCount = _cpuCount;
+	cacheLatency = _cacheLatency;
+	transferLatency = _transferLatency;
+	memory = _memory;
+	useThreads = _useThreads;
+
+	if(!IsPowerOf2(_blockSize)) fatal("The private mode reference block size must be a power of 2");
+	if(memory == NULL) fatal("The private mode reference needs the simulated memory");
+
+	int numSets = (_size * _banks) / (_blockSize * _assoc);
+	if(numSets <= 0) fatal("The private mode reference cache must have at least one set");
+
+	replicas.resize(cpuCount, NULL);
+	for(int i=0;i<cpuCount;i++){
+		replicas[i] = new Replica(this, numSets, _assoc, _blockSize);
+	}
+	logs.resize(cpuCount, vector<Access>());
+
+	if(!_aloneTraces.empty() && _aloneTraces.size() != cpuCount){
+		fatal("The private mode reference needs one alone mode trace per core, got %d", _aloneTraces.size());
+	}
+	aloneSamples.resize(cpuCount, vector<AloneSample>());
+	for(int i=0;i<_aloneTraces.size();i++){
+		readAloneTrace(i, _aloneTraces[i]);
+	}
+
+	_intManager->registerPrivateModeReference(this);
+}
+
+PrivateModeReference::~PrivateModeReference(){
+	for(int i=0;i<replicas.size();i++){
+		if(replicas[i]->running) pthread_join(replicas[i]->thread, NULL);
+		delete replicas[i];
+	}
+}
+
+void
+PrivateModeReference::regStats(){
+	missedAloneSamples
+		.init(cpuCount)
+		.name(name() + ".missed_alone_samples")
+		.desc("samples with no alone mode trace sample at the same instruction count")
+		.flags(Stats::total);
+}
+
+void
+PrivateModeReference::addAccess(MemReqPtr& req, bool measured){
+	assert(req->adaptiveMHASenderID >= 0 && req->adaptiveMHASenderID < cpuCount);
+
+	Access access;
+	access.addr = req->paddr;
+	access.at = curTick;
+	access.isWrite = req->cmd.isWrite();
+	access.measured = measured;
+	logs[req->adaptiveMHASenderID].push_back(access);
+}
+
+void
+PrivateModeReference::readAloneTrace(int cpuID, string filename){
+	ifstream tracefile(filename.c_str());
+	if(!tracefile.is_open()) fatal("Could not open alone mode trace %s", filename.c_str());
+
+	string line;
+	vector<string> columns;
+	getline(tracefile, line);
+	tokenize(columns, line, ';', false);
+
+	int instCol = find(columns.begin(), columns.end(), "Cummulative Committed Instructions") - columns.begin();
+	int cycleCol = find(columns.begin(), columns.end(), "Total Cycles") - columns.begin();
+	if(instCol == columns.size() || cycleCol == columns.size()){
+		fatal("%s is not a CommittedInsts trace", filename.c_str());
+	}
+
+	while(getline(tracefile, line)){
+		if(line.empty()) continue;
+
+		vector<string> values;
+		tokenize(values, line, ';', false);
+
+		AloneSample sample;
+		if(values.size() != columns.size()
+		   || !to_number(values[instCol], sample.insts)
+		   || !to_number(values[cycleCol], sample.cycles)){
+			fatal("Malformed line in alone mode trace %s: %s", filename.c_str(), line.c_str());
+		}
+		if(!aloneSamples[cpuID].empty() && sample.insts <= aloneSamples[cpuID].back().insts){
+			fatal("Instruction counts in alone mode trace %s are not increasing", filename.c_str());
+		}
+		aloneSamples[cpuID].push_back(sample);
+	}
+}
+
+bool
+PrivateModeReference::findAloneSample(int cpuID, Tick committedInsts, AloneSample& sample){
+	vector<AloneSample>& samples = aloneSamples[cpuID];
+
+	AloneSample key;
+	key.insts = committedInsts;
+	vector<AloneSample>::iterator it = lower_bound(samples.begin(), samples.end(), key);
+	if(it == samples.end() || it->insts != committedInsts){
+		missedAloneSamples[cpuID]++;
+		return false;
+	}
+
+	sample.insts = it == samples.begin() ? it->insts : it->insts - (it-1)->insts;
+	sample.cycles = it->cycles;
+	return true;
+}
+
+PrivateModeReference::Result
+PrivateModeReference::sample(int cpuID, Tick committedInsts){
+	Replica* replica = replicas[cpuID];
+
+	if(replica->running){
+		pthread_join(replica->thread, NULL);
+		replica->running = false;
+	}
+	Result previous = replica->result;
+
+	replica->batch.swap(logs[cpuID]);
+	logs[cpuID].clear();
+
+	// Spread the accesses of the sample over its private mode length
+	Tick sharedCycles = curTick - replica->sampleStart;
+	Tick aloneCycles = sharedCycles;
+	replica->batchIPC = 0.0;
+
+	AloneSample alone;
+	if(!aloneSamples[cpuID].empty() && findAloneSample(cpuID, committedInsts, alone) && alone.cycles > 0){
+		aloneCycles = alone.cycles;
+		replica->batchIPC = (double) alone.insts / (double) alone.cycles;
+	}
+
+	replica->batchStart = replica->sampleStart;
+	replica->aloneStart = replica->aloneTime;
+	replica->timeScale = sharedCycles > 0 ? (double) aloneCycles / (double) sharedCycles : 1.0;
+
+	replica->sampleStart = curTick;
+	replica->aloneTime += aloneCycles;
+
+	if(useThreads && pthread_create(&replica->thread, NULL, runReplica, replica) == 0){
+		replica->running = true;
+	}
+	else{
+		replica->replay();
+	}
+
+	return previous;
+}
+
+void*
+PrivateModeReference::runReplica(void* arg){
+	Replica* replica = (Replica*) arg;
+	replica->replay();
+	return NULL;
+}
+
+PrivateModeReference::Replica::Replica(PrivateModeReference* _reference, int _numSets, int _assoc, int _blockSize){
+	reference = _reference;
+	numSets = _numSets;
+	assoc = _assoc;
+	blockBits = FloorLog2(_blockSize);
+
+	tags.resize(numSets*assoc, 0);
+	lastUsed.resize(numSets*assoc, 0);
+	valid.resize(numSets*assoc, false);
+	dirty.resize(numSets*assoc, false);
+	useCounter = 0;
+
+	openPage.resize(reference->memory->getBankCount(), (Addr) -1);
+	bankFreeAt.resize(reference->memory->getBankCount(), 0);
+	busFreeAt = 0;
+
+	batchStart = 0;
+	aloneStart = 0;
+	timeScale = 1.0;
+	batchIPC = 0.0;
+
+	sampleStart = curTick;
+	aloneTime = curTick;
+
+	running = false;
+}
+
+bool
+PrivateModeReference::Replica::accessCache(Addr addr, bool isWrite, Tick at){
+	Addr blkAddr = addr >> blockBits;
+	int set = blkAddr % numSets;
+	int first = set*assoc;
+
+	useCounter++;
+
+	int victim = first;
+	for(int i=first;i<first+assoc;i++){
+		if(valid[i] && tags[i] == blkAddr){
+			lastUsed[i] = useCounter;
+			if(isWrite) dirty[i] = true;
+			return true;
+		}
+		if(!valid[i]){
+			victim = i;
+		}
+		else if(valid[victim] && lastUsed[i] < lastUsed[victim]){
+			victim = i;
+		}
+	}
+
+	if(valid[victim] && dirty[victim]){
+		accessMemory(tags[victim] << blockBits, at);
+	}
+
+	tags[victim] = blkAddr;
+	valid[victim] = true;
+	dirty[victim] = isWrite;
+	lastUsed[victim] = useCounter;
+	return false;
+}
+
+Tick
+PrivateModeReference::Replica::accessMemory(Addr addr, Tick at){
+	BaseMemory* memory = reference->memory;
+	Addr page = memory->getPage(addr);
+	int bank = memory->getBank(addr);
+	assert(bank >= 0 && bank < openPage.size());
+
+	Tick latency;
+	if(openPage[bank] == page) latency = memory->getPageHitLatency();
+	else if(openPage[bank] == (Addr) -1) latency = memory->getPageClosedLatency();
+	else latency = memory->getPageConflictLatency();
+
+	// The burst is part of the latency, it has to wait for the data bus
+	Tick start = at > bankFreeAt[bank] ? at : bankFreeAt[bank];
+	Tick done = start + latency;
+	Tick burst = memory->getBurstLatency();
+	if(done - burst < busFreeAt) done = busFreeAt + burst;
+
+	openPage[bank] = page;
+	bankFreeAt[bank] = done;
+	busFreeAt = done;
+
+	return done - at;
+}
+
+void
+PrivateModeReference::Replica::replay(){
+	result = Result();
+	Tick latencySum = 0;
+
+	for(int i=0;i<batch.size();i++){
+		Access& a = batch[i];
+		Tick at = aloneStart + (Tick) ((a.at - batchStart) * timeScale);
+		Tick arrival = at + reference->cacheLatency;
+		bool hit = accessCache(a.addr, a.isWrite, arrival);
+
+		if(!a.measured) continue;
+
+		Tick latency = reference->transferLatency + reference->cacheLatency;
+		if(hit){
+			result.hits++;
+		}
+		else{
+			result.misses++;
+			latency += accessMemory(a.addr, arrival);
+		}
+		result.reads++;
+		latencySum += latency;
+	}
+
+	if(result.reads > 0) result.avgLatency = (double) latencySum / (double) result.reads;
+	result.aloneIPC = batchIPC;
+	result.valid = true;
+	batch.clear();
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+BEGIN_DECLARE_SIM_OBJECT_PARAMS(PrivateModeReference)
+	SimObjectParam<InterferenceManager*> interferenceManager;
+	Param<int> cpuCount;
+	Param<int> size;
+	Param<int> banks;
+	Param<int> assoc;
+	Param<int> blockSize;
+	Param<Tick> cacheLatency;
+	Param<Tick> transferLatency;
+	SimObjectParam<BaseMemory*> memory;
+	VectorParam<string> aloneTraces;
+	Param<bool> useThreads;
+END_DECLARE_SIM_OBJECT_PARAMS(PrivateModeReference)
+
+BEGIN_INIT_SIM_OBJECT_PARAMS(PrivateModeReference)
+	INIT_PARAM(interferenceManager, "Pointer to the interference manager"),
+	INIT_PARAM(cpuCount, "Number of cores"),
+	INIT_PARAM(size, "Capacity of one shared cache bank in bytes"),
+	INIT_PARAM_DFLT(banks, "Number of shared cache banks", 1),
+	INIT_PARAM(assoc, "Shared cache associativity"),
+	INIT_PARAM(blockSize, "Shared cache block size"),
+	INIT_PARAM(cacheLatency, "Shared cache hit latency"),
+	INIT_PARAM_DFLT(transferLatency, "Latency between the private cache and the shared cache", 0),
+	INIT_PARAM(memory, "The simulated memory, gives the DRAM timing"),
+	INIT_PARAM_DFLT(aloneTraces, "CommittedInsts traces of private mode runs, one per core", vector<string>()),
+	INIT_PARAM_DFLT(useThreads, "Replay the replicas on worker threads", true)
+END_INIT_SIM_OBJECT_PARAMS(PrivateModeReference)
+
+CREATE_SIM_OBJECT(PrivateModeReference)
+{
+	return new PrivateModeReference(getInstanceName(),
+			                        interferenceManager,
+			                        cpuCount,
+			                        size,
+			                        banks,
+			                        assoc,
+			                        blockSize,
+			                        cacheLatency,
+			                        transferLatency,
+			                        memory,
+			                        aloneTraces,
+			                        useThreads);
+}
+
+REGISTER_SIM_OBJECT("PrivateModeReference", PrivateModeReference)
+
+#endif
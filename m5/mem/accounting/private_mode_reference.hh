@@ -0,0 +1,192 @@
+/*
+ * private_mode_reference.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef PRIVATE_MODE_REFERENCE_HH_
+#define PRIVATE_MODE_REFERENCE_HH_
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "sim/sim_object.hh"
+#include "mem/mem_req.hh"
+
+class InterferenceManager;
+class BaseMemory;
+
+/**
+* A trace-based private mode reference. It approximates the private mode
+* behaviour of each core in the same process as the shared mode
+* simulation, and is meant for checking the interference estimates.
+*
+* The reference keeps one replica of the shared memory system per core.
+* Every access a core makes to the shared cache is logged, and when the
+* core's performance sample is taken the log is replayed on the core's
+* replica. A replica is a simplified model, not a copy of the simulated
+* memory system:
+*  - the shared cache is a full map of tags with true LRU replacement,
+*  - the DRAM keeps one open row per bank and uses the bank mapping and
+*    uncontended latencies of the simulated memory,
+*  - there is no memory controller queue, only bank and data bus busy
+*    times,
+*  - the writeback of a dirty victim is issued before the miss that
+*    evicted it.
+* The latencies it reports are therefore estimates of the alone mode
+* latencies, with their own modelling error.
+*
+* The replica does not model the core, so the alone mode IPC is read
+* from the CommittedInsts trace of a separate private mode run of each
+* core's benchmark. The private mode runs are still needed for IPC. A
+* shared mode sample is matched with the trace sample that ends at the
+* same committed instruction count. The same trace gives the length of
+* each sample in private mode, and the accesses of a sample are spread
+* over that length when they are replayed. Samples without a matching
+* trace sample are replayed at their shared mode times, report no IPC
+* and are counted in missed_alone_samples. This happens when policy
+* period samples do not line up with the trace. Without a trace, no IPC
+* is reported.
+*
+* Replays run on one worker thread per core while the simulation
+* continues. The result of a replay is picked up when the next sample
+* for the same core is taken, so results lag one sample behind. The
+* same lag is used when the replays run inline, which makes the results
+* independent of the use of threads.
+*
+* @author Magnus Jahre
+*/
+class PrivateModeReference : public SimObject{
+
+public:
+	class Result{
+	public:
+		bool valid;
+		int reads;
+		int hits;
+		int misses;
+		double avgLatency;
+		double aloneIPC;
+
+		Result(){
+			valid = false;
+			reads = 0;
+			hits = 0;
+			misses = 0;
+			avgLatency = 0.0;
+			aloneIPC = 0.0;
+		}
+	};
+
+private:
+	struct Access{
+		Addr addr;
+		Tick at;
+		bool isWrite;
+		bool measured;
+	};
+
+	/** One sample of a private mode CommittedInsts trace */
+	struct AloneSample{
+		Tick insts;
+		Tick cycles;
+
+		bool operator<(const AloneSample& other) const{
+			return insts < other.insts;
+		}
+	};
+
+	class Replica{
+	public:
+		int numSets;
+		int assoc;
+		int blockBits;
+
+		std::vector<Addr> tags;
+		std::vector<Tick> lastUsed;
+		std::vector<bool> valid;
+		std::vector<bool> dirty;
+		Tick useCounter;
+
+		std::vector<Addr> openPage;
+		std::vector<Tick> bankFreeAt;
+		Tick busFreeAt;
+
+		std::vector<Access> batch;
+		Tick batchStart;
+		Tick aloneStart;
+		double timeScale;
+		double batchIPC;
+		Result result;
+
+		Tick sampleStart;
+		Tick aloneTime;
+
+		pthread_t thread;
+		bool running;
+
+		PrivateModeReference* reference;
+
+		Replica(PrivateModeReference* _reference, int _numSets, int _assoc, int _blockSize);
+
+		bool accessCache(Addr addr, bool isWrite, Tick at);
+		Tick accessMemory(Addr addr, Tick at);
+		void replay();
+	};
+
+	int cpuCount;
+	std::vector<Replica*> replicas;
+	std::vector<std::vector<Access> > logs;
+	std::vector<std::vector<AloneSample> > aloneSamples;
+
+	Tick cacheLatency;
+	Tick transferLatency;
+	BaseMemory* memory;
+	bool useThreads;
+
+	Stats::Vector<> missedAloneSamples;
+
+	static void* runReplica(void* arg);
+
+	void readAloneTrace(int cpuID, std::string filename);
+	bool findAloneSample(int cpuID, Tick committedInsts, AloneSample& sample);
+
+public:
+	PrivateModeReference(std::string _name,
+			             InterferenceManager* _intManager,
+			             int _cpuCount,
+			             int _size,
+			             int _banks,
+			             int _assoc,
+			             int _blockSize,
+			             Tick _cacheLatency,
+			             Tick _transferLatency,
+			             BaseMemory* _memory,
+			             std::vector<std::string> _aloneTraces,
+			             bool _useThreads);
+
+	~PrivateModeReference();
+
+	void regStats();
+
+	/**
+	 * Logs a shared cache access. Only measured accesses contribute to
+	 * the latency, all accesses update the replica state.
+	 */
+	void addAccess(MemReqPtr& req, bool measured);
+
+	/**
+	 * Hands the accesses logged since the last sample to the replica of
+	 * this core and returns the result of the previous hand off.
+	 *
+	 * @param cpuID The core that took a sample.
+	 * @param committedInsts The instructions the core has committed in
+	 *                       all samples so far.
+	 */
+	Result sample(int cpuID, Tick committedInsts);
+};
+
+#endif /* PRIVATE_MODE_REFERENCE_HH_ */
@@ -168,6 +168,16 @@ class BaseMem : public BaseHier
         fatal("Not implemented");
         return 0;
     }
+
+    virtual Addr getPage(Addr addr){
+        fatal("Not implemented");
+        return 0;
+    }
+
+    virtual Addr getPageAddr(Addr page){
+        fatal("Not implemented");
+        return 0;
+    }
     
     virtual int getMemoryBankCount(){
         fatal("Not implemented");
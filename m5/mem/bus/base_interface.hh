@@ -242,6 +242,16 @@ class BaseInterface : public BaseHier
         return 0;
     }
 
+    virtual Addr getPage(Addr addr){
+        fatal("Should not be called");
+        return 0;
+    }
+
+    virtual Addr getPageAddr(Addr page){
+        fatal("Should not be called");
+        return 0;
+    }
+
     virtual int getMemoryBankCount(){
         fatal("Should not be called");
         return 0;
@@ -35,6 +35,7 @@
  */
 
 #include <cassert>
+#include <climits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -44,12 +45,14 @@
 #include "base/cprintf.hh"
 #include "base/intmath.hh"
 #include "base/misc.hh"
+#include "base/output.hh"
 #include "base/callback.hh"
 #include "cpu/smt.hh"
 #include "mem/bus/bus.hh"
 // #include "mem/bus/bus_interface.hh"
 #include "sim/builder.hh"
 #include "sim/host.hh"
+#include "sim/stat_control.hh"
 #include "sim/stats.hh"
 
 #include "mem/bus/controller/rdfcfs_memory_controller.hh"
@@ -82,7 +85,8 @@ Bus::Bus(const string &_name,
          bool _infiniteBW,
          InterferenceManager* intman,
          double _utilizationLimit,
-         BasePolicy* _policy)
+         BasePolicy* _policy,
+         string _arrivalTrace)
     : BaseHier(_name, hier_params)
 {
     width = _width;
@@ -92,7 +96,9 @@ Bus::Bus(const string &_name,
     infiniteBW = _infiniteBW;
 
     interferenceManager = intman;
-    interferenceManager->registerBus(this);
+    if(interferenceManager != NULL){
+        interferenceManager->registerBus(this);
+    }
 
     serviceCyclesSample = 0;
     queueCyclesSample = 0;
@@ -145,7 +151,7 @@ Bus::Bus(const string &_name,
 
     queuedRequestsCounter = 0;
 
-    need_to_sort = true;
+    arbSequence = 0;
 
     perCPUDataBusUse.resize(cpu_count, 0);
     perCPUQueueCycles.resize(cpu_count, 0);
@@ -154,11 +160,6 @@ Bus::Bus(const string &_name,
     outstandingReads.resize(cpu_count, 0);
     outstandingWrites.resize(cpu_count, 0);
 
-    int rl = _memoryController->getReadQueueLength()+1;
-    int wl = _memoryController->getWriteQueueLength()+1;
-    queueDelaySum.resize(cpu_count, vector<vector<Tick> >(rl, vector<Tick>(wl, 0)));
-    queueDelayRequests.resize(cpu_count, vector<vector<int> >(rl, vector<int>(wl, 0)));
-
     if(_adaptiveMHA != NULL) _adaptiveMHA->registerBus(this);
 
     if(_fwController != NULL) fatal("Fast forward memory controller not implemented");
@@ -170,9 +171,6 @@ Bus::Bus(const string &_name,
 
     detailedSimulationStart = _switch_at;
 
-    MemoryBusQueuedReqEvent* qrm = new MemoryBusQueuedReqEvent(this);
-    qrm->schedule(curTick+1);
-
     if(_utilizationLimit > 0 && cpu_count != 1) fatal("Utilization limit only makes sense for single core experiments");
     if(_utilizationLimit > 1.0) fatal("The utilization limit cannot be larger than 1.0");
     if(_utilizationLimit == 0.0) utilizationLimit = 1.0;
@@ -180,6 +178,11 @@ Bus::Bus(const string &_name,
 
     trafficGenerator = NULL;
 
+    arrivalTrace = NULL;
+    if(_arrivalTrace != ""){
+        arrivalTrace = new RequestStreamWriter(simout.resolve(_arrivalTrace));
+    }
+
     doRequestQueueTrace = false;
     //doRequestQueueTrace = true;
     queueSizeTrace = RequestTrace(_name, "QueueSizeTrace");
@@ -189,6 +192,8 @@ Bus::Bus(const string &_name,
 
     bandwidthTraceData = new MemoryBusTraceData(_name, _cpu_count);
 
+    Stats::registerDumpCallback(new MakeCallback<Bus, &Bus::closeQueueInterval>(this));
+
     Tick bwtracefreq = 1048578;//FIXME: parameterize
     MemoryBusBandwidthTraceEvent* bwte = new MemoryBusBandwidthTraceEvent(this, bwtracefreq);
     bwte->schedule(bwtracefreq);
@@ -235,6 +240,7 @@ Bus::~Bus()
 {
     delete memoryControllerEvent;
     delete bandwidthTraceData;
+    if(arrivalTrace != NULL) delete arrivalTrace;
 }
 
 /* register bus stats */
@@ -365,10 +371,33 @@ Bus::regStats()
 }
 
 void
-Bus::addQueueLengthSample(){
-	int numQueuedReqs = memoryController->getWaitingReadCount() + memoryController->getWaitingWriteCount();
-	bandwidthTraceData->addQueueSizeStats(memoryController->getWaitingReadCount(), memoryController->getWaitingWriteCount());
-	queueSizeDistribution.sample(numQueuedReqs);
+Bus::updateQueueOccupancy(){
+	int reads = memoryController->getWaitingReadCount();
+	int writes = memoryController->getWaitingWriteCount();
+	bandwidthTraceData->setQueueSize(reads, writes);
+
+	if(reads + writes == queueOccupancy.value()) return;
+
+	// the distribution counts the ticks each queue size was held
+	int prevQueuedReqs = queueOccupancy.value();
+	Tick held = queueOccupancy.set(reads + writes);
+	sampleQueueSize(prevQueuedReqs, held);
+}
+
+void
+Bus::sampleQueueSize(int queued, Tick held){
+	while(held > 0){
+		int samples = held > INT_MAX ? INT_MAX : (int) held;
+		queueSizeDistribution.sample(queued, samples);
+		held -= samples;
+	}
+}
+
+void
+Bus::closeQueueInterval(){
+	// the current queue size has been held since the last change
+	int queued = queueOccupancy.value();
+	sampleQueueSize(queued, queueOccupancy.set(queued));
 }
 
 void
@@ -383,6 +412,8 @@ void Bus::incInterferenceMisses(){
 void
 Bus::resetStats()
 {
+	// the ticks before the reset belong to the previous window
+	queueOccupancy.reset();
 }
 
 void
@@ -401,8 +432,6 @@ Bus::requestAddrBus(int id, Tick time)
 
     AddrArbiterEvent *eventptr = new AddrArbiterEvent(this,id,time);
 
-    need_to_sort = true;
-
     if (!arbiter_scheduled_flag) {
         assert(arb_events.empty());
         assert(time >= curTick);
@@ -412,19 +441,26 @@ Bus::requestAddrBus(int id, Tick time)
     }
     else if (currently_scheduled->original_time > time) {
         currently_scheduled->deschedule();
-        arb_events.push_back(currently_scheduled);
+        queueArbiterEvent(currently_scheduled);
         assert(time >= curTick);
         eventptr->schedule(time);
         currently_scheduled = eventptr;
         assert(arbiter_scheduled_flag);
     }
     else {
-        arb_events.push_back(eventptr);
+        queueArbiterEvent(eventptr);
     }
 
     livearbs++;
 }
 
+void
+Bus::queueArbiterEvent(AddrArbiterEvent *event)
+{
+    event->sequence = arbSequence++;
+    arb_events.push(event);
+}
+
 void
 Bus::arbitrateAddrBus(int interfaceid, Tick requestedAt)
 {
@@ -466,13 +502,17 @@ Bus::sendAddr(MemReqPtr &req, Tick origReqTime)
     	else writesPerCPU[req->adaptiveMHASenderID]++;
     }
 
+    // replayed requests have no bus interface to name or deliver to
+    bool replaying = trafficGenerator != NULL && trafficGenerator->isReplaying();
+
     DPRINTF(Bus, "issuing req %s addr %d from id %d, name %s\n",
 	    req->cmd.toString(), req->paddr,
-	    req->busId, interfaces[req->busId]->name());
+	    req->busId, replaying ? "replay" : interfaces[req->busId]->name());
 
 #ifdef INJECT_TEST_REQUESTS
     while(!testRequests.empty()){
         memoryController->insertRequest(testRequests.front());
+        updateQueueOccupancy();
         testRequests.pop_front();
     }
 #endif
@@ -480,7 +520,10 @@ Bus::sendAddr(MemReqPtr &req, Tick origReqTime)
     // Warm up code that removes the effects of contention (possible to compare shared and alone configurations)
     // Infinite bandwidth, all requests are page hits
     if(curTick < detailedSimulationStart || infiniteBW){
-        if (req->cmd == Read) {
+        if (replaying) {
+            trafficGenerator->replayCompleted(req, origReqTime + WARMUP_LATENCY);
+        }
+        else if (req->cmd == Read) {
             assert(req->busId < interfaces.size() && req->busId > -1);
             DeliverEvent *deliverevent = new DeliverEvent(interfaces[req->busId], req);
             deliverevent->schedule(origReqTime + WARMUP_LATENCY);
@@ -514,15 +557,20 @@ Bus::sendAddr(MemReqPtr &req, Tick origReqTime)
 
     // Insert request into memory controller
     memoryController->insertRequest(req);
+    updateQueueOccupancy();
     totalRequests++;
     traceQueuedRequests(true);
 
+    if(arrivalTrace != NULL){
+        arrivalTrace->write(req, curTick);
+    }
+
 #ifdef DO_BUS_TRACE
 #ifndef INJECT_TEST_REQUESTS
     assert(slaveInterfaces.size() == 1);
     writeTraceFileLine(req->paddr,
                        slaveInterfaces[0]->getMemoryBankID(req->paddr),
-                       (req->paddr >> slaveInterfaces[0]->getPageSize()),
+                       slaveInterfaces[0]->getPage(req->paddr),
                        -1,
                        req->cmd,
                        "Request");
@@ -544,6 +592,7 @@ Bus::handleMemoryController(bool isShadow, int ctrlID)
     if (memoryController->hasMoreRequests()) {
 
         MemReqPtr request = memoryController->getRequest();
+        updateQueueOccupancy();
 
         DPRINTF(Bus, "sending req %s addr %d \n", request->cmd.toString(), request->paddr);
 
@@ -557,7 +606,7 @@ Bus::handleMemoryController(bool isShadow, int ctrlID)
         assert(slaveInterfaces.size() == 1);
         writeTraceFileLine(request->paddr,
                         slaveInterfaces[0]->getMemoryBankID(request->paddr),
-                        (request->paddr >> slaveInterfaces[0]->getPageSize()),
+                        slaveInterfaces[0]->getPage(request->paddr),
                         -1,
                         request->cmd,
                         "Send");
@@ -695,7 +744,7 @@ void Bus::latencyCalculated(MemReqPtr &req, Tick time, bool fromShadow)
     assert(slaveInterfaces.size() == 1);
     writeTraceFileLine(req->paddr,
                        slaveInterfaces[0]->getMemoryBankID(req->paddr),
-                       (req->paddr >> slaveInterfaces[0]->getPageSize()),
+                       slaveInterfaces[0]->getPage(req->paddr),
                        time - curTick,
                        req->cmd,
                        "Latency");
@@ -782,8 +831,6 @@ void Bus::latencyCalculated(MemReqPtr &req, Tick time, bool fromShadow)
 
         assert(req->entryReadCnt <= memoryController->getReadQueueLength());
         assert(req->entryWriteCnt <= memoryController->getWriteQueueLength());
-        queueDelaySum[req->adaptiveMHASenderID][req->entryReadCnt][req->entryWriteCnt] += queueLatency;
-        queueDelayRequests[req->adaptiveMHASenderID][req->entryReadCnt][req->entryWriteCnt]++;
 
 #ifdef TRACE_QUEUE
 
@@ -815,6 +862,11 @@ void Bus::latencyCalculated(MemReqPtr &req, Tick time, bool fromShadow)
             }
         }
 
+        if(trafficGenerator != NULL && trafficGenerator->isReplaying()){
+            trafficGenerator->replayCompleted(req, time);
+            return;
+        }
+
         assert(req->busId < interfaces.size() && req->busId > -1);
         DeliverEvent *deliverevent = new DeliverEvent(interfaces[req->busId], req);
         deliverevent->schedule(time);
@@ -822,6 +874,10 @@ void Bus::latencyCalculated(MemReqPtr &req, Tick time, bool fromShadow)
     else if(req->cmd == Writeback && adaptiveMHA != NULL && req->adaptiveMHASenderID != -1){
         adaptiveMHA->addTotalDelay(req->adaptiveMHASenderID, time - req->writebackGeneratedAt, req->paddr, false);
     }
+
+    if(req->cmd == Writeback && trafficGenerator != NULL && trafficGenerator->isReplaying()){
+        trafficGenerator->replayCompleted(req, time);
+    }
 }
 
 void
@@ -832,11 +888,13 @@ WritebackCompleteEvent::process(){
 
 void
 Bus::addBusQueueInterference(Tick interference, MemReqPtr& req){
+    if(interferenceManager == NULL) return;
     interferenceManager->addInterference(InterferenceManager::MemoryBusQueue, req, interference);
 }
 
 void
 Bus::addBusServiceInterference(Tick interference, MemReqPtr& req){
+    if(interferenceManager == NULL) return;
     interferenceManager->addInterference(InterferenceManager::MemoryBusService, req, interference);
 }
 
@@ -1083,6 +1141,7 @@ void
 Bus::sendGeneratedRequest(MemReqPtr& req){
     DPRINTF(Bus, "Inserting generated request for addr %d\n", req->paddr);
 	memoryController->insertRequest(req);
+	updateQueueOccupancy();
 
 	if (!memoryControllerEvent->scheduled()) {
 		memoryControllerEvent->schedule(curTick);
@@ -1248,20 +1307,15 @@ AddrArbiterEvent::process()
         arbitrationLoopCounter = 0;
         bus->arbitrateAddrBus(interfaceid, this->original_time);
         if (!bus->arb_events.empty()) {
-            if (bus->need_to_sort) {
-                bus->arb_events.sort(event_compare());
-                bus->need_to_sort = false;
-            }
-
             // Find next arb event and schedule it.
-            AddrArbiterEvent *tmp = bus->arb_events.front();
+            AddrArbiterEvent *tmp = bus->arb_events.top();
             if (curTick > tmp->original_time) {
                 tmp->schedule(curTick);
             } else {
                 assert(tmp->original_time >= curTick);
                 tmp->schedule(tmp->original_time);
             }
-            bus->arb_events.pop_front();
+            bus->arb_events.pop();
             bus->currently_scheduled = tmp;
         } else {
             bus->arbiter_scheduled_flag = false;
@@ -1476,10 +1530,13 @@ MemoryBusTraceData::writeTraceLine(){
 		data.push_back( (double) shWbPerCPUData[i] / ticksSinceLast);
 	}
 
-	data.push_back( (double) queuedReadAcc / ticksSinceLast);
-	data.push_back( (double) queuedWriteAcc / ticksSinceLast);
-	data.push_back( (double) noIdleQueuedReadAcc / (double) notIdleTicks);
-	data.push_back( (double) noIdleQueuedWriteAcc / (double) notIdleTicks);
+	// the read and write queues are empty when no requests are queued,
+	// so their areas only cover ticks where the controller is not idle
+	double notIdleTicks = (double) queuedRequests.getBusyTicks();
+	data.push_back( queuedReads.average());
+	data.push_back( queuedWrites.average());
+	data.push_back( notIdleTicks == 0 ? 0 : (double) queuedReads.getArea() / notIdleTicks);
+	data.push_back( notIdleTicks == 0 ? 0 : (double) queuedWrites.getArea() / notIdleTicks);
 
 	bandwidthTrace.addTrace(data);
 
@@ -1487,15 +1544,10 @@ MemoryBusTraceData::writeTraceLine(){
 }
 
 void
-MemoryBusTraceData::addQueueSizeStats(int reads, int writes){
-	queuedReadAcc += reads;
-	queuedWriteAcc += writes;
-
-	if(reads > 0 || writes > 0){
-		notIdleTicks++;
-		noIdleQueuedReadAcc += reads;
-		noIdleQueuedWriteAcc += writes;
-	}
+MemoryBusTraceData::setQueueSize(int reads, int writes){
+	queuedReads.set(reads);
+	queuedWrites.set(writes);
+	queuedRequests.set(reads + writes);
 }
 
 void
@@ -1510,12 +1562,9 @@ MemoryBusTraceData::reset(){
 	privWbPerCPUData = vector<int>(np, 0);
 	shWbPerCPUData = vector<int>(np, 0);
 
-	queuedReadAcc = 0;
-	queuedWriteAcc = 0;
-
-	noIdleQueuedWriteAcc = 0;
-	noIdleQueuedReadAcc = 0;
-	notIdleTicks = 0;
+	queuedReads.reset();
+	queuedWrites.reset();
+	queuedRequests.reset();
 
 	totalCycles = 0;
 	runLast = curTick;
@@ -1538,6 +1587,7 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(Bus)
     SimObjectParam<InterferenceManager* > interference_manager;
     Param<double> utilization_limit;
     SimObjectParam<BasePolicy* > policy;
+    Param<string> arrival_trace;
 END_DECLARE_SIM_OBJECT_PARAMS(Bus)
 
 
@@ -1557,7 +1607,8 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(Bus)
     INIT_PARAM_DFLT(infinite_bw, "Infinite bandwidth and only page hits", false),
     INIT_PARAM_DFLT(interference_manager, "Interference manager", NULL),
     INIT_PARAM_DFLT(utilization_limit, "Data bus utilization limit (single core only)", 0.0),
-    INIT_PARAM_DFLT(policy, "The policy object", NULL)
+    INIT_PARAM_DFLT(policy, "The policy object", NULL),
+    INIT_PARAM_DFLT(arrival_trace, "File to record the memory controller request stream in", "")
 
 END_INIT_SIM_OBJECT_PARAMS(Bus)
 
@@ -1577,7 +1628,8 @@ CREATE_SIM_OBJECT(Bus)
                    infinite_bw,
                    interference_manager,
                    utilization_limit,
-                   policy);
+                   policy,
+                   arrival_trace);
 }
 
 REGISTER_SIM_OBJECT("Bus", Bus)
@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <list>
+#include <queue>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -47,6 +48,7 @@
 #include "mem/base_hier.hh"
 #include "base/statistics.hh"
 #include "base/range.hh"
+#include "base/occupancy.hh"
 #include "sim/eventq.hh"
 
 #include "mem/cache/miss/adaptive_mha.hh"
@@ -59,6 +61,7 @@
 #include "mem/timing/simple_mem_bank.hh"
 
 #include "mem/bus/slave_interface.hh"
+#include "mem/bus/request_stream.hh"
 #include "mem/bus/controller/traffic_generator.hh"
 
 #include "mem/requesttrace.hh"
@@ -76,6 +79,14 @@ class DeliverEvent;
 class MemoryControllerEvent;
 class MemoryBusTraceData;
 
+/** Orders address arbitration events for the arbitration heap */
+class ArbiterEventLater
+{
+  public:
+    bool operator()(const AddrArbiterEvent *l,
+                    const AddrArbiterEvent *r) const;
+};
+
 template <class BusType> class BusInterface;
 class AdaptiveMHA;
 class TimingMemoryController;
@@ -112,9 +123,6 @@ class Bus : public BaseHier
 
     bool infiniteBW;
 
-    std::vector<std::vector<std::vector<Tick> > > queueDelaySum;
-    std::vector<std::vector<std::vector<int> > > queueDelayRequests;
-
     Tick lastSampleTick;
     int serviceCyclesSample;
     int requestSample;
@@ -127,6 +135,9 @@ class Bus : public BaseHier
 
     TrafficGenerator* trafficGenerator;
 
+    /** Records the requests entering the memory controller, if set */
+    RequestStreamWriter* arrivalTrace;
+
     bool doRequestQueueTrace;
     RequestTrace queueSizeTrace;
 
@@ -152,14 +163,23 @@ class Bus : public BaseHier
 
     int livearbs;
 
-    std::list<AddrArbiterEvent*> arb_events;
+    /**
+     * Pending arbitration requests that are not scheduled, ordered by
+     * requested tick and then by the order they were queued in.
+     */
+    std::priority_queue<AddrArbiterEvent*,
+                        std::vector<AddrArbiterEvent*>,
+                        ArbiterEventLater> arb_events;
 
-    bool arbiter_scheduled_flag;
+    /** Sequence number for the next queued arbitration request */
+    uint64_t arbSequence;
 
-    bool need_to_sort;
+    bool arbiter_scheduled_flag;
 
     AddrArbiterEvent* currently_scheduled;
 
+    void queueArbiterEvent(AddrArbiterEvent *event);
+
     TimingMemoryController *memoryController;
 
     AdaptiveMHA* adaptiveMHA;
@@ -196,6 +216,7 @@ class Bus : public BaseHier
     Stats::Scalar<> nullGrants;
 
     Stats::Distribution<> queueSizeDistribution;
+    TimeWeightedOccupancy queueOccupancy;
 
     Stats::Distribution<> numWaitRequestDist;
 
@@ -220,7 +241,8 @@ class Bus : public BaseHier
         bool _infiniteBW,
         InterferenceManager* intman,
         double _utilizationLimit,
-        BasePolicy* _policy);
+        BasePolicy* _policy,
+        std::string _arrivalTrace);
 
     /** Frees locally allocated memory. */
     ~Bus();
@@ -364,7 +386,9 @@ class Bus : public BaseHier
 
     void viritualPrivateWriteAccess(MemReqPtr& req);
 
-    void addQueueLengthSample();
+    void updateQueueOccupancy();
+    void sampleQueueSize(int queued, Tick held);
+    void closeQueueInterval();
 
     std::vector<double> getActualUtilization();
     std::vector<int> getPerCoreBusAccesses();
@@ -539,6 +563,9 @@ class AddrArbiterEvent : public Event
 
     Tick original_time;
 
+    /** Queueing order, breaks ties between equal request times */
+    uint64_t sequence;
+
     int arbitrationLoopCounter;
 
   public:
@@ -549,17 +576,9 @@ class AddrArbiterEvent : public Event
         interfaceid = _interfaceid;
         original_time = _originaltime;
         arbitrationLoopCounter = 0;
+        sequence = 0;
     }
 
-    class event_compare :
-    public std::binary_function<AddrArbiterEvent *, AddrArbiterEvent*, bool>
-    {
-      public:
-       bool operator()(const AddrArbiterEvent *l, const AddrArbiterEvent *r) const {
-         return (l->original_time < r->original_time);
-       }
-    };
-
 
     /** Calls Bus::arbiterAddr(). */
     void process();
@@ -571,6 +590,15 @@ class AddrArbiterEvent : public Event
     virtual const char *description();
 };
 
+inline bool
+ArbiterEventLater::operator()(const AddrArbiterEvent *l,
+                              const AddrArbiterEvent *r) const
+{
+    if (l->original_time != r->original_time)
+        return l->original_time > r->original_time;
+    return l->sequence > r->sequence;
+}
+
 /**
  * Simple Event to schedule the data arbiter.
  */
@@ -712,34 +740,6 @@ class MemoryControllerSwitchEvent : public Event
     }
 };
 
-class MemoryBusQueuedReqEvent : public Event
-{
-    Bus *bus;
-
-    public:
-    // constructor
-    /** A simple constructor. */
-    MemoryBusQueuedReqEvent(Bus *_bus)
-        : Event(&mainEventQueue), bus(_bus)
-    {
-    }
-
-    // event execution function
-    /** Calls BusInterface::deliver() */
-    void process(){
-        bus->addQueueLengthSample();
-        schedule(curTick+1);
-    }
-
-    /**
-    * Returns the string description of this event.
-    * @return The description of this event.
-     */
-    virtual const char *description(){
-        return "Memory Controller Queued Requests Event";
-    }
-};
-
 class MemoryBusBandwidthTraceEvent : public Event
 {
     Bus *bus;
@@ -777,12 +777,9 @@ private:
 	std::vector<int> privWbPerCPUData;
 	std::vector<int> shWbPerCPUData;
 
-	int queuedWriteAcc;
-	int queuedReadAcc;
-
-	int noIdleQueuedWriteAcc;
-	int noIdleQueuedReadAcc;
-	Tick notIdleTicks;
+	TimeWeightedOccupancy queuedReads;
+	TimeWeightedOccupancy queuedWrites;
+	TimeWeightedOccupancy queuedRequests;
 
     RequestTrace bandwidthTrace;
 
@@ -795,7 +792,7 @@ public:
 
 	void writeTraceLine();
 
-	void addQueueSizeStats(int reads, int writes);
+	void setQueueSize(int reads, int writes);
 };
 
 #endif // __BUS_HH__
@@ -116,20 +116,20 @@ TimingMemoryController::setPrewriteUnBlocked()
 Addr
 TimingMemoryController::getPage(MemReqPtr &req)
 {
-    return (req->paddr >> mem_interface->getPageSize());
+    return mem_interface->getPage(req->paddr);
 }
 
 Addr
 TimingMemoryController::getPage(Addr addr)
 {
-    return (addr >> mem_interface->getPageSize());
+    return mem_interface->getPage(addr);
 }
 
 
 Addr
 TimingMemoryController::getPageAddr(Addr addr)
 {
-    return (addr << mem_interface->getPageSize());
+    return mem_interface->getPageAddr(addr);
 }
 
 void
@@ -348,7 +348,7 @@ MemReqPtr RDFCFSTimingMemoryController::getRequest() {
     if((retval->cmd == Read || retval->cmd == Writeback) && !isShadow){
         assert(!isShadow);
 
-        if(retval->adaptiveMHASenderID == highPriCPUID && currentOccupyingCPUID != highPriCPUID && retval->cmd == Read){
+        if(retval->adaptiveMHASenderID == highPriCPUID && currentOccupyingCPUID != highPriCPUID && retval->cmd == Read && bus->interferenceManager != NULL){
         	assert(curTick >= retval->inserted_into_memory_controller);
         	bus->interferenceManager->asrEpocMeasurements.addValue(highPriCPUID,
         			ASREpochMeasurements::EPOCH_QUEUEING_CYCLES,
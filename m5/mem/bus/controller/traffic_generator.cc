@@ -6,12 +6,15 @@
  */
 
 #include "traffic_generator.hh"
+#include "sim/sim_events.hh"
 
 using namespace std;
 
 TrafficGenerator::TrafficGenerator(string _name,
 		                           Bus* _membus,
-		                           int _useID)
+		                           int _useID,
+		                           string _replayTrace,
+		                           int _replayMLP)
 : SimObject(_name){
 
 	membus = _membus;
@@ -19,6 +22,24 @@ TrafficGenerator::TrafficGenerator(string _name,
 
 	membus->registerTrafficGenerator(this);
 
+	replayReader = NULL;
+	replayMLP = _replayMLP;
+	replayBlocked = false;
+	replayOutstanding = 0;
+
+	if(_replayTrace != ""){
+		replayReader = new RequestStreamReader(_replayTrace);
+		replayOutstandingReads.resize(membus->getCPUCount(), 0);
+
+		replayHasNext = replayReader->next(replayNext);
+		if(!replayHasNext) fatal("Request stream %s is empty", _replayTrace);
+
+		// The first recorded request arrives in the next cycle
+		replayOffset = (curTick + 1) - (Tick) replayNext.arrival;
+		scheduleNextReplay();
+		return;
+	}
+
 	concurrentRequestLoad = 4;
 
 	for(int i=0;i<concurrentRequestLoad;i++){
@@ -28,8 +49,33 @@ TrafficGenerator::TrafficGenerator(string _name,
 	nextRequestAddr = membus->relocateAddrForCPU(useID, 0, membus->getCPUCount()+1);
 }
 
+TrafficGenerator::~TrafficGenerator(){
+	if(replayReader != NULL) delete replayReader;
+}
+
+void
+TrafficGenerator::regStats(){
+	using namespace Stats;
+
+	replayedRequests
+		.name(name() + ".replayed_requests")
+		.desc("Number of requests replayed from the request stream")
+		;
+
+	replayStallCycles
+		.name(name() + ".replay_stall_cycles")
+		.desc("Cycles the replayed stream was held back by the MLP limit")
+		;
+}
+
 void
 TrafficGenerator::sendGeneratedRequest(){
+
+	if(isReplaying()){
+		replayRequests();
+		return;
+	}
+
 	MemReqPtr req = new MemReq();
 
 	req->cmd = Read;
@@ -48,17 +94,99 @@ TrafficGenerator::requestCompleted(Tick willCompleteAt){
 	genEvent->schedule(willCompleteAt);
 }
 
+void
+TrafficGenerator::replayRequests(){
+	while(replayHasNext && replayArrival() <= curTick){
+		bool isRead = !replayNext.isWrite;
+		int cpuID = replayNext.cpuID;
+
+		if(replayMLP > 0 && isRead && cpuID >= 0 && replayOutstandingReads[cpuID] >= replayMLP){
+			DPRINTF(Bus, "Replay of addr %d blocked, CPU %d has %d reads in flight\n",
+					replayNext.paddr, cpuID, replayOutstandingReads[cpuID]);
+			replayBlocked = true;
+			return;
+		}
+
+		if(cpuID >= (int) replayOutstandingReads.size()){
+			fatal("Replayed request from CPU %d, but the bus only has %d CPUs",
+				  cpuID, replayOutstandingReads.size());
+		}
+
+		MemReqPtr req = new MemReq();
+		req->cmd = isRead ? Read : Writeback;
+		req->paddr = replayNext.paddr;
+		req->adaptiveMHASenderID = cpuID;
+		req->finishedInCacheAt = curTick;
+
+		replayOutstanding++;
+		if(isRead && cpuID >= 0) replayOutstandingReads[cpuID]++;
+		replayedRequests++;
+
+		membus->sendAddr(req, curTick);
+
+		replayHasNext = replayReader->next(replayNext);
+	}
+
+	scheduleNextReplay();
+}
+
+void
+TrafficGenerator::scheduleNextReplay(){
+	if(replayHasNext){
+		TrafficGeneratorRequestEvent* genEvent = new TrafficGeneratorRequestEvent(this);
+		genEvent->schedule(replayArrival());
+	}
+	else if(replayOutstanding == 0){
+		new SimExitEvent("request stream replay finished");
+	}
+}
+
+void
+TrafficGenerator::replayCompleted(MemReqPtr& req, Tick willCompleteAt){
+	assert(willCompleteAt >= curTick);
+	TrafficGeneratorReplayCompletionEvent* event =
+		new TrafficGeneratorReplayCompletionEvent(this, req->adaptiveMHASenderID, req->cmd == Read);
+	event->schedule(willCompleteAt);
+}
+
+void
+TrafficGenerator::replayRetired(int cpuID, bool isRead){
+	replayOutstanding--;
+	if(isRead && cpuID >= 0) replayOutstandingReads[cpuID]--;
+	assert(replayOutstanding >= 0);
+
+	if(replayBlocked){
+		if(isRead && cpuID == replayNext.cpuID){
+			// Delay the rest of the stream by the time the blocked read waited
+			Tick stall = curTick - replayArrival();
+			replayStallCycles += stall;
+			replayOffset += stall;
+			replayBlocked = false;
+			replayRequests();
+		}
+		return;
+	}
+
+	if(!replayHasNext && replayOutstanding == 0){
+		new SimExitEvent("request stream replay finished");
+	}
+}
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 BEGIN_DECLARE_SIM_OBJECT_PARAMS(TrafficGenerator)
     SimObjectParam<Bus* > membus;
     Param<int> use_id;
+    Param<string> replay_trace;
+    Param<int> replay_mlp;
 END_DECLARE_SIM_OBJECT_PARAMS(TrafficGenerator)
 
 
 BEGIN_INIT_SIM_OBJECT_PARAMS(TrafficGenerator)
     INIT_PARAM(membus, "The memory bus to inject traffic into"),
-    INIT_PARAM(use_id, "CPU ID for use when inserting requests")
+    INIT_PARAM(use_id, "CPU ID for use when inserting requests"),
+    INIT_PARAM_DFLT(replay_trace, "Request stream to replay instead of generating traffic", ""),
+    INIT_PARAM_DFLT(replay_mlp, "Maximum reads in flight per CPU during replay, 0 is open loop", 0)
 END_INIT_SIM_OBJECT_PARAMS(TrafficGenerator)
 
 
@@ -66,7 +194,9 @@ CREATE_SIM_OBJECT(TrafficGenerator)
 {
     return new TrafficGenerator(getInstanceName(),
                                 membus,
-                                use_id);
+                                use_id,
+                                replay_trace,
+                                replay_mlp);
 }
 
 REGISTER_SIM_OBJECT("TrafficGenerator", TrafficGenerator)
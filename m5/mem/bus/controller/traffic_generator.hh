@@ -6,16 +6,30 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "sim/sim_object.hh"
 #include "sim/builder.hh"
 #include "mem/bus/bus.hh"
+#include "mem/bus/request_stream.hh"
 #include "mem/mem_req.hh"
 #include "sim/eventq.hh"
 
 #ifndef TRAFFIC_GENERATOR_HH_
 #define TRAFFIC_GENERATOR_HH_
 
+/**
+ * Injects requests directly into the memory controller of a bus.
+ *
+ * By default, a fixed number of sequential reads is kept in flight as
+ * background traffic. If a request stream is given, the generator
+ * instead replays the stream recorded by a bus (see Bus arrival_trace),
+ * so that memory controllers and interference estimators can be
+ * evaluated without CPUs and caches. Replay is open loop by default:
+ * every request arrives at its recorded time. With a replay MLP limit,
+ * a read is held back while its CPU already has that many reads in
+ * flight, and the rest of the stream is delayed accordingly.
+ */
 class TrafficGenerator : public SimObject{
 
 private:
@@ -25,15 +39,48 @@ private:
 
 	Addr nextRequestAddr;
 
+	RequestStreamReader* replayReader;
+	int replayMLP;
+	bool replayHasNext;
+	RequestStreamRecord replayNext;
+	Tick replayOffset;
+	bool replayBlocked;
+	std::vector<int> replayOutstandingReads;
+	int replayOutstanding;
+
+	Stats::Scalar<> replayedRequests;
+	Stats::Scalar<> replayStallCycles;
+
+	Tick replayArrival(){
+		return replayNext.arrival + replayOffset;
+	}
+
+	void replayRequests();
+	void scheduleNextReplay();
+
 public:
 
 	TrafficGenerator(std::string _name,
 			         Bus* _membus,
-			         int _useID);
+			         int _useID,
+			         std::string _replayTrace,
+			         int _replayMLP);
+
+	~TrafficGenerator();
+
+	void regStats();
 
 	void sendGeneratedRequest();
 
 	void requestCompleted(Tick willCompleteAt);
+
+	bool isReplaying(){
+		return replayReader != NULL;
+	}
+
+	void replayCompleted(MemReqPtr& req, Tick willCompleteAt);
+
+	void replayRetired(int cpuID, bool isRead);
 };
 
 class TrafficGeneratorRequestEvent : public Event
@@ -54,4 +101,24 @@ public:
 	}
 };
 
+class TrafficGeneratorReplayCompletionEvent : public Event
+{
+	TrafficGenerator* gen;
+	int cpuID;
+	bool isRead;
+
+public:
+	TrafficGeneratorReplayCompletionEvent(TrafficGenerator* _gen, int _cpuID, bool _isRead)
+	: Event(&mainEventQueue), gen(_gen), cpuID(_cpuID), isRead(_isRead) { }
+
+	void process(){
+		gen->replayRetired(cpuID, isRead);
+		delete this;
+	}
+
+	virtual const char *description(){
+		return "Traffic Generator Replay Completion Event";
+	}
+};
+
 #endif /* TRAFFIC_GENERATOR_HH_ */
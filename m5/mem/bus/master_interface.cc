@@ -66,6 +66,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/miss/blocking_buffer.hh"
 #include "mem/cache/miss/miss_queue.hh"
@@ -104,6 +107,12 @@ template class MasterInterface<Cache<CacheTags<IIC,LZSSCompression>, BlockingBuf
 template class MasterInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, SimpleCoherence>, Bus>;
 template class MasterInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, UniCoherence>, Bus>;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class MasterInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, SimpleCoherence>, Bus>;
+template class MasterInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, UniCoherence>, Bus>;
+template class MasterInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, SimpleCoherence>, Bus>;
+template class MasterInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, UniCoherence>, Bus>;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
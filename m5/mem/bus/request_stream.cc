@@ -0,0 +1,95 @@
+/*
+ * request_stream.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <cstring>
+
+#include "base/misc.hh"
+#include "mem/bus/request_stream.hh"
+
+using namespace std;
+
+static const char streamMagic[8] = {'M', '5', 'R', 'E', 'Q', 'S', 'T', 'R'};
+static const uint32_t streamVersion = 1;
+static const unsigned readBlockSize = 4096;
+
+RequestStreamWriter::RequestStreamWriter(const string &_filename)
+    : filename(_filename)
+{
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL)
+        fatal("Could not open request stream %s for writing", filename);
+
+    uint32_t version = streamVersion;
+    uint32_t recordSize = sizeof(RequestStreamRecord);
+    if (fwrite(streamMagic, sizeof(streamMagic), 1, file) != 1
+        || fwrite(&version, sizeof(version), 1, file) != 1
+        || fwrite(&recordSize, sizeof(recordSize), 1, file) != 1) {
+        fatal("Could not write the header of request stream %s", filename);
+    }
+}
+
+RequestStreamWriter::~RequestStreamWriter()
+{
+    fclose(file);
+}
+
+void
+RequestStreamWriter::write(MemReqPtr &req, Tick arrival)
+{
+    RequestStreamRecord record;
+    memset(&record, 0, sizeof(record));
+    record.arrival = arrival;
+    record.paddr = req->paddr;
+    record.cpuID = req->adaptiveMHASenderID;
+    record.isWrite = req->cmd == Writeback;
+
+    if (fwrite(&record, sizeof(record), 1, file) != 1)
+        fatal("Could not write to request stream %s", filename);
+}
+
+RequestStreamReader::RequestStreamReader(const string &_filename)
+    : filename(_filename), buffer(readBlockSize), bufferPos(0), bufferFill(0)
+{
+    file = fopen(filename.c_str(), "rb");
+    if (file == NULL)
+        fatal("Could not open request stream %s", filename);
+
+    char magic[sizeof(streamMagic)];
+    uint32_t version;
+    uint32_t recordSize;
+    if (fread(magic, sizeof(magic), 1, file) != 1
+        || fread(&version, sizeof(version), 1, file) != 1
+        || fread(&recordSize, sizeof(recordSize), 1, file) != 1
+        || memcmp(magic, streamMagic, sizeof(magic)) != 0) {
+        fatal("%s is not a request stream", filename);
+    }
+
+    if (version != streamVersion || recordSize != sizeof(RequestStreamRecord))
+        fatal("Request stream %s has version %d and record size %d, "
+              "expected %d and %d", filename, version, recordSize,
+              streamVersion, sizeof(RequestStreamRecord));
+}
+
+RequestStreamReader::~RequestStreamReader()
+{
+    fclose(file);
+}
+
+bool
+RequestStreamReader::next(RequestStreamRecord &record)
+{
+    if (bufferPos == bufferFill) {
+        bufferFill = fread(&buffer[0], sizeof(RequestStreamRecord),
+                           buffer.size(), file);
+        bufferPos = 0;
+        if (bufferFill == 0)
+            return false;
+    }
+
+    record = buffer[bufferPos++];
+    return true;
+}
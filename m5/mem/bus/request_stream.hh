@@ -0,0 +1,71 @@
+/*
+ * request_stream.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef REQUEST_STREAM_HH_
+#define REQUEST_STREAM_HH_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mem/mem_req.hh"
+#include "sim/host.hh"
+
+/**
+ * One memory bus request as seen when it enters the memory controller.
+ * The layout is fixed so that streams can be moved between hosts with
+ * the same byte order.
+ */
+struct RequestStreamRecord
+{
+    uint64_t arrival;
+    uint64_t paddr;
+    int32_t cpuID;
+    int32_t isWrite;
+};
+
+/**
+ * Writes the request arrival stream of a memory bus to a binary file.
+ * The file starts with a magic string, a version and the record size,
+ * followed by fixed size records in arrival order.
+ */
+class RequestStreamWriter
+{
+  private:
+    FILE *file;
+    std::string filename;
+
+  public:
+    RequestStreamWriter(const std::string &_filename);
+    ~RequestStreamWriter();
+
+    void write(MemReqPtr &req, Tick arrival);
+};
+
+/**
+ * Reads a stream written by RequestStreamWriter. Records are read in
+ * blocks to keep the per-request cost low.
+ */
+class RequestStreamReader
+{
+  private:
+    FILE *file;
+    std::string filename;
+
+    std::vector<RequestStreamRecord> buffer;
+    unsigned bufferPos;
+    unsigned bufferFill;
+
+  public:
+    RequestStreamReader(const std::string &_filename);
+    ~RequestStreamReader();
+
+    /** @return false when the stream is exhausted. */
+    bool next(RequestStreamRecord &record);
+};
+
+#endif /* REQUEST_STREAM_HH_ */
@@ -39,6 +39,7 @@
 
 // Memories
 #include "mem/timing/simple_mem_bank.hh"
+#include "mem/timing/ddr_mem_bank.hh"
 #include "mem/cache/cache.hh"
 
 #include "mem/cache/tags/cache_tags.hh"
@@ -67,6 +68,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/miss/miss_queue.hh"
 #include "mem/cache/miss/blocking_buffer.hh"
@@ -85,6 +89,7 @@ template class SlaveInterface<SimpleMemBank<NullCompression>, Bus>;
 #if defined(USE_LZSS_COMPRESSION)
 template class SlaveInterface<SimpleMemBank<LZSSCompression>, Bus>;
 #endif
+template class SlaveInterface<DDRMemBank, Bus>;
 
 #if defined(USE_CACHE_FALRU)
 template class SlaveInterface<Cache<CacheTags<FALRU,NullCompression>, BlockingBuffer, SimpleCoherence>, Bus>;
@@ -110,6 +115,12 @@ template class SlaveInterface<Cache<CacheTags<IIC,LZSSCompression>, BlockingBuff
 template class SlaveInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, SimpleCoherence>, Bus>;
 template class SlaveInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, UniCoherence>, Bus>;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class SlaveInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, SimpleCoherence>, Bus>;
+template class SlaveInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, UniCoherence>, Bus>;
+template class SlaveInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, SimpleCoherence>, Bus>;
+template class SlaveInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, UniCoherence>, Bus>;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
@@ -156,6 +156,8 @@ class SlaveInterface : public BusInterface<BusType>
     virtual bool isReady(MemReqPtr &req);
     virtual int getPageSize();
     virtual int getMemoryBankID(Addr addr);
+    virtual Addr getPage(Addr addr);
+    virtual Addr getPageAddr(Addr page);
     virtual int getMemoryBankCount();
     virtual Tick getBankActivatedAt(int bankID);
 
@@ -195,6 +195,18 @@ SlaveInterface<Mem, Bus>::getMemoryBankID(Addr addr){
     return mem->getMemoryBankID(addr);
 }
 
+template<class Mem, class Bus>
+Addr
+SlaveInterface<Mem, Bus>::getPage(Addr addr){
+    return mem->getPage(addr);
+}
+
+template<class Mem, class Bus>
+Addr
+SlaveInterface<Mem, Bus>::getPageAddr(Addr page){
+    return mem->getPageAddr(page);
+}
+
 template<class Mem, class Bus>
 int
 SlaveInterface<Mem, Bus>::getMemoryBankCount(){
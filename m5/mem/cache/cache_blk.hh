@@ -40,6 +40,7 @@
 #include "targetarch/isa_traits.hh"	// for Addr
 #include "cpu/exec_context.hh"
 #include "sim/serialize.hh"
+#include "mem/cache/coherence/sharer_set.hh"
 
 /**
  * Cache block status bit assignments
@@ -100,7 +101,7 @@ public:
 	/** Directory protocol state */
 	DirectoryState dirState;
 	int owner;
-	bool* presentFlags;
+	SharerSet* presentFlags;
 
 	/** Shared cache owner info */
 	int origRequestingCpuID;
@@ -222,10 +223,8 @@ public:
 	}
 
 	void initPresentFlags(int cpu_count){
-		presentFlags = new bool[cpu_count];
-		for(int i=0;i<cpu_count;i++){
-			presentFlags[i] = false;
-		}
+		assert(cpu_count <= SharerSet::MaxSharers);
+		presentFlags = new SharerSet;
 	}
 
 	void serialize(std::ofstream &outfile){
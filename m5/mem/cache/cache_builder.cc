@@ -74,6 +74,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 // CacheTags Templates
 #include "mem/cache/tags/cache_tags.hh"
@@ -170,6 +173,7 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(BaseCache)
     Param<bool> compressed_bus;
     Param<bool> store_compressed;
     Param<bool> adaptive_compression;
+    Param<string> compression;
     Param<int> compression_latency;
     Param<int> subblock_size;
     Param<Counter> max_miss_count;
@@ -275,6 +279,8 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(BaseCache)
 		    false),
     INIT_PARAM_DFLT(adaptive_compression, "Use an adaptive compression scheme",
 		    false),
+    INIT_PARAM_DFLT(compression, "Compression algorithm for compressed IIC caches "
+                    "(lzss or bdi)", "lzss"),
     INIT_PARAM_DFLT(compression_latency,
 		    "Latency in cycles of compression algorithm",
 		    0),
@@ -360,7 +366,9 @@ END_INIT_SIM_OBJECT_PARAMS(BaseCache)
                                                                             "stenstrom",\
                                                                             dirProtocolDoTrace,\
                                                                             dirProtocolDumpInterval,\
-                                                                            dirProtocolTraceStart);\
+                                                                            dirProtocolTraceStart,\
+                                                                            numSets,\
+                                                                            assoc);\
         }\
         else{\
             directory_protocol = NULL;\
@@ -468,7 +476,7 @@ END_INIT_SIM_OBJECT_PARAMS(BaseCache)
 
 #if defined(USE_CACHE_LRU)
 #define BUILD_LRU_CACHE(b, c) do {				\
-        LRU *tags = new LRU(numSets, block_size, assoc, latency, bank_count, false, static_partitioning_div_factor, max_use_ways);	\
+        LRU *tags = new LRU(numSets, block_size, assoc, latency, bank_count, false, static_partitioning_div_factor, max_use_ways, -1, hier->doData);	\
 	BUILD_COMPRESSED_CACHE(LRU, tags, b, c);			\
     } while (0)
 #else
@@ -495,7 +503,22 @@ END_INIT_SIM_OBJECT_PARAMS(BaseCache)
 #define BUILD_SPLIT_LIFO_CACHE(b, c) BUILD_CACHE_PANIC("lifo cache")
 #endif
 
-#if defined(USE_CACHE_IIC)
+#if defined(USE_CACHE_IIC) && defined(USE_BDI_COMPRESSION)
+#define BUILD_IIC_CACHE(b ,c) do {			\
+	IIC *tags = new IIC(iic_params);		\
+	if ((compressed_bus || store_compressed) &&	\
+	    comp_name == "bdi") {			\
+	    CacheTags<IIC, BDICompression> *tagStore =	\
+		new CacheTags<IIC, BDICompression>(tags,	\
+						   compression_latency, \
+						   true, store_compressed, \
+						   adaptive_compression,   \
+                                                   prefetch_miss); \
+	    BUILD_CACHE(IIC, BDICompression, b, c);	\
+	}						\
+	BUILD_COMPRESSED_CACHE(IIC, tags, b, c);	\
+    } while (0)
+#elif defined(USE_CACHE_IIC)
 #define BUILD_IIC_CACHE(b ,c) do {			\
 	IIC *tags = new IIC(iic_params);		\
 	BUILD_COMPRESSED_CACHE(IIC, tags, b, c);	\
@@ -543,6 +566,11 @@ CREATE_SIM_OBJECT(BaseCache)
 	subblock_size = block_size;
     }
 
+    string comp_name = compression;
+    if (comp_name != "lzss" && comp_name != "bdi") {
+	fatal("Unknown compression algorithm %s", comp_name);
+    }
+
     string dir_protocol_name = dirProtocolName;
     if(dir_protocol_name != "none"){
         if(dir_protocol_name != "stenstrom"){
@@ -608,6 +636,11 @@ CREATE_SIM_OBJECT(BaseCache)
     const void *repl = NULL;
 #endif
 
+    if (comp_name == "bdi" && repl == NULL &&
+	(compressed_bus || store_compressed)) {
+	fatal("BDI compression is only available for IIC caches");
+    }
+
     /* FIXME: no events not supported */
     //if (mshrs == 1 || out_bus->doEvents() == false) {
 	//BlockingBuffer *mq = new BlockingBuffer(true);
@@ -275,6 +275,7 @@ Cache<TagStore,Buffering,Coherence>::access(MemReqPtr &req)
 
 	if(isShared){
 		req->beenInSharedMemSys = true;
+		if(interferenceManager != NULL) interferenceManager->addSharedCacheAccess(req);
 	}
 
 	// update hit statistics
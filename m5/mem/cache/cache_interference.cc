@@ -52,7 +52,8 @@ CacheInterference::CacheInterference(std::string _name,
 								true,
 								_divFac,
 								-1, // max use ways
-								i);
+								i,
+								false); // shadow tags never hold data
 		shadowTags[i]->setCacheInterference(this);
 	}
 	leaderSetMap = vector<bool>(totalSetNumber, false);
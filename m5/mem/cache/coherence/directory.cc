@@ -13,7 +13,11 @@ DirectoryProtocol<TagStore>::DirectoryProtocol(const std::string &_cacheName,
                                                const std::string &_protocol,
                                                bool _doTrace,
                                                int _dumpInterval,
-                                               int _traceStart){
+                                               int _traceStart,
+                                               int _numSets,
+                                               int _assoc)
+    : blockStore(CeilLog2(_numSets), _assoc)
+{
             
     protocol = _protocol;
     cacheName = _cacheName;
@@ -95,7 +99,7 @@ DirectoryProtocol<TagStore>::writeTraceLine(const std::string cachename,
                                             const DirectoryState state,
                                             const Addr paddr,
                                             const Addr blkSize,
-                                            bool* presentFlags){
+                                            SharerSet* presentFlags){
     if(doTrace && curTick >= traceStart){
         
         Addr blkAddr = (paddr & ~((Addr)blkSize - 1));
@@ -112,7 +116,7 @@ DirectoryProtocol<TagStore>::writeTraceLine(const std::string cachename,
         if(presentFlags != NULL){
             tracefile << "; [";
             for(int i=0;i<directoryCpuCount;i++){
-                tracefile << (presentFlags[i] ? "1" : "0");
+                tracefile << (presentFlags->test(i) ? "1" : "0");
                 if(i != (directoryCpuCount-1)) tracefile << ",";
             }
             tracefile << "]";
@@ -150,34 +154,26 @@ DirectoryProtocol<TagStore>::dumpStats(){
 template<class TagStore>
 bool
 DirectoryProtocol<TagStore>::isOwned(Addr address){
-    if(blockStore.find(address) == blockStore.end()){
-        return false;
-    }
-    return true;
+    return blockStore.contains(address);
 }
 
 template<class TagStore>
 int
 DirectoryProtocol<TagStore>::getOwner(Addr address){
-    map<Addr, int>::iterator found = blockStore.find(address);
-    if(found != blockStore.end()){
-        return found->second;
-    }
-    return -1;
+    return blockStore.getOwner(address);
 }
 
 template<class TagStore>
 void
 DirectoryProtocol<TagStore>::setOwner(Addr address, int newOwner){
-    blockStore[address] = newOwner;
+    blockStore.setOwner(address, newOwner);
 }
 
 template<class TagStore>
 void
 DirectoryProtocol<TagStore>::removeOwner(Addr address){
-    map<Addr, int>::iterator eraseIt = blockStore.find(address);
-    assert(eraseIt != blockStore.end());
-    blockStore.erase(eraseIt);
+    assert(blockStore.contains(address));
+    blockStore.removeOwner(address);
 }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -214,6 +210,9 @@ DirectoryProtocol<TagStore>::removeOwner(Addr address){
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
                  
 #if defined(USE_CACHE_FALRU)
     template class DirectoryProtocol<CacheTags<FALRU,NullCompression> >;
@@ -227,6 +226,9 @@ DirectoryProtocol<TagStore>::removeOwner(Addr address){
 #if defined(USE_LZSS_COMPRESSION)
     template class DirectoryProtocol<CacheTags<IIC,LZSSCompression> >;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+    template class DirectoryProtocol<CacheTags<IIC,BDICompression> >;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
@@ -7,6 +7,8 @@
 #include "mem/mem_req.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/tags/cache_tags.hh"
+#include "mem/cache/coherence/directory_tables.hh"
+#include "mem/cache/coherence/sharer_set.hh"
         
 #define OUTFILENAME "coherencetrace.txt"
         
@@ -38,7 +40,7 @@ class DirectoryProtocol
         int directoryCpuCount;
         int directoryCpuID;
         
-        std::map<Addr, int> blockStore;
+        SparseDirectory blockStore;
         
         bool doTrace;
         int traceStart;
@@ -78,12 +80,16 @@ class DirectoryProtocol
         *                      profile event
         * @param _traceStart   The clock cycle to start tracing protocol 
         *                      actions
+        * @param _numSets      The number of sets in the associated cache
+        * @param _assoc        The associativity of the associated cache
         */
         DirectoryProtocol(const std::string &_name,
                           const std::string &_protocol,
                           bool _doTrace,
                           int _dumpInterval,
-                          int _traceStart);
+                          int _traceStart,
+                          int _numSets,
+                          int _assoc);
         
         /**
         * Empty destructor.
@@ -111,6 +117,10 @@ class DirectoryProtocol
         *                 protocol.
         */
         void setCpuCount(int num_cpus, int cpuId){
+            if(num_cpus > SharerSet::MaxSharers){
+                fatal("The directory protocol supports at most %d CPUs",
+                      SharerSet::MaxSharers);
+            }
             directoryCpuCount = num_cpus;
             directoryCpuID = cpuId;
         }
@@ -129,8 +139,8 @@ class DirectoryProtocol
         * @param state        The state of the cache block
         * @param paddr        The address of the cache block
         * @param blkSize      The block size of the cache
-        * @param presentFlags A bool array showing which caches have a copy of
-        *                     the cache block
+        * @param presentFlags The set of caches that have a copy of the
+        *                     cache block
         */
         void writeTraceLine(const std::string cachename,
                             const std::string message,
@@ -138,7 +148,7 @@ class DirectoryProtocol
                             const DirectoryState state,
                             const Addr paddr,
                             const Addr blkSize,
-                            bool* presentFlags);
+                            SharerSet* presentFlags);
         
         /**
         * When this method is called, the coherence message profile is written
@@ -0,0 +1,246 @@
+/*
+ * directory_tables.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef DIRECTORY_TABLES_HH_
+#define DIRECTORY_TABLES_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "targetarch/isa_traits.hh"
+
+/**
+* A small hash table for transient directory state, keyed by block
+* address. It uses open addressing with linear probing, so entries
+* live in one array and nothing is allocated per entry. The table
+* doubles in size when it is half full.
+*
+* @author Magnus Jahre
+*/
+template <class V>
+class TransientTable
+{
+    private:
+        struct Slot
+        {
+            Addr address;
+            V value;
+            bool used;
+
+            Slot() : address(0), value(), used(false) {}
+        };
+
+        std::vector<Slot> slots;
+        int bits;
+        int entries;
+
+        int slotOf(Addr address) const {
+            int mask = slots.size() - 1;
+            int pos = HashBits(address, bits);
+            while(slots[pos].used && slots[pos].address != address){
+                pos = (pos + 1) & mask;
+            }
+            return pos;
+        }
+
+        void grow(){
+            std::vector<Slot> old;
+            old.swap(slots);
+            bits++;
+            slots.resize(1 << bits);
+            for(int i=0;i<old.size();i++){
+                if(old[i].used) slots[slotOf(old[i].address)] = old[i];
+            }
+        }
+
+    public:
+        TransientTable() : slots(16), bits(4), entries(0) {}
+
+        bool contains(Addr address) const {
+            return slots[slotOf(address)].used;
+        }
+
+        /** Returns the value for address, inserting a default if needed. */
+        V &operator[](Addr address){
+            int pos = slotOf(address);
+            if(!slots[pos].used){
+                if(2 * (entries + 1) > slots.size()){
+                    grow();
+                    pos = slotOf(address);
+                }
+                slots[pos].used = true;
+                slots[pos].address = address;
+                slots[pos].value = V();
+                entries++;
+            }
+            return slots[pos].value;
+        }
+
+        void erase(Addr address){
+            int mask = slots.size() - 1;
+            int pos = slotOf(address);
+            assert(slots[pos].used);
+            slots[pos] = Slot();
+            entries--;
+
+            // move later entries of the probe sequence into the hole
+            int next = (pos + 1) & mask;
+            while(slots[next].used){
+                int home = HashBits(slots[next].address, bits);
+                bool movable = (pos <= next) ? (home <= pos || home > next)
+                                             : (home <= pos && home > next);
+                if(movable){
+                    slots[pos] = slots[next];
+                    slots[next] = Slot();
+                    pos = next;
+                }
+                next = (next + 1) & mask;
+            }
+        }
+
+        int size() const { return entries; }
+
+        /** @return A pointer to the value for address, or NULL. */
+        const V *find(Addr address) const {
+            const Slot &slot = slots[slotOf(address)];
+            return slot.used ? &slot.value : NULL;
+        }
+
+        void swap(TransientTable &other){
+            slots.swap(other.slots);
+            std::swap(bits, other.bits);
+            std::swap(entries, other.entries);
+        }
+
+        /* Walking the table, slot by slot */
+        int capacity() const { return slots.size(); }
+        bool usedAt(int i) const { return slots[i].used; }
+        Addr addressAt(int i) const { return slots[i].address; }
+        const V &valueAt(int i) const { return slots[i].value; }
+};
+
+/**
+* The set of owned blocks and their owners as a set-associative sparse
+* directory. Tags and owners are kept in flat arrays indexed by set and
+* way. The directory must never lose an owner, so entries that do not
+* fit in their set go to a small overflow table instead of being
+* evicted. The directory starts with the geometry of the cache that owns
+* it, and the number of sets is doubled when the overflow table holds
+* more than an eighth of the directory capacity.
+*
+* @author Magnus Jahre
+*/
+class SparseDirectory
+{
+    private:
+        static Addr invalidTag() { return (Addr) -1; }
+
+        int ways;
+        int setBits;
+        std::vector<Addr> tags;
+        std::vector<int> owners;
+        TransientTable<int> overflow;
+
+        int findWay(Addr address) const {
+            int base = HashBits(address, setBits) * ways;
+            for(int i=0;i<ways;i++){
+                if(tags[base+i] == address) return base + i;
+            }
+            return -1;
+        }
+
+        bool insertInSet(Addr address, int owner){
+            int base = HashBits(address, setBits) * ways;
+            for(int i=0;i<ways;i++){
+                if(tags[base+i] == invalidTag()){
+                    tags[base+i] = address;
+                    owners[base+i] = owner;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void insert(Addr address, int owner){
+            if(!insertInSet(address, owner)) overflow[address] = owner;
+        }
+
+        void grow(){
+            std::vector<Addr> oldTags;
+            std::vector<int> oldOwners;
+            TransientTable<int> oldOverflow;
+            oldTags.swap(tags);
+            oldOwners.swap(owners);
+            oldOverflow.swap(overflow);
+
+            setBits++;
+            tags.resize(ways << setBits, invalidTag());
+            owners.resize(ways << setBits, -1);
+
+            for(int i=0;i<oldTags.size();i++){
+                if(oldTags[i] != invalidTag()) insert(oldTags[i], oldOwners[i]);
+            }
+            for(int i=0;i<oldOverflow.capacity();i++){
+                if(oldOverflow.usedAt(i)){
+                    insert(oldOverflow.addressAt(i), oldOverflow.valueAt(i));
+                }
+            }
+        }
+
+    public:
+        SparseDirectory(int _setBits, int _ways)
+            : ways(_ways), setBits(_setBits),
+              tags(_ways << _setBits, invalidTag()),
+              owners(_ways << _setBits, -1)
+        {
+        }
+
+        bool contains(Addr address) const {
+            return findWay(address) != -1 || overflow.contains(address);
+        }
+
+        /** @return The owner of address, or -1 if it is not owned. */
+        int getOwner(Addr address) const {
+            int pos = findWay(address);
+            if(pos != -1) return owners[pos];
+            const int *owner = overflow.find(address);
+            return owner != NULL ? *owner : -1;
+        }
+
+        void setOwner(Addr address, int owner){
+            assert(address != invalidTag());
+            int pos = findWay(address);
+            if(pos != -1){
+                owners[pos] = owner;
+                return;
+            }
+            if(overflow.contains(address)){
+                overflow[address] = owner;
+                return;
+            }
+
+            insert(address, owner);
+            if(overflow.size() * 8 > (int) tags.size()) grow();
+        }
+
+        void removeOwner(Addr address){
+            int pos = findWay(address);
+            if(pos != -1){
+                tags[pos] = invalidTag();
+                owners[pos] = -1;
+                return;
+            }
+            overflow.erase(address);
+        }
+
+        /** Number of entries that did not fit in their set */
+        int overflowCount() const { return overflow.size(); }
+};
+
+#endif /* DIRECTORY_TABLES_HH_ */
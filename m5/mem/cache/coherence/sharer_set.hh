@@ -0,0 +1,76 @@
+/*
+ * sharer_set.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef SHARER_SET_HH_
+#define SHARER_SET_HH_
+
+#include <cassert>
+
+#include "base/fast_alloc.hh"
+#include "sim/host.hh"
+
+/**
+* The set of caches holding a copy of a block, stored as a bit vector.
+*
+* Directory entries are created and handed between blocks and requests
+* all the time. The bit vector keeps each entry to one word, and
+* FastAlloc recycles the entries without going to the heap.
+*
+* @author Magnus Jahre
+*/
+class SharerSet : public FastAlloc
+{
+    public:
+        /** The largest number of caches a directory entry can track */
+        static const int MaxSharers = 64;
+
+    private:
+        uint64_t bits;
+
+        static uint64_t mask(int cpuID){
+            assert(cpuID >= 0 && cpuID < MaxSharers);
+            return (uint64_t) 1 << cpuID;
+        }
+
+    public:
+        SharerSet() : bits(0) {}
+
+        SharerSet(const SharerSet &other) : bits(other.bits) {}
+
+        bool test(int cpuID) const { return (bits & mask(cpuID)) != 0; }
+
+        void set(int cpuID) { bits |= mask(cpuID); }
+
+        void clear(int cpuID) { bits &= ~mask(cpuID); }
+
+        void reset() { bits = 0; }
+
+        bool any() const { return bits != 0; }
+
+        int count() const {
+            int cnt = 0;
+            for(uint64_t b = bits; b != 0; b &= b - 1) cnt++;
+            return cnt;
+        }
+
+        /**
+        * @return The lowest cache ID in the set apart from exclude, or -1
+        *         if there is none.
+        */
+        int firstOther(int exclude) const {
+            uint64_t b = exclude >= 0 ? bits & ~mask(exclude) : bits;
+            if(b == 0) return -1;
+            int id = 0;
+            while((b & 1) == 0){
+                b >>= 1;
+                id++;
+            }
+            return id;
+        }
+};
+
+#endif /* SHARER_SET_HH_ */
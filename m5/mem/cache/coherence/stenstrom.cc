@@ -76,10 +76,8 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
 
                     // the old owner wrote back the block
                     // make the requester retransmit the request
-                    assert(outstandingOwnerTransAddrs.find(tmpL2BlkAddr)
-                            != outstandingOwnerTransAddrs.end());
-                    outstandingOwnerTransAddrs.erase(
-                            outstandingOwnerTransAddrs.find(tmpL2BlkAddr));
+                    assert(outstandingOwnerTransAddrs.contains(tmpL2BlkAddr));
+                    outstandingOwnerTransAddrs.erase(tmpL2BlkAddr);
 
                     req->ownerWroteBack = true;
                     sendNACK(req, cache->getHitLatency(), fromCpuId, -1);
@@ -118,8 +116,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
                 // the previous owner wrote back the block
                 // in the middle of the transfer
                 // make the requester resend as a read
-                assert(outstandingOwnerTransAddrs.find(tmpL2BlkAddr)
-                        == outstandingOwnerTransAddrs.end());
+                assert(!outstandingOwnerTransAddrs.contains(tmpL2BlkAddr));
                 req->ownerWroteBack = true;
                 sendNACK(req, cache->getHitLatency(), fromCpuId, -1);
                 return true;
@@ -138,8 +135,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
                 if(req->cmd == DirOwnerTransfer){
 
                     // owner transfer to this block is allowed again
-                    outstandingOwnerTransAddrs.erase(
-                            outstandingOwnerTransAddrs.find(tmpL2BlkAddr));
+                    outstandingOwnerTransAddrs.erase(tmpL2BlkAddr);
 
                     this->writeTraceLine(cacheName,
                                    "Owner Transfer ACK recieved",
@@ -168,8 +164,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
                     // from blocked list
                     int requesterID = parentPtr->getOwner(tmpL2BlkAddr);
                     parentPtr->setOwner(tmpL2BlkAddr, req->fromProcessorID);
-                    outstandingOwnerTransAddrs.erase(
-                            outstandingOwnerTransAddrs.find(tmpL2BlkAddr));
+                    outstandingOwnerTransAddrs.erase(tmpL2BlkAddr);
 
                     sendNACK(req, lat, requesterID, -1);
                     return true;
@@ -200,8 +195,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
             }
             else if(req->writeMiss){
 
-                if(outstandingOwnerTransAddrs.find(tmpL2BlkAddr)
-                   != outstandingOwnerTransAddrs.end()){
+                if(outstandingOwnerTransAddrs.contains(tmpL2BlkAddr)){
                     //destination was req->fromProcessorID
                     sendNACK(req, lat, fromCpuId, -1);
                     return true;
@@ -229,8 +223,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
             }
             else if(req->cmd == Writeback || req->cmd == DirWriteback){
 
-                if(outstandingOwnerTransAddrs.find(tmpL2BlkAddr)
-                   == outstandingOwnerTransAddrs.end()){
+                if(!outstandingOwnerTransAddrs.contains(tmpL2BlkAddr)){
                     // not part of an owner transfer, must be from owner
                     assert(parentPtr->getOwner(tmpL2BlkAddr) == fromCpuId);
                 }
@@ -246,8 +239,7 @@ StenstromProtocol<TagStore>::doDirectoryAccess(MemReqPtr& req){
             }
             else if(req->cmd == DirOwnerTransfer){
 
-                if(outstandingOwnerTransAddrs.find(tmpL2BlkAddr)
-                   != outstandingOwnerTransAddrs.end()){
+                if(outstandingOwnerTransAddrs.contains(tmpL2BlkAddr)){
                     //destination was req->fromProcessorID
                     sendNACK(req, lat, fromCpuId, -1);
                     return true;
@@ -409,21 +401,15 @@ StenstromProtocol<TagStore>::doL1DirectoryAccess(MemReqPtr& req, BlkType* blk){
             if(blk->dirState == DirOwnedExGR){
 
                 // make sure it is really one owner
-                int presentCount = 0;
-                for(int i=0;i<cache->cpuCount;i++){
-                    if(blk->presentFlags[i]) presentCount++;
-                }
+                int presentCount = blk->presentFlags->count();
                 assert(presentCount == 1);
 
                 // update block state
                 int fromCpuID = req->fromProcessorID;
-                blk->presentFlags[fromCpuID] = true;
+                blk->presentFlags->set(fromCpuID);
 
                 // this request might be from ourselves
-                int newSharerCount = 0;
-                for(int i=0;i<cache->cpuCount;i++){
-                    if(blk->presentFlags[i]) newSharerCount++;
-                }
+                int newSharerCount = blk->presentFlags->count();
                 if(newSharerCount == 1){
                     // the block is present in our cache, answer the request
                     this->writeTraceLine(cacheName,
@@ -470,7 +456,7 @@ StenstromProtocol<TagStore>::doL1DirectoryAccess(MemReqPtr& req, BlkType* blk){
                 }
                 assert(fromCpuID != cache->getCacheCPUid());
 
-                blk->presentFlags[fromCpuID] = true;
+                blk->presentFlags->set(fromCpuID);
                 setUpRedirectedReadReply(req,
                                          cache->getCacheCPUid(),
                                          fromCpuID);
@@ -515,12 +501,9 @@ StenstromProtocol<TagStore>::doL1DirectoryAccess(MemReqPtr& req, BlkType* blk){
             blk->owner = req->owner;
 
             // the previous owner does not necessarily know about this cache
-            blk->presentFlags[cache->getCacheCPUid()] = true;
+            blk->presentFlags->set(cache->getCacheCPUid());
 
-            int sharerCount = 0;
-            for(int i=0;i<cache->cpuCount;i++){
-                if(blk->presentFlags[i]) sharerCount++;
-            }
+            int sharerCount = blk->presentFlags->count();
 
             assert(sharerCount > 0);
             if(sharerCount == 1) blk->dirState = DirOwnedExGR;
@@ -693,17 +676,12 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
             assert(req->presentFlags == NULL);
 
             Addr tmpBlkAddr = req->paddr & ~((Addr)cache->getBlockSize() - 1);
-            assert(outstandingWritebackWSAddrs.find(tmpBlkAddr)
-                    != outstandingWritebackWSAddrs.end());
+            assert(outstandingWritebackWSAddrs.contains(tmpBlkAddr));
 
-            outstandingWritebackWSAddrs[tmpBlkAddr][req->fromProcessorID]
-                    = false;
-            bool* tmpPresentFlags = outstandingWritebackWSAddrs[tmpBlkAddr];
+            outstandingWritebackWSAddrs[tmpBlkAddr]->clear(req->fromProcessorID);
+            SharerSet* tmpPresentFlags = outstandingWritebackWSAddrs[tmpBlkAddr];
 
-            int presentCount = 0;
-            for(int i=0;i<cache->cpuCount;i++){
-                if(tmpPresentFlags[i]) presentCount++;
-            }
+            int presentCount = tmpPresentFlags->count();
 
             req->dirNACK = false;
 
@@ -719,8 +697,7 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
                 sendDirectoryMessage(req, cache->getHitLatency());
 
                 // writeback has been handled, remove it
-                outstandingWritebackWSAddrs.erase(
-                        outstandingWritebackWSAddrs.find(tmpBlkAddr));
+                outstandingWritebackWSAddrs.erase(tmpBlkAddr);
 
                 this->writeTraceLine(cacheName,
                                "No sharers left, doing normal writeback",
@@ -734,13 +711,7 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
             }
 
             else{
-                int nextSharer = -1;
-                for(int i=0;i<cache->cpuCount;i++){
-                    if(tmpPresentFlags[i]){
-                        nextSharer = i;
-                        break;
-                    }
-                }
+                int nextSharer = tmpPresentFlags->firstOther(-1);
                 assert(nextSharer != -1);
 
                 req->toProcessorID = nextSharer;
@@ -828,8 +799,7 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
         if(tmpBlk == NULL){
             // we are in the process of writing back the block
             Addr tmpBlkAddr = req->paddr & ~((Addr)cache->getBlockSize() - 1);
-            if(outstandingWritebackWSAddrs.find(tmpBlkAddr)
-               == outstandingWritebackWSAddrs.end()){
+            if(!outstandingWritebackWSAddrs.contains(tmpBlkAddr)){
                 // we have written back the block
                 // or the block has been given a new owner
                 // send NACK to L2 and let it handle it
@@ -840,9 +810,8 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
                 return true;
             }
 
-            assert(outstandingWritebackWSAddrs.find(tmpBlkAddr)
-                    != outstandingWritebackWSAddrs.end());
-            outstandingWritebackWSAddrs[tmpBlkAddr][req->replacedByID] = false;
+            assert(outstandingWritebackWSAddrs.contains(tmpBlkAddr));
+            outstandingWritebackWSAddrs[tmpBlkAddr]->clear(req->replacedByID);
 
             this->writeTraceLine(cacheName,
                            "Sharer writeback recieved to block that is "
@@ -883,12 +852,9 @@ StenstromProtocol<TagStore>::handleDirectoryResponse(MemReqPtr& req,
             return true;
         }
 
-        tmpBlk->presentFlags[req->replacedByID] = false;
+        tmpBlk->presentFlags->clear(req->replacedByID);
 
-        int sharers = 0;
-        for(int i=0;i<cache->cpuCount;i++){
-            if(tmpBlk->presentFlags[i]) sharers++;
-        }
+        int sharers = tmpBlk->presentFlags->count();
 
         assert(sharers > 0);
         if(sharers == 1) tmpBlk->dirState = DirOwnedExGR;
@@ -1046,17 +1012,15 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
         if(req->fromProcessorID == -1){
 
             int newOwner = -1;
-            bool* oldFlags = NULL;
+            SharerSet* oldFlags = NULL;
 
-            if(outstandingWritebackWSAddrs.find(
-               req->paddr & ~((Addr)cache->getBlockSize() - 1))
-               != outstandingWritebackWSAddrs.end()){
+            if(outstandingWritebackWSAddrs.contains(
+               req->paddr & ~((Addr)cache->getBlockSize() - 1))){
 
                 //remove this entry
                 Addr tmpAddr = req->paddr & ~((Addr)cache->getBlockSize() - 1);
                 oldFlags = outstandingWritebackWSAddrs[tmpAddr];
-                outstandingWritebackWSAddrs.erase(
-                        outstandingWritebackWSAddrs.find(tmpAddr));
+                outstandingWritebackWSAddrs.erase(tmpAddr);
 
                 // no need to check for other sharers
                 // (end of ownership replacement with sharers)
@@ -1094,7 +1058,7 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
                 assert(blk->presentFlags != NULL);
 
                 newOwner = req->owner;
-                blk->presentFlags[newOwner] = true;
+                blk->presentFlags->set(newOwner);
                 oldFlags = blk->presentFlags;
 
                 // update local block
@@ -1121,7 +1085,7 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
             assert(oldFlags != NULL);
             assert(newOwner != -1);
             for(int i=0;i<cache->cpuCount;i++){
-                if(oldFlags[i]
+                if(oldFlags->test(i)
                    && i != cache->getCacheCPUid()
                    && i != newOwner){
                     // send request to all other sharers
@@ -1154,10 +1118,7 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
             // We have recieved ownership of a block because of a L1 write miss
             assert(cache->getCacheCPUid() == req->owner);
 
-            int sharerCount = 0;
-            for(int i=0;i<cache->cpuCount;i++){
-                if(req->presentFlags[i]) sharerCount++;
-            }
+            int sharerCount = req->presentFlags->count();
 
             // we must get the block, because the the previous call is bypassed
             CacheBlk::State old_state = (blk) ? blk->status : 0;
@@ -1204,7 +1165,7 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
 
             blk->owner = cache->getCacheCPUid();
             blk->presentFlags = req->presentFlags;
-            blk->presentFlags[cache->getCacheCPUid()] = true;
+            blk->presentFlags->set(cache->getCacheCPUid());
             blk->dirState = DirOwnedNonExGR;
 
             // remove the reference to these flags, so they are
@@ -1247,11 +1208,8 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
 	    if(blk->dirState == DirNoState){
 
 	        assert(req->presentFlags == NULL);
-	        blk->presentFlags = new bool[cache->cpuCount];
-		for(int i=0;i<cache->cpuCount;i++){
-                    blk->presentFlags[i] = false;
-                }
-		blk->presentFlags[cache->getCacheCPUid()] = true;
+	        blk->presentFlags = new SharerSet;
+		blk->presentFlags->set(cache->getCacheCPUid());
 		blk->dirState = DirOwnedExGR;
                 blk->owner = cache->getCacheCPUid(); // needed in case 2
 	    }
@@ -1310,13 +1268,10 @@ StenstromProtocol<TagStore>::handleDirectoryFill(MemReqPtr& req,
         blk->dirState = DirOwnedExGR;
 
         if(blk->presentFlags == NULL){
-            blk->presentFlags = new bool[cache->cpuCount];
-        }
-
-        for(int i=0;i<cache->cpuCount;i++){
-            blk->presentFlags[i] = false;
+            blk->presentFlags = new SharerSet;
         }
-        blk->presentFlags[cache->getCacheCPUid()] = true;
+        blk->presentFlags->reset();
+        blk->presentFlags->set(cache->getCacheCPUid());
     }
     else{
         fatal("response type not implemented (handleResponse())");
@@ -1340,12 +1295,12 @@ StenstromProtocol<TagStore>::doDirectoryWriteback(MemReqPtr& req){
         assert(req->presentFlags != NULL);
 
         // set our present flag to false
-        req->presentFlags[cache->getCacheCPUid()] = false;
+        req->presentFlags->clear(cache->getCacheCPUid());
 
         int foundCount = 0;
         int newOwner = -1;
         for(int i=0;i<cache->cpuCount;i++){
-            if(i != cache->getCacheCPUid() && req->presentFlags[i]){
+            if(i != cache->getCacheCPUid() && req->presentFlags->test(i)){
                 newOwner = i;
                 foundCount++;
                 break;
@@ -1360,12 +1315,11 @@ StenstromProtocol<TagStore>::doDirectoryWriteback(MemReqPtr& req){
         req->toInterfaceID = -1;
         req->owner = cache->getCacheCPUid();
 
-        bool* tmpFlags = req->presentFlags;
+        SharerSet* tmpFlags = req->presentFlags;
         req->presentFlags = NULL;
 
         Addr tmpBlkAddr = req->paddr & ~((Addr)cache->getBlockSize() - 1);
-        if(outstandingWritebackWSAddrs.find(tmpBlkAddr)
-           == outstandingWritebackWSAddrs.end()){
+        if(!outstandingWritebackWSAddrs.contains(tmpBlkAddr)){
             // there is no outstanding writeback to this address
             outstandingWritebackWSAddrs[tmpBlkAddr] = tmpFlags;
         }
@@ -1441,8 +1395,7 @@ StenstromProtocol<TagStore>::handleL1DirectoryMiss(MemReqPtr& req){
     }
     else if(req->cmd == Read || req->cmd == Write){
         Addr tmpAddr = req->paddr & ~((Addr)cache->getBlockSize() - 1);
-        if(outstandingWritebackWSAddrs.find(tmpAddr)
-           != outstandingWritebackWSAddrs.end()){
+        if(outstandingWritebackWSAddrs.contains(tmpAddr)){
             // this cache still has updated state for this cache
             // respond to request
             cache->respond(req, curTick + cache->getHitLatency());
@@ -1542,6 +1495,9 @@ StenstromProtocol<TagStore>::setUpACK(MemReqPtr& req, int toID, int fromID){
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #if defined(USE_CACHE_FALRU)
     template class StenstromProtocol<CacheTags<FALRU,NullCompression> >;
@@ -1555,6 +1511,9 @@ StenstromProtocol<TagStore>::setUpACK(MemReqPtr& req, int toID, int fromID){
 #if defined(USE_LZSS_COMPRESSION)
     template class StenstromProtocol<CacheTags<IIC,LZSSCompression> >;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+    template class StenstromProtocol<CacheTags<IIC,BDICompression> >;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
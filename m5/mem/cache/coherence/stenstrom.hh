@@ -25,8 +25,8 @@ class StenstromProtocol : public DirectoryProtocol<TagStore>
     private:
         DirectoryProtocol<TagStore>* parentPtr;
         
-        std::map<Addr, bool*> outstandingWritebackWSAddrs;
-        std::map<Addr, int> outstandingOwnerTransAddrs;
+        TransientTable<SharerSet*> outstandingWritebackWSAddrs;
+        TransientTable<int> outstandingOwnerTransAddrs;
     
     public:
         
@@ -41,17 +41,23 @@ class StenstromProtocol : public DirectoryProtocol<TagStore>
         *                      profile event
         * @param _traceStart   The clock cycle to start tracing protocol 
         *                      actions
+        * @param _numSets      The number of sets in the associated cache
+        * @param _assoc        The associativity of the associated cache
         */
         StenstromProtocol(const std::string &_name,
                           const std::string &_protocol,
                           bool _doTrace,
                           int _dumpInterval,
-                          int _traceStart):
+                          int _traceStart,
+                          int _numSets,
+                          int _assoc):
             DirectoryProtocol<TagStore>(_name,
                                         _protocol,
                                         _doTrace,
                                         _dumpInterval,
-                                        _traceStart)
+                                        _traceStart,
+                                        _numSets,
+                                        _assoc)
         {
             parentPtr = dynamic_cast<DirectoryProtocol<TagStore>* >(this);
             assert(parentPtr != NULL);
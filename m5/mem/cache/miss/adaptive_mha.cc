@@ -64,7 +64,6 @@ AdaptiveMHA::AdaptiveMHA(const std::string &name,
     totalSharedWritebackDelay.resize(cpu_count, 0);
     delayReadRequestsPerCPU.resize(cpu_count, 0);
     delayWriteRequestsPerCPU.resize(cpu_count, 0);
-    numInterferenceRequests = 0;
     numDelayRequests = 0;
     interferenceOverflow = 0;
 
@@ -260,8 +259,6 @@ AdaptiveMHA::handleSampleEvent(Tick time){
         for(int i=0;i<delayReadRequestsPerCPU.size();i++) delayReadRequestsPerCPU[i] = 0;
         for(int i=0;i<delayWriteRequestsPerCPU.size();i++) delayWriteRequestsPerCPU[i] = 0;
         numDelayRequests = 0;
-        numInterferenceRequests = 0;
-        oracleStorage.clear();
         firstSample = false;
 
         // reset interference stats
@@ -75,7 +75,6 @@ class AdaptiveMHA : public SimObject{
         std::vector<Tick> totalSharedWritebackDelay;
         int interferenceOverflow;
 
-        int numInterferenceRequests;
         int numDelayRequests;
         std::vector<int> delayReadRequestsPerCPU;
         std::vector<int> delayWriteRequestsPerCPU;
@@ -96,37 +95,6 @@ class AdaptiveMHA : public SimObject{
 
 
 
-        struct delayEntry{
-            std::vector<std::vector<Tick> > cbDelay;
-            std::vector<std::vector<Tick> > l2Delay;
-            std::vector<std::vector<Tick> > memDelay;
-            Tick totalDelay;
-            bool isRead;
-
-            delayEntry(){
-                totalDelay = 0;
-                isRead = true;
-            }
-
-            delayEntry(const delayEntry &entry){
-                cbDelay = entry.cbDelay;
-                l2Delay = entry.l2Delay;
-                memDelay = entry.memDelay;
-                totalDelay = entry.totalDelay;
-                isRead = entry.isRead;
-            }
-
-            delayEntry(std::vector<std::vector<Tick> > _delays, bool read, InterferenceType type);
-
-            void addDelays(std::vector<std::vector<Tick> > newDelays, InterferenceType type);
-
-            bool committed(){
-                return (totalDelay != 0);
-            }
-        };
-
-        std::map<Addr,delayEntry> oracleStorage;
-
         Tick startRunning;
         int dumpAtNumReqs;
 
@@ -216,12 +184,12 @@ class AdaptiveMHA : public SimObject{
             cpus[id] = cpu;
         }
 
-        void addInterferenceDelay(std::vector<std::vector<Tick> > perCPUQueueTimes,
+        void addInterferenceDelay(const std::vector<std::vector<Tick> > &perCPUQueueTimes,
                                   Addr addr,
                                   MemCmd cmd,
                                   int fromCPU,
                                   InterferenceType type,
-                                  std::vector<std::vector<bool> > nextIsRead);
+                                  const std::vector<std::vector<bool> > &nextIsRead);
         void addTotalDelay(int issuedCPU, Tick delay, Addr addr, bool isRead);
 
         void coreCommittedInstruction(int cpuID);
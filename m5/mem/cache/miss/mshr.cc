@@ -53,6 +53,9 @@ MSHR::MSHR()
     threadNum = -1;
     mlpCost = 0;
     mlpCostDistribution.clear();
+    mlpCostStartsAt = 0;
+    mlpCostPending = false;
+    mlpCostActive = false;
     allocatedAt = 0;
     mshrID = -1;
 
@@ -71,6 +74,9 @@ MSHR::allocate(MemCmd cmd, Addr _addr, int _asid, int size,
 	allocatedAt = curTick;
 	mlpCost = 0;
 	mlpCostDistribution.clear();
+	mlpCostStartsAt = 0;
+	mlpCostPending = false;
+	mlpCostActive = false;
 
 	req = new MemReq(); // allocate new memory request
 	req->completionEvent = 0; // Don't delete twice!
@@ -79,7 +85,9 @@ MSHR::allocate(MemCmd cmd, Addr _addr, int _asid, int size,
 	req->asid = asid;
 	req->cmd = cmd;
 	req->size = size;
-	req->data = new uint8_t[size];
+	if (cache->doData()) {
+		req->data = new uint8_t[size];
+	}
 	req->mshr = this;
 	//Set the time here for latency calculations
 	req->time = curTick;
@@ -150,7 +158,9 @@ MSHR::allocateAsBuffer(MemReqPtr &target)
     req->flags = target->flags;
     req->xc = target->xc;
     req->thread_num = target->thread_num;
-    req->data = new uint8_t[target->size];
+    if (cache->doData()) {
+	req->data = new uint8_t[target->size];
+    }
     req->mshr = this;
     req->time = curTick;
     req->pc = target->pc;
@@ -189,6 +199,9 @@ MSHR::allocateAsBuffer(MemReqPtr &target)
     allocatedAt = curTick;
     mlpCost = 0;
     mlpCostDistribution.clear();
+    mlpCostStartsAt = 0;
+    mlpCostPending = false;
+    mlpCostActive = false;
 }
 
 void
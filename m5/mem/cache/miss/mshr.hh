@@ -93,6 +93,12 @@ public:
 
     double mlpCost;
     std::vector<double> mlpCostDistribution;
+    /** The tick the MLP cost of this MSHR starts to accumulate. */
+    Tick mlpCostStartsAt;
+    /** True if the MSHR waits for its MLP cost to start. */
+    bool mlpCostPending;
+    /** True if the MSHR is charged MLP cost. */
+    bool mlpCostActive;
 
     Tick allocatedAt;
     int mshrID;
@@ -35,8 +35,6 @@
 
 //#define DO_MISS_COUNT_TRACE
 
-#define FAST_MLP_ESTIMATION
-
 #include "mem/cache/miss/mshr_queue.hh"
 #include "sim/eventq.hh"
 
@@ -69,12 +67,8 @@ MSHRQueue::MSHRQueue(int num_mshrs, bool _isMissQueue, bool _doMSHRTrace, int re
 	countdownCounter = 0;
 	ROBSize = 128; // TODO: this is a hack, fix
 
-
-#ifndef FAST_MLP_ESTIMATION
-	mlpEstEvent = new MLPEstimationEvent(this);
-	//FIXME: write a better performance mlp estimation procedure!
-	mlpEstEvent->schedule(curTick+1);
-#endif
+	mlpCostSyncedAt = 0;
+	mlpCostDemandMSHRs = 0;
 
 	currentMLPAccumulator.resize(maxMSHRs+1, 0.0);
 	mlpAccumulatorTicks = 0;
@@ -133,9 +127,6 @@ MSHRQueue::setCache(BaseCache* _cache){
 MSHRQueue::~MSHRQueue()
 {
 	delete [] registers;
-
-	assert(!mlpEstEvent->scheduled());
-	delete mlpEstEvent;
 }
 
 void
@@ -385,6 +376,7 @@ MSHRQueue::allocate(MemReqPtr &req, int size)
 
 	allocated += 1;
 	allocatedMSHRsChanged(true);
+	if (!req->cmd.isNoResponse()) startMLPCost(mshr);
 
 	missArrived(req->cmd);
 
@@ -407,6 +399,7 @@ MSHRQueue::allocateFetch(Addr addr, int asid, int size, MemReqPtr &target)
 
 	allocated += 1;
 	allocatedMSHRsChanged(true);
+	startMLPCost(mshr);
 
 	return mshr;
 }
@@ -425,6 +418,7 @@ MSHRQueue::allocateTargetList(Addr addr, int asid, int size)
 	++inServiceMSHRs;
 	++allocated;
 	allocatedMSHRsChanged(true);
+	startMLPCost(mshr);
 
 	missArrived(Read);
 
@@ -446,6 +440,8 @@ MSHRQueue::deallocateOne(MSHR* mshr)
 	//HACK by Magnus
 	mshr->directoryOriginalCmd = InvalidCmd;
 
+	finishMLPCost(mshr);
+
 	if(mshr->mlpCost != 0 && isMissQueue && !cache->isShared){
 
 		int latency = curTick - (mshr->req->time + cache->getHitLatency());
@@ -708,7 +704,6 @@ MSHRQueue::isDemandRequest(MemReqPtr&  req){
 
 void
 MSHRQueue::allocatedMSHRsChanged(bool increased){
-#ifdef FAST_MLP_ESTIMATION
 	if(!cache->isShared && isMissQueue){
 
 		int periodMSHRs = allocated+1;
@@ -752,116 +747,97 @@ MSHRQueue::allocatedMSHRsChanged(bool increased){
 		lastAllocatedForLoads = allocatedForLoads;
 		lastMSHRChangeAt = curTick;
 	}
-#endif
 }
 
 void
-MSHRQueue::handleMLPEstimationEvent(){
-#ifndef FAST_MLP_ESTIMATION
-//	allocated_mshrs_distribution.sample(allocated);
+MSHRQueue::startMLPCost(MSHR* mshr){
+	if(cache->isShared || !isMissQueue) return;
+	if(mshr->req->cmd != Read && mshr->req->cmd != Write) return;
 
-	if(!cache->isShared && isMissQueue){
-		int demandAllocated = 0;
+	advanceMLPCost(curTick);
 
-		if(cache->interferenceManager != NULL &&
-		   cache->interferenceManager->isStalledForMemory(cache->cacheCpuID)){
-			detectedStallCycleAccumulator++;
-			instTraceMWSCount++;
-		}
+	// mshrs are allocated in the same cycle as the access arrives, but the miss latency
+	// starts when the request is finished in the cache (i.e after hit latency cycles)
+	mshr->mlpCostStartsAt = mshr->req->time + cache->getHitLatency();
+	mshr->mlpCostPending = true;
 
-		if(allocated > 0){
+	// requests can arrive with an older time than the last one, keep the list sorted on start time
+	std::list<MSHR*>::iterator pos = mlpCostWaitingList.end();
+	while(pos != mlpCostWaitingList.begin()){
+		std::list<MSHR*>::iterator prev = pos;
+		--prev;
+		if((*prev)->mlpCostStartsAt <= mshr->mlpCostStartsAt) break;
+		pos = prev;
+	}
+	mlpCostWaitingList.insert(pos, mshr);
 
-			MSHR::ConstIterator i = allocatedList.begin();
-			MSHR::ConstIterator end = allocatedList.end();
-			for (; i != end; ++i) {
-				MSHR *mshr = *i;
+	advanceMLPCost(curTick);
+}
 
-				// mshrs are allocated in the same cycle as the access arrives, but the miss latency
-				// starts when the request is finished in the cache (i.e after hit latency cycles)
-				int ticksSinceInserted = curTick - mshr->req->time;
-				if(ticksSinceInserted >= cache->getHitLatency() && isDemandRequest(mshr->req)){
-					demandAllocated++;
-				}
-			}
+void
+MSHRQueue::finishMLPCost(MSHR* mshr){
+	if(cache->isShared || !isMissQueue) return;
 
-			if(demandAllocated > 0){
-				double mlpcost = 1 / (double) demandAllocated;
-
-				instTraceMLPAccumulator += mlpcost;
-				instTraceMLPCount++;
-
-				i = allocatedList.begin();
-				end = allocatedList.end();
-				for (; i != end; ++i) {
-					MSHR *mshr = *i;
-					int ticksSinceInserted = curTick - mshr->req->time;
-					if(ticksSinceInserted >= cache->getHitLatency() && isDemandRequest(mshr->req)){
-						mshr->mlpCost += mlpcost;
-
-						if(mshr->mlpCostDistribution.empty()) mshr->mlpCostDistribution.resize(maxMSHRs+1, 0.0);
-						for(int j=0;j<=maxMSHRs;j++){
-							if(j<demandAllocated){
-								double estimatedCost = 1.0 / (double) j;
-								mshr->mlpCostDistribution[j] += estimatedCost;
-							}
-							else{
-								mshr->mlpCostDistribution[j] += mlpcost;
-							}
-						}
-					}
-				}
+	advanceMLPCost(curTick);
 
-				for(int j=0;j<=maxMSHRs;j++){
-					if(j<demandAllocated){
-						double estimatedCost = 1.0 / (double) j;
-						aggregateMLPAccumulator[j] += estimatedCost;
-					}
-					else{
-						aggregateMLPAccumulator[j] += mlpcost;
-					}
-				}
-				aggregateMLPAccumulatorTicks++;
+	if(mshr->mlpCostActive){
+		mshr->mlpCostActive = false;
+		mlpCostDemandMSHRs--;
+		assert(mlpCostDemandMSHRs >= 0);
+	}
+	else if(mshr->mlpCostPending){
+		mshr->mlpCostPending = false;
+		mlpCostWaitingList.remove(mshr);
+	}
+}
+
+void
+MSHRQueue::advanceMLPCost(Tick to){
 
-				if(cache->interferenceManager != NULL
-				   && cache->interferenceManager->isStalledForMemory(cache->cacheCpuID)){
-					for(int k=1;k<=maxMSHRs;k++){
-						if(demandAllocated > k){
-							stallMissCountAccumulator[k] += k;
-						}
-						else{
-							stallMissCountAccumulator[k] += demandAllocated;
+	// startMLPCost keeps the waiting list sorted on start time
+	while(!mlpCostWaitingList.empty() && mlpCostWaitingList.front()->mlpCostStartsAt <= to){
+		MSHR* mshr = mlpCostWaitingList.front();
+		mlpCostWaitingList.pop_front();
 
-						}
-					}
+		integrateMLPCost(mshr->mlpCostStartsAt);
 
-					instTraceMWSAccumulator += demandAllocated;
-				}
+		mshr->mlpCostPending = false;
+		mshr->mlpCostActive = true;
+		mlpCostDemandMSHRs++;
+	}
 
-			}
-		}
+	integrateMLPCost(to);
+}
 
-#ifdef DO_MISS_COUNT_TRACE
+void
+MSHRQueue::integrateMLPCost(Tick to){
+	if(to <= mlpCostSyncedAt) return;
 
-		outstandingMissAccumulator += demandAllocated;
-		outstandingMissAccumulatorCount++;
+	if(mlpCostDemandMSHRs > 0){
+		double length = (double) (to - mlpCostSyncedAt);
+		double mlpcost = length / (double) mlpCostDemandMSHRs;
 
-		int period = 100;
-		if(outstandingMissAccumulatorCount == period){
-			if(cache->adaptiveMHA != NULL){
+		MSHR::ConstIterator i = allocatedList.begin();
+		MSHR::ConstIterator end = allocatedList.end();
+		for (; i != end; ++i) {
+			MSHR *mshr = *i;
+			if(!mshr->mlpCostActive) continue;
 
-				double avgOutstanding = (double) outstandingMissAccumulator / (double) outstandingMissAccumulatorCount;
+			mshr->mlpCost += mlpcost;
 
-				vector<RequestTraceEntry> curEntries;
-				curEntries.push_back(avgOutstanding);
-				missCountTrace.addTrace(curEntries);
+			if(mshr->mlpCostDistribution.empty()) mshr->mlpCostDistribution.resize(maxMSHRs+1, 0.0);
+			for(int j=1;j<=maxMSHRs;j++){
+				if(j<mlpCostDemandMSHRs){
+					mshr->mlpCostDistribution[j] += length / (double) j;
+				}
+				else{
+					mshr->mlpCostDistribution[j] += mlpcost;
+				}
 			}
-			outstandingMissAccumulator = 0;
-			outstandingMissAccumulatorCount = 0;
 		}
-		assert(outstandingMissAccumulatorCount < period);
-#endif
 	}
-#endif
+
+	mlpCostSyncedAt = to;
 }
 
 std::vector<double>
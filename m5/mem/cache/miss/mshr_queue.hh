@@ -36,6 +36,7 @@
 #ifndef __MSHR_QUEUE_HH__
 #define __MSHR_QUEUE_HH__
 
+#include <list>
 #include <vector>
 #include "mem/cache/miss/mshr.hh"
 #include "mem/cache/base_cache.hh" // for CACHE_DEBUG
@@ -43,8 +44,6 @@
 #include "base/statistics.hh"
 #include "mem/requesttrace.hh"
 
-class MLPEstimationEvent;
-
 /**
  * A Class for maintaining a list of pending and allocated memory requests.
  */
@@ -98,7 +97,20 @@ class MSHRQueue {
 
 	bool isMissQueue;
 
-	MLPEstimationEvent* mlpEstEvent;
+	/**
+	 * The MLP cost of a demand miss is integrated lazily. The number of
+	 * demand MSHRs past the hit latency only changes when an MSHR is
+	 * allocated, deallocated or passes its hit latency, so the cost is
+	 * distributed for the whole interval since the last change.
+	 */
+	Tick mlpCostSyncedAt;
+	int mlpCostDemandMSHRs;
+	std::list<MSHR*> mlpCostWaitingList;
+
+	void startMLPCost(MSHR* mshr);
+	void finishMLPCost(MSHR* mshr);
+	void advanceMLPCost(Tick to);
+	void integrateMLPCost(Tick to);
 
 	std::vector<double > currentMLPAccumulator;
 	Tick mlpAccumulatorTicks;
@@ -385,8 +397,6 @@ class MSHRQueue {
 
     void cpuCommittedInstruction();
 
-    void handleMLPEstimationEvent();
-
     bool isDemandRequest(MemReqPtr& req);
 
     std::vector<double> getMLPEstimate();
@@ -413,26 +423,4 @@ class MSHRQueue {
     }
 };
 
-class MLPEstimationEvent : public Event{
-
-private:
-	MSHRQueue* mshrQueue;
-
-public:
-	MLPEstimationEvent(MSHRQueue* _mshrQueue)
-		: Event(&mainEventQueue, Event::Stat_Event_Pri), mshrQueue(_mshrQueue) {
-
-	}
-
-	void process() {
-		mshrQueue->handleMLPEstimationEvent();
-		this->schedule(curTick + 1);
-	}
-
-	virtual const char *description() {
-		return "MLP Estimation Event";
-	}
-
-};
-
 #endif //__MSHR_QUEUE_HH__
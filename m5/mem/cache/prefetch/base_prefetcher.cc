@@ -190,7 +190,9 @@ BasePrefetcher::handleMiss(MemReqPtr &req, Tick time)
 	    prefetch->size = blkSize;
 	    prefetch->cmd = Hard_Prefetch;
 	    prefetch->xc = req->xc;
-	    prefetch->data = new uint8_t[blkSize];
+	    if (cache->doData()) {
+		prefetch->data = new uint8_t[blkSize];
+	    }
 	    prefetch->asid = req->asid;
 	    prefetch->thread_num = req->thread_num;
 	    prefetch->time = time + (*delay); //@todo ADD LATENCY HERE
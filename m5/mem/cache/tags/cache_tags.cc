@@ -65,6 +65,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/tags/cache_tags_impl.hh"
 
@@ -82,6 +85,9 @@ template class CacheTags<IIC, NullCompression>;
 #if defined(USE_LZSS_COMPRESSION)
 template class CacheTags<IIC, LZSSCompression>;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class CacheTags<IIC, BDICompression>;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
@@ -36,6 +36,8 @@
 #ifndef __CACHE_TAGS_HH__
 #define __CACHE_TAGS_HH__
 
+#include <vector>
+
 #include "base/statistics.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/mem_req.hh"
@@ -98,6 +100,12 @@ class CacheTags
      */
     const int blkSize;
 
+    /**
+     * Scratch space for compressing a block, kept to avoid allocating
+     * on every fill and writeback.
+     */
+    std::vector<uint8_t> compBuffer;
+
     /**
      * Pointer to the parent cache.
      */
@@ -54,7 +54,7 @@ CacheTags<Tags,Compression>::CacheTags(Tags *_ct, int comp_latency,
       storeCompressed(store_compressed),
       adaptiveCompression(adaptive_compression),
       prefetchMiss(prefetch_miss),
-      blkSize(ct->getBlockSize())
+      blkSize(ct->getBlockSize()), compBuffer(blkSize)
 {
     cache = NULL;
 }
@@ -66,6 +66,7 @@ CacheTags<Tags,Compression>::regStats(const string &name)
 {
     using namespace Stats;
     ct->regStats(name);
+    compress.regStats(name);
 }
 
 template <class Tags, class Compression>
@@ -593,10 +594,8 @@ CacheTags<Tags,Compression>::writebackBlk(BlkType *blk)
 			// not already compressed
 			// need to compress to ship it
 			assert(data_size == blkSize);
-			uint8_t *tmp_data = new uint8_t[blkSize];
-			data_size = compress.compress(tmp_data,blk->data,
+			data_size = compress.compress(&compBuffer[0],blk->data,
 					data_size);
-			delete [] tmp_data;
 		}
 	}
 
@@ -747,7 +746,7 @@ CacheTags<Tags,Compression>::updateData(BlkType *blk, MemReqList &writebacks,
 					bool compress_block)
 {
     if (storeCompressed && compress_block) {
-	uint8_t *comp_data = new uint8_t[blkSize];
+	uint8_t *comp_data = &compBuffer[0];
 	int new_size = compress.compress(comp_data, blk->data,
 					 blkSize);
 	if (new_size > (blkSize - ct->getSubBlockSize())){
@@ -761,7 +760,6 @@ CacheTags<Tags,Compression>::updateData(BlkType *blk, MemReqList &writebacks,
 	    ct->writeData(blk, comp_data, new_size,
 			  writebacks);
 	}
-	delete [] comp_data;
     } else {
 	blk->status &= ~BlkCompressed;
 	ct->writeData(blk, blk->data, blkSize, writebacks);
@@ -795,10 +793,7 @@ CacheTags<Tags,Compression>::doReplacement(BlkType *blk, MemReqPtr &req,
 				assert(blk->owner >= 0);
 
 				if(blk->dirState == DirOwnedExGR || blk->dirState == DirOwnedNonExGR){
-					int numCopies = 0;
-					for(int i=0;i<cache->cpuCount;i++){
-						if(blk->presentFlags[i] == true) numCopies++;
-					}
+					int numCopies = blk->presentFlags->count();
 
 					assert(numCopies > 0);
 
@@ -829,12 +824,7 @@ CacheTags<Tags,Compression>::doReplacement(BlkType *blk, MemReqPtr &req,
 								(cache->doData()) ? blk->data : 0,
 										DirOwnerWriteback);
 
-						bool* pfCopy = new bool[cache->cpuCount];
-						for(int i=0;i<cache->cpuCount;i++){
-							pfCopy[i] = blk->presentFlags[i];
-						}
-
-						wbBlk->presentFlags = pfCopy;
+						wbBlk->presentFlags = new SharerSet(*blk->presentFlags);
 						writebacks.push_back(wbBlk);
 					}
 				}
@@ -106,7 +106,7 @@ CacheSet::moveToHead(LRUBlk *blk)
 
 // create and initialize a LRU/MRU cache structure
 //block size is configured in bytes
-LRU::LRU(int _numSets, int _blkSize, int _assoc, int _hit_latency, int _bank_count, bool _isShadow, int _divFactor, int _maxUseWays, int _shadowID) :
+LRU::LRU(int _numSets, int _blkSize, int _assoc, int _hit_latency, int _bank_count, bool _isShadow, int _divFactor, int _maxUseWays, int _shadowID, bool _storeData) :
 	numSets(_numSets), blkSize(_blkSize), assoc(_assoc), hitLatency(_hit_latency),numBanks(_bank_count),isShadow(_isShadow),divFactor(_divFactor)
 	{
 
@@ -155,8 +155,12 @@ LRU::LRU(int _numSets, int _blkSize, int _assoc, int _hit_latency, int _bank_cou
 
 	sets = new CacheSet[numSets];
 	blks = new LRUBlk[numSets * assoc];
-	// allocate data storage in one big chunk
-	dataBlks = new uint8_t[numSets*assoc*blkSize];
+	// allocate data storage in one big chunk, timing-only tag stores
+	// (shadow tags and caches in hierarchies without data) do not need it
+	dataBlks = NULL;
+	if(_storeData){
+		dataBlks = new uint8_t[numSets*assoc*blkSize];
+	}
 
 	blkIndex = 0;	// index into blks array
 	for (i = 0; i < numSets; ++i) {
@@ -169,7 +173,7 @@ LRU::LRU(int _numSets, int _blkSize, int _assoc, int _hit_latency, int _bank_cou
 		for (j = 0; j < assoc; ++j) {
 			// locate next cache block
 			blk = &blks[blkIndex];
-			blk->data = &dataBlks[blkSize*blkIndex];
+			blk->data = dataBlks ? &dataBlks[blkSize*blkIndex] : NULL;
 			++blkIndex;
 
 			// invalidate new cache block
@@ -212,7 +216,7 @@ LRU::LRU(int _numSets, int _blkSize, int _assoc, int _hit_latency, int _bank_cou
 
 LRU::~LRU()
 {
-	delete [] dataBlks;
+	if(dataBlks != NULL) delete [] dataBlks;
 	delete [] blks;
 	delete [] sets;
 }
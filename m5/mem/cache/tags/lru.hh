@@ -120,7 +120,7 @@ protected:
 
 	/** The cache blocks. */
 	LRUBlk *blks;
-	/** The data blocks, 1 per cache block. */
+	/** The data blocks, 1 per cache block. NULL if data is not stored. */
 	uint8_t *dataBlks;
 
 	/** The amount to shift the address to get the set. */
@@ -160,6 +160,7 @@ public:
 	 * @param _blkSize The number of bytes in a block.
 	 * @param _assoc The associativity of the cache.
 	 * @param _hit_latency The latency in cycles for a hit.
+	 * @param _storeData Allocate storage for the block data.
 	 */
 	LRU(int _numSets,
 		int _blkSize,
@@ -169,7 +170,8 @@ public:
 		bool _isShadow,
 		int _divFactor,
 		int _maxUseWays,
-		int _shadowID = -1);
+		int _shadowID = -1,
+		bool _storeData = true);
 
 	/**
 	 * Destructor
@@ -339,6 +341,7 @@ public:
 	 */
 	void readData(LRUBlk *blk, uint8_t *data)
 	{
+		assert(blk->data);
 		memcpy(data, blk->data, blk->size);
 	}
 
@@ -37,3 +37,4 @@
  */
 
 #define USE_LZSS_COMPRESSION 1
+#define USE_BDI_COMPRESSION 1
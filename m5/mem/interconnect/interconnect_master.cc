@@ -34,6 +34,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/miss/blocking_buffer.hh"
 #include "mem/cache/miss/miss_queue.hh"
@@ -69,6 +72,12 @@ template class InterconnectMaster<Cache<CacheTags<IIC,LZSSCompression>, Blocking
 template class InterconnectMaster<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, SimpleCoherence> >;
 template class InterconnectMaster<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, UniCoherence> >;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class InterconnectMaster<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, SimpleCoherence> >;
+template class InterconnectMaster<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, UniCoherence> >;
+template class InterconnectMaster<Cache<CacheTags<IIC,BDICompression>, MissQueue, SimpleCoherence> >;
+template class InterconnectMaster<Cache<CacheTags<IIC,BDICompression>, MissQueue, UniCoherence> >;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
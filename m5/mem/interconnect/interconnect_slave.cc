@@ -34,6 +34,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/miss/blocking_buffer.hh"
 #include "mem/cache/miss/miss_queue.hh"
@@ -71,6 +74,12 @@ template class InterconnectSlave<Cache<CacheTags<IIC,LZSSCompression>, BlockingB
 template class InterconnectSlave<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, SimpleCoherence> >;
 template class InterconnectSlave<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, UniCoherence> >;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class InterconnectSlave<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, SimpleCoherence> >;
+template class InterconnectSlave<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, UniCoherence> >;
+template class InterconnectSlave<Cache<CacheTags<IIC,BDICompression>, MissQueue, SimpleCoherence> >;
+template class InterconnectSlave<Cache<CacheTags<IIC,BDICompression>, MissQueue, UniCoherence> >;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
@@ -26,6 +26,8 @@ PeerToPeerLink::PeerToPeerLink(const std::string &_name,
 {
     initQueues(_cpu_count, 2);
     queueSize = 32;
+    p2pRequestQueue = TimeOrderedQueue<MemReqPtr>(queueSize);
+    p2pResponseQueue = TimeOrderedQueue<MemReqPtr>(queueSize);
 
     arbEvent = new ADIArbitrationEvent(this);
 
@@ -87,14 +89,14 @@ PeerToPeerLink::send(MemReqPtr& req, Tick time, int fromID){
 
     if(allInterfaces[fromID]->isMaster()){
 
-        p2pRequestQueue.push_back(req);
+        p2pRequestQueue.push(curTick, req);
         if(p2pRequestQueue.size() == queueSize){
             setBlockedLocal(req->adaptiveMHASenderID);
         }
         assert(p2pRequestQueue.size() <= queueSize);
     }
     else{
-        p2pResponseQueue.push_back(req);
+        p2pResponseQueue.push(curTick, req);
         assert(p2pResponseQueue.size() <= queueSize);
     }
 
@@ -118,7 +120,7 @@ PeerToPeerLink::arbitrate(Tick time){
 
     if(!p2pRequestQueue.empty() && !blockedInterfaces[0]){
         MemReqPtr mreq = p2pRequestQueue.front();
-        p2pRequestQueue.pop_front();
+        p2pRequestQueue.pop();
         mreq->toInterfaceID = slaveInterconnectID;
 
         totalArbQueueCycles += curTick - mreq->inserted_into_crossbar;
@@ -149,7 +151,7 @@ PeerToPeerLink::arbitrate(Tick time){
         	interferenceManager->addPrivateLatency(InterferenceManager::InterconnectResponseTransfer, sreq, transferDelay);
         }
 
-        p2pResponseQueue.pop_front();
+        p2pResponseQueue.pop();
         ADIDeliverEvent* delivery = new ADIDeliverEvent(this, sreq, false);
         delivery->schedule(curTick + transferDelay);
     }
@@ -188,7 +190,7 @@ PeerToPeerLink::deliver(MemReqPtr& req, Tick cycle, int toID, int fromID){
         assert(slaveInterfaces.size() == 1);
         assert(slaveInterfaces.size() == blockedInterfaces.size());
         if(blockedInterfaces[0] || !deliveryBuffer.empty()){
-            deliveryBuffer.push_back(req);
+            deliveryBuffer.push(curTick, req);
             assert(deliveryBuffer.size() == 1);
         }
         else{
@@ -203,7 +205,7 @@ PeerToPeerLink::clearBlocked(int fromInterface){
 
     while(!deliveryBuffer.empty()){
         MemReqPtr req = deliveryBuffer.front();
-        deliveryBuffer.pop_front();
+        deliveryBuffer.pop();
         MemAccessResult res = allInterfaces[slaveInterconnectID]->access(req);
         if(res == BA_BLOCKED) return;
     }
@@ -3,13 +3,14 @@
 #define __PEER_TO_PEER_LINK_HH__
 
 #include "address_dependent_ic.hh"
+#include "time_ordered_queue.hh"
 
 class PeerToPeerLink : public AddressDependentIC{ 
     
     private:
 
-        std::list<MemReqPtr> p2pRequestQueue;
-        std::list<MemReqPtr> p2pResponseQueue;
+        TimeOrderedQueue<MemReqPtr> p2pRequestQueue;
+        TimeOrderedQueue<MemReqPtr> p2pResponseQueue;
         
         ADIArbitrationEvent* arbEvent;
         
@@ -21,7 +22,7 @@ class PeerToPeerLink : public AddressDependentIC{
         
         Tick nextLegalArbTime;
         
-        std::list<MemReqPtr> deliveryBuffer;
+        TimeOrderedQueue<MemReqPtr> deliveryBuffer;
         
         void retrieveAdditionalRequests();
         
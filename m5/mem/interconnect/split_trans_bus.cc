@@ -11,25 +11,18 @@ SplitTransBus::request(Tick time, int fromID){
     
     assert(fromID >= 0);
     
-    // keep linked list of requests sorted at all times
+    // the queues are kept sorted at all times
     // first request takes priority over later requests at same cycle
-    InterconnectRequest* newReq = new InterconnectRequest(time, fromID);
-    if(pipelined){
-        if(allInterfaces[fromID]->isMaster()){
-            addToList(&requestQueue, newReq);
-        }
-        else{
-            addToList(slaveRequestQueue, newReq);
-        }
+    if(pipelined && !allInterfaces[fromID]->isMaster()){
+        slaveRequestQueue.push(time, fromID);
     }
     else{
-        addToList(&requestQueue, newReq);
+        requestQueue.push(time, fromID);
     }
 
-    
 #ifdef DEBUG_SPLIT_TRANS_BUS
-    checkIfSorted(&requestQueue);
-    if(pipelined) checkIfSorted(slaveRequestQueue);
+    assert(requestQueue.isSorted());
+    assert(slaveRequestQueue.isSorted());
 #endif //DEBUG_SPLIT_TRANS_BUS
     
     if(!blocked){
@@ -70,21 +63,6 @@ SplitTransBus::request(Tick time, int fromID){
     }
 }
 
-void
-SplitTransBus::addToList(std::list<InterconnectRequest*>* inList,
-                         InterconnectRequest* icReq){
-    
-    list<InterconnectRequest*>::iterator findPos;
-    for(findPos=inList->begin();
-        findPos!=inList->end();
-        findPos++){
-            InterconnectRequest* tempReq = *findPos;
-            if(icReq->time < tempReq->time) break;
-        }
-
-    inList->insert(findPos, icReq);
-}
-
 void
 SplitTransBus::scheduleArbitrationEvent(Tick possibleArbCycle){
     
@@ -109,7 +87,7 @@ void
 SplitTransBus::arbitrate(Tick cycle){
     
     assert(!blocked);
-    if(pipelined) assert(!requestQueue.empty() || !slaveRequestQueue->empty());
+    if(pipelined) assert(!requestQueue.empty() || !slaveRequestQueue.empty());
     else assert(!requestQueue.empty());
     
     if(pipelined){
@@ -122,7 +100,7 @@ SplitTransBus::arbitrate(Tick cycle){
     
     
     if(!requestQueue.empty()){
-        Tick nextReqTime = requestQueue.front()->time;
+        Tick nextReqTime = requestQueue.frontTime();
     
         if(pipelined){
             if(nextReqTime <= (cycle - arbitrationDelay)){
@@ -143,8 +121,8 @@ SplitTransBus::arbitrate(Tick cycle){
     }
     
     if(pipelined){
-        if(!slaveRequestQueue->empty()){
-            Tick nextReqTime = slaveRequestQueue->front()->time;
+        if(!slaveRequestQueue.empty()){
+            Tick nextReqTime = slaveRequestQueue.frontTime();
         
             if(nextReqTime <= (cycle - arbitrationDelay)){
                 scheduleArbitrationEvent(cycle + 1);
@@ -160,31 +138,28 @@ void
 SplitTransBus::grantInterface(grant_type gt, Tick cycle){
     
     Tick goodReqTime = cycle - arbitrationDelay;
-    InterconnectRequest* grantReq;
+    TimeOrderedQueue<int>* queue = NULL;
     
-    /* remove the request from the correct queue */
+    /* find the correct queue */
     switch(gt){
         case STB_NOT_PIPELINED:
-            grantReq = requestQueue.front();
-            requestQueue.pop_front();
+            queue = &requestQueue;
             break;
         
         case STB_MASTER:
-            if(requestQueue.empty()) return;
-            grantReq = requestQueue.front();
+            queue = &requestQueue;
+            if(queue->empty()) return;
             
             /* check if requests are available */
-            if(grantReq->time > goodReqTime) return;
-            requestQueue.pop_front();
+            if(queue->frontTime() > goodReqTime) return;
             break;
             
         case STB_SLAVE:
-            if(slaveRequestQueue->empty()) return;
-            grantReq = slaveRequestQueue->front();
+            queue = &slaveRequestQueue;
+            if(queue->empty()) return;
             
             /* check if requests are available */
-            if(grantReq->time > goodReqTime) return;
-            slaveRequestQueue->pop_front();
+            if(queue->frontTime() > goodReqTime) return;
             break;
             
         default:
@@ -192,15 +167,17 @@ SplitTransBus::grantInterface(grant_type gt, Tick cycle){
             
     }
     
+    Tick reqTime = queue->frontTime();
+    int fromID = queue->front();
+    queue->pop();
+    
     /* grant access */
-    allInterfaces[grantReq->fromID]->grantData();
+    allInterfaces[fromID]->grantData();
     
     /* update statistics */
     arbitratedRequests++;
-    totalArbQueueCycles += ((cycle - grantReq->time) - arbitrationDelay);
+    totalArbQueueCycles += ((cycle - reqTime) - arbitrationDelay);
     totalArbitrationCycles += arbitrationDelay;
-    
-    delete grantReq;
 }
 
 
@@ -213,13 +190,13 @@ SplitTransBus::send(MemReqPtr& req, Tick time, int fromID){
     bool isFromMaster = false;
     if(allInterfaces[fromID]->isMaster()) isFromMaster = true;
     
+    PendingDelivery delivery;
+    delivery.fromID = fromID;
+    delivery.req = req;
+    
     if(req->toInterfaceID != -1){
         // L1 to L1 request
-        deliverQueue.push_back(
-                new InterconnectDelivery(time, 
-                                         fromID,
-                                         req->toInterfaceID,
-                                         req));
+        delivery.toID = req->toInterfaceID;
     }
     else if(isFromMaster){
         // Try all slaves and check if they can supply the needed data
@@ -243,34 +220,17 @@ SplitTransBus::send(MemReqPtr& req, Tick time, int fromID){
         }
         
         /* deliver to L2 cache */
-        deliverQueue.push_back(
-                new InterconnectDelivery(time, fromID, toID, req));
+        delivery.toID = toID;
     }
     else{
         /* deliver to L1 cache */
-        deliverQueue.push_back(
-                new InterconnectDelivery(time,
-                                         fromID,
-                                         req->fromInterfaceID,
-                                         req));
+        delivery.toID = req->fromInterfaceID;
     }
     
+    deliverQueue.push(time, delivery);
+    
 #ifdef DEBUG_SPLIT_TRANS_BUS
-    /* check that the queue is sorted */
-    InterconnectDelivery* prev = NULL;
-    bool first = true;
-    for(list<InterconnectDelivery*>::iterator i=deliverQueue.begin();
-        i!=deliverQueue.end();
-        i++){
-            if(first){
-                first = false;
-                prev = *i;
-                continue;
-            }
-            
-            assert(prev->grantTime <= (*i)->grantTime);
-            prev = *i;
-        }
+    assert(deliverQueue.isSorted());
 #endif //DEBUG_SPLIT_TRANS_BUS
     
     if(doProfile) useCycleSample += transferDelay;
@@ -304,40 +264,39 @@ SplitTransBus::deliver(MemReqPtr& req, Tick cycle, int toID, int fromID){
     assert(!blocked);
     assert(!deliverQueue.empty());
     
-    InterconnectDelivery* delivery = deliverQueue.front();
-    deliverQueue.pop_front();
+    Tick grantTime = deliverQueue.frontTime();
+    PendingDelivery delivery = deliverQueue.front();
+    deliverQueue.pop();
     
     /* update statistics */
     sentRequests++;
-    int queueTime = (cycle - delivery->grantTime) - transferDelay;
+    int queueTime = (cycle - grantTime) - transferDelay;
     totalTransQueueCycles += queueTime;
     totalTransferCycles += transferDelay;
     
-    int curCpuId = delivery->req->xc->cpu->params->cpu_id;
+    int curCpuId = delivery.req->xc->cpu->params->cpu_id;
     perCpuTotalTransQueueCycles[curCpuId] += queueTime;
     perCpuTotalTransferCycles[curCpuId] += transferDelay;
     
     int retval = BA_NO_RESULT;
-    assert(delivery->toID > -1);
-    if(allInterfaces[delivery->toID]->isMaster()){
-        allInterfaces[delivery->toID]->deliver(delivery->req);
+    assert(delivery.toID > -1);
+    if(allInterfaces[delivery.toID]->isMaster()){
+        allInterfaces[delivery.toID]->deliver(delivery.req);
     }
     else{
-        retval = allInterfaces[delivery->toID]->access(delivery->req);
+        retval = allInterfaces[delivery.toID]->access(delivery.req);
     }
     
-    delete delivery;
-    
     if(retval != BA_BLOCKED){
         /* see if we need to schedule another delivery */
         if(!deliverQueue.empty()){
-            InterconnectDelivery* nextDelivery = deliverQueue.front();
-            if(nextDelivery->grantTime <= (cycle - transferDelay)){
+            Tick nextGrantTime = deliverQueue.frontTime();
+            if(nextGrantTime <= (cycle - transferDelay)){
                 if(pipelined) scheduleDeliverEvent(cycle + 1); 
                 else scheduleDeliverEvent(cycle + transferDelay);
             }
             else{
-                scheduleDeliverEvent(nextDelivery->grantTime + transferDelay);
+                scheduleDeliverEvent(nextGrantTime + transferDelay);
             }
         }
     }
@@ -382,7 +341,7 @@ SplitTransBus::clearBlocked(int fromInterface){
         blocked = false;
         
         if(!requestQueue.empty()){
-            Tick min = requestQueue.front()->time;
+            Tick min = requestQueue.frontTime();
             
             if(min >= curTick){
                 scheduleArbitrationEvent(min + arbitrationDelay);
@@ -394,8 +353,8 @@ SplitTransBus::clearBlocked(int fromInterface){
         }
         
         if(pipelined){
-            if(!slaveRequestQueue->empty()){
-                Tick min = slaveRequestQueue->front()->time;
+            if(!slaveRequestQueue.empty()){
+                Tick min = slaveRequestQueue.frontTime();
                 if(min >= curTick){
                     scheduleArbitrationEvent(min + arbitrationDelay);
                 }
@@ -406,7 +365,7 @@ SplitTransBus::clearBlocked(int fromInterface){
         }
         
         if(!deliverQueue.empty()){
-            Tick min = deliverQueue.front()->grantTime;
+            Tick min = deliverQueue.frontTime();
             if(min >= curTick){
                 scheduleDeliverEvent(min + transferDelay);
             }
@@ -435,48 +394,25 @@ SplitTransBus::getChannelSample(){
 
 #ifdef DEBUG_SPLIT_TRANS_BUS
 
-void
-SplitTransBus::checkIfSorted(std::list<InterconnectRequest* >* inList){
-    /* check that the queue is sorted */
-    InterconnectRequest* prev = NULL;
-    bool first = true;
-    for(list<InterconnectRequest*>::iterator i=inList->begin();
-        i!=inList->end();
-        i++){
-            if(first){
-                first = false;
-                prev = *i;
-                continue;
-            }
-            
-            assert(prev->time <= (*i)->time);
-            prev = *i;
-    }
-}
-
 void
 SplitTransBus::printRequestQueue(){
     cout << "Request queue: ";
-    for(list<InterconnectRequest*>::iterator i = requestQueue.begin();
-        i != requestQueue.end();
-        i++){
+    for(int i=0;i<requestQueue.size();i++){
         cout << "(" 
-                << (*i)->fromID 
+                << requestQueue.at(i) 
                 << ", " 
-                << (*i)->time 
+                << requestQueue.timeAt(i) 
                 << ") ";
     }
     cout << "\n";
     
     if(pipelined){
         cout << "Slave request queue: ";
-        for(list<InterconnectRequest*>::iterator i = slaveRequestQueue->begin();
-            i != slaveRequestQueue->end();
-            i++){
+        for(int i=0;i<slaveRequestQueue.size();i++){
                 cout << "(" 
-                        << (*i)->fromID 
+                        << slaveRequestQueue.at(i) 
                         << ", " 
-                        << (*i)->time 
+                        << slaveRequestQueue.timeAt(i) 
                         << ") ";
         }
         cout << "\n";
@@ -486,15 +422,13 @@ SplitTransBus::printRequestQueue(){
 void
 SplitTransBus::printDeliverQueue(){
     cout << "Deliver queue: ";
-    for(list<InterconnectDelivery*>::iterator i = deliverQueue.begin();
-        i != deliverQueue.end();
-        i++){
+    for(int i=0;i<deliverQueue.size();i++){
             cout << "(" 
-                    << (*i)->fromID 
+                    << deliverQueue.at(i).fromID 
                     << ", " 
-                    << (*i)->toID 
+                    << deliverQueue.at(i).toID 
                     << ", " 
-                    << (*i)->grantTime 
+                    << deliverQueue.timeAt(i) 
                     << ") ";
     }
     cout << "\n";
@@ -7,8 +7,11 @@
 #include <queue>
 
 #include "interconnect.hh"
+#include "time_ordered_queue.hh"
 
+#ifndef NDEBUG
 #define DEBUG_SPLIT_TRANS_BUS
+#endif
 
 /**
 * This class implements a Split Transaction Bus interconnect. Here, all 
@@ -26,18 +29,27 @@ class SplitTransBus : public Interconnect
 {
     private:
 
-        std::list<InterconnectRequest* > requestQueue;
-        std::list<InterconnectDelivery* > deliverQueue;
+        /** A granted request waiting for the data bus */
+        struct PendingDelivery{
+            int fromID;
+            int toID;
+            MemReqPtr req;
+
+            PendingDelivery() : fromID(-1), toID(-1) {}
+        };
+
+        /* requesting interface IDs ordered by request time */
+        TimeOrderedQueue<int> requestQueue;
+
+        /* deliveries ordered by grant time */
+        TimeOrderedQueue<PendingDelivery> deliverQueue;
         
         /* in a pipelined, bi-directional bus we can issue one request 
            in each direction each clock cycle */
-        std::list<InterconnectRequest* >* slaveRequestQueue;
+        TimeOrderedQueue<int> slaveRequestQueue;
         
         bool pipelined;
         
-        void addToList(std::list<InterconnectRequest*>* inList,
-                       InterconnectRequest* icReq);
-        
         typedef enum{STB_MASTER, STB_SLAVE, STB_NOT_PIPELINED} grant_type;
         void grantInterface(grant_type gt, Tick cycle);
         
@@ -48,7 +60,6 @@ class SplitTransBus : public Interconnect
         int useCycleSample;
         
 #ifdef DEBUG_SPLIT_TRANS_BUS
-        void checkIfSorted(std::list<InterconnectRequest*>* inList);
         void printRequestQueue();
         void printDeliverQueue();
 #endif //DEBUG_SPLIT_TRANS_BUS
@@ -98,20 +109,6 @@ class SplitTransBus : public Interconnect
             
             doProfile = false;
             useCycleSample = 0;
-            
-            if(pipelined){
-                slaveRequestQueue = new std::list<InterconnectRequest*>;
-            }
-        }
-        
-        /**
-        * Default destructor. Deletes the dynamically allocated
-        * slaveRequestQueue if the bus is pipelined.
-        */
-        ~SplitTransBus(){
-            if(pipelined){
-                delete slaveRequestQueue;
-            }
         }
         
         /**
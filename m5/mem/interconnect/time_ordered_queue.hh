@@ -0,0 +1,116 @@
+/*
+ * time_ordered_queue.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef TIME_ORDERED_QUEUE_HH_
+#define TIME_ORDERED_QUEUE_HH_
+
+#include <cassert>
+#include <vector>
+
+#include "sim/host.hh"
+
+/**
+* A queue of values ordered by timestamp, used for the request and
+* delivery queues of the interconnects.
+*
+* Entries are stored by value in a ring buffer, so pushing and popping
+* do not allocate once the buffer has reached its working size. An
+* entry is inserted after all entries with the same or an earlier
+* timestamp. Interfaces mostly push in time order, so the insertion
+* point is found at the back of the queue and the push is constant
+* time. Entries with equal timestamps leave the queue in the order
+* they were pushed.
+*
+* If a maximum size is given, pushing to a full queue is an error.
+*
+* @author Magnus Jahre
+*/
+template <class T>
+class TimeOrderedQueue
+{
+    private:
+        struct Node
+        {
+            Tick time;
+            T value;
+
+            Node() : time(0), value() {}
+        };
+
+        std::vector<Node> ring;
+        int head;
+        int count;
+        int maxSize;
+
+        int index(int i) const {
+            return (head + i) & (ring.size() - 1);
+        }
+
+        void grow(){
+            std::vector<Node> old(ring.size() * 2);
+            for(int i=0;i<count;i++) old[i] = ring[index(i)];
+            ring.swap(old);
+            head = 0;
+        }
+
+    public:
+        TimeOrderedQueue(int _maxSize = 0)
+            : ring(16), head(0), count(0), maxSize(_maxSize)
+        {
+        }
+
+        bool empty() const { return count == 0; }
+
+        int size() const { return count; }
+
+        bool full() const { return maxSize > 0 && count >= maxSize; }
+
+        void push(Tick time, const T &value){
+            assert(!full());
+            if(count == ring.size()) grow();
+
+            int pos = count;
+            while(pos > 0 && ring[index(pos-1)].time > time){
+                ring[index(pos)] = ring[index(pos-1)];
+                pos--;
+            }
+            ring[index(pos)].time = time;
+            ring[index(pos)].value = value;
+            count++;
+        }
+
+        T &front(){
+            assert(count > 0);
+            return ring[head].value;
+        }
+
+        Tick frontTime() const {
+            assert(count > 0);
+            return ring[head].time;
+        }
+
+        void pop(){
+            assert(count > 0);
+            // release the value, it might hold a reference
+            ring[head] = Node();
+            head = index(1);
+            count--;
+        }
+
+        /* Walking the queue from the front */
+        const T &at(int i) const { return ring[index(i)].value; }
+        Tick timeAt(int i) const { return ring[index(i)].time; }
+
+        bool isSorted() const {
+            for(int i=1;i<count;i++){
+                if(timeAt(i-1) > timeAt(i)) return false;
+            }
+            return true;
+        }
+};
+
+#endif /* TIME_ORDERED_QUEUE_HH_ */
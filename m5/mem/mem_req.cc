@@ -192,10 +192,7 @@ buildReqCopy(const MemReqPtr & r, int cpuCount, MemCmdEnum newCommand)
 	}
 
 	if(r->presentFlags != NULL){
-		req->presentFlags = new bool[cpuCount];
-		for(int i=0;i<cpuCount;i++){
-			req->presentFlags[i] = r->presentFlags[i];
-		}
+		req->presentFlags = new SharerSet(*r->presentFlags);
 	}
 
 	req->cmd = newCommand;
@@ -300,10 +297,7 @@ copyRequest(MemReqPtr & to, const MemReqPtr & from, int cpuCount)
 	}
 
 	if(from->presentFlags != NULL){
-		to->presentFlags = new bool[cpuCount];
-		for(int i=0;i<cpuCount;i++){
-			to->presentFlags[i] = from->presentFlags[i];
-		}
+		to->presentFlags = new SharerSet(*from->presentFlags);
 	}
 }
 
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "mem/mem_cmd.hh"
+#include "mem/cache/coherence/sharer_set.hh"
 
 #include "base/fast_alloc.hh"
 #include "base/refcnt.hh"
@@ -169,7 +170,7 @@ class MemReq : public FastAlloc, public RefCounted
 
     /** Data space for directory messages */
     int owner;
-    bool* presentFlags;
+    SharerSet* presentFlags;
     bool dirACK;
     bool dirNACK;
     bool writeMiss;
@@ -41,6 +41,9 @@
 #if defined(USE_LZSS_COMPRESSION)
 #include "base/compression/lzss_compression.hh"
 #endif
+#if defined(USE_BDI_COMPRESSION)
+#include "base/compression/bdi_compression.hh"
+#endif
 
 #include "mem/cache/cache.hh"
 #include "mem/cache/coherence/simple_coherence.hh"
@@ -71,6 +74,7 @@
 
 #include "mem/memory_interface_impl.hh"
 #include "mem/timing/simple_mem_bank.hh"
+#include "mem/timing/ddr_mem_bank.hh"
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
@@ -78,6 +82,7 @@ template class  MemoryInterface<SimpleMemBank<NullCompression> >;
 #if defined(USE_LZSS_COMPRESSION)
 template class  MemoryInterface<SimpleMemBank<LZSSCompression> >;
 #endif
+template class  MemoryInterface<DDRMemBank>;
 
 #if defined(USE_CACHE_FALRU)
 template class  MemoryInterface<Cache<CacheTags<FALRU,NullCompression>, BlockingBuffer, SimpleCoherence> >;
@@ -103,6 +108,12 @@ template class  MemoryInterface<Cache<CacheTags<IIC,LZSSCompression>, BlockingBu
 template class  MemoryInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, SimpleCoherence> >;
 template class  MemoryInterface<Cache<CacheTags<IIC,LZSSCompression>, MissQueue, UniCoherence> >;
 #endif
+#if defined(USE_BDI_COMPRESSION)
+template class  MemoryInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, SimpleCoherence> >;
+template class  MemoryInterface<Cache<CacheTags<IIC,BDICompression>, BlockingBuffer, UniCoherence> >;
+template class  MemoryInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, SimpleCoherence> >;
+template class  MemoryInterface<Cache<CacheTags<IIC,BDICompression>, MissQueue, UniCoherence> >;
+#endif
 #endif
 
 #if defined(USE_CACHE_LRU)
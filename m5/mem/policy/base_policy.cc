@@ -7,6 +7,7 @@
 
 #include "base_policy.hh"
 #include "base/intmath.hh"
+#include "mem/accounting/private_mode_reference.hh"
 
 #include <cmath>
 
@@ -115,6 +116,7 @@ BasePolicy::BasePolicy(string _name,
 	enableOccupancyTrace = false;
 
 	asmPrivateModeSlowdownEsts.resize(cpuCount, 0.0);
+	pendingPrivateModeSamples.resize(cpuCount, PrivateModeSample());
 
 	BasePolicyInitEvent* init = new BasePolicyInitEvent(this);
 	init->schedule(curTick);
@@ -166,6 +168,18 @@ BasePolicy::regStats(){
 		.desc("Relative shared latency errors (in %)")
 		.flags(total);
 
+	privateModeLatencyRelError
+		.init(cpuCount)
+		.name(name() + ".private_mode_latency_rel_error")
+		.desc("Relative private mode latency errors against the private mode reference (in %)")
+		.flags(total);
+
+	privateModeIPCRelError
+		.init(cpuCount)
+		.name(name() + ".private_mode_ipc_rel_error")
+		.desc("Relative alone IPC errors against the private mode reference (in %)")
+		.flags(total);
+
 }
 
 void
@@ -1134,6 +1148,14 @@ BasePolicy::updatePrivPerfEst(int cpuID,
 		data.push_back(sharedLLCMeasurements.accesses);
 		data.push_back(sharedLLCMeasurements.writebacks);
 
+		if(intManager->getPrivateModeReference() != NULL){
+			PrivateModeSample sample;
+			sample.valid = true;
+			sample.aloneIPCEstimate = aloneIPCEstimate;
+			sample.privateLatencyEstimate = avgPrivateLatEstimate;
+			updatePrivateModeErrors(cpuID, sample);
+		}
+
 		// Update values needed for cache partitioning policy
 		aloneIPCEstimates[cpuID] = aloneIPCEstimate;
 		sharedCPLMeasurements[cpuID] = ols.tableCPL;
@@ -1189,6 +1211,35 @@ BasePolicy::updatePrivPerfEst(int cpuID,
 	comInstModelTraces[cpuID].addTrace(data);
 }
 
+void
+BasePolicy::updatePrivateModeErrors(int cpuID, PrivateModeSample sample){
+
+	// The reference result belongs to the previous sample of this CPU
+	PrivateModeReference::Result reference = intManager->getPrivateModeReference()->sample(cpuID, comInstModelTraceCummulativeInst[cpuID]);
+	PrivateModeSample previous = pendingPrivateModeSamples[cpuID];
+	pendingPrivateModeSamples[cpuID] = sample;
+
+	if(!previous.valid || !reference.valid) return;
+
+	DPRINTF(MissBWPolicy, "CPU %d - Private mode reference: latency %f (estimate %f), IPC %f (estimate %f), %d hits, %d misses\n",
+			cpuID,
+			reference.avgLatency,
+			previous.privateLatencyEstimate,
+			reference.aloneIPC,
+			previous.aloneIPCEstimate,
+			reference.hits,
+			reference.misses);
+
+	if(reference.reads > 0){
+		privateModeLatencyRelError[cpuID].sample(computeError(previous.privateLatencyEstimate, reference.avgLatency));
+	}
+
+	// No alone mode trace or it ended before this sample
+	if(reference.aloneIPC > 0){
+		privateModeIPCRelError[cpuID].sample(computeError(previous.aloneIPCEstimate, reference.aloneIPC));
+	}
+}
+
 double
 BasePolicy::estimateWriteStallCycles(double writeStall, double avgPrivmodeLat, int numWriteStalls, double avgSharedmodeLat){
 	if(writeStallTech == WS_NONE){
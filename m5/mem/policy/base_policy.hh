@@ -178,6 +178,21 @@ protected:
 
 	std::vector<double> asmPrivateModeSlowdownEsts;
 
+	class PrivateModeSample{
+	public:
+		bool valid;
+		double aloneIPCEstimate;
+		double privateLatencyEstimate;
+
+		PrivateModeSample(){
+			valid = false;
+			aloneIPCEstimate = 0.0;
+			privateLatencyEstimate = 0.0;
+		}
+	};
+
+	std::vector<PrivateModeSample> pendingPrivateModeSamples;
+
 	PerformanceMeasurement* currentMeasurements;
 
 	int maxMSHRs;
@@ -212,6 +227,11 @@ protected:
 	Stats::VectorStandardDeviation<> requestRelError;
 	Stats::VectorStandardDeviation<> sharedLatencyRelError;
 
+	Stats::VectorStandardDeviation<> privateModeLatencyRelError;
+	Stats::VectorStandardDeviation<> privateModeIPCRelError;
+
+	void updatePrivateModeErrors(int cpuID, PrivateModeSample sample);
+
 	void regStats();
 
 	double computeError(double estimate, double actual);
@@ -27,12 +27,11 @@ public:
 
 	virtual double computeMetric(std::vector<double>* speedups, std::vector<double>* sharedIPCs);
 
-	virtual std::vector<double> gradient(PerformanceMeasurement* measurements, std::vector<double> aloneCycles, int np, std::vector<double> point){
+	virtual void gradient(PerformanceMeasurement* measurements, const std::vector<double>& aloneCycles, int np, const std::vector<double>& point, std::vector<double>& gradient){
 		fatal("Metric has not implemented gradient");
-	    return std::vector<double>();
 	}
 
-	virtual double computeFunction(PerformanceMeasurement* measurements, std::vector<double> xvals, std::vector<double> aloneCycles){
+	virtual double computeFunction(PerformanceMeasurement* measurements, const std::vector<double>& xvals, const std::vector<double>& aloneCycles){
 		fatal("Metric has not implemented computeFunction");
 		return 0.0;
 	}
@@ -18,10 +18,10 @@ STPPolicy::computeMetric(std::vector<double>* speedups, std::vector<double>* sha
 	return sum;
 }
 
-std::vector<double>
-STPPolicy::gradient(PerformanceMeasurement* measurements, std::vector<double> aloneCycles, int np, std::vector<double> point){
+void
+STPPolicy::gradient(PerformanceMeasurement* measurements, const std::vector<double>& aloneCycles, int np, const std::vector<double>& point, std::vector<double>& gradient){
 	assert(point.size() == np*2);
-	vector<double> gradient = vector<double>(np*2, 0.0);
+	gradient.resize(np*2, 0.0);
 
 	// bandwidth components
 	for(int i=0;i<np;i++){
@@ -61,13 +61,10 @@ STPPolicy::gradient(PerformanceMeasurement* measurements, std::vector<double> al
 			}
 		}
 	}
-
-
-	return gradient;
 }
 
 double
-STPPolicy::computeFunction(PerformanceMeasurement* measurements, std::vector<double> xvals, std::vector<double> aloneCycles){
+STPPolicy::computeFunction(PerformanceMeasurement* measurements, const std::vector<double>& xvals, const std::vector<double>& aloneCycles){
 	double funcval = 0.0;
 
 	assert(xvals.size() == aloneCycles.size()*2);
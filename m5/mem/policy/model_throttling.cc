@@ -6,8 +6,7 @@
  */
 
 #include "model_throttling.hh"
-
-#include "lp_lib.h"
+#include "base/time.hh"
 
 #define SEARCH_DECIMALS 12
 #define METRIC_DECIMALS 4
@@ -43,6 +42,14 @@ ModelThrottlingPolicy::ModelThrottlingPolicy(std::string _name,
 
 	predictedCPI.resize(_cpuCount, 0.0);
 
+	searchPoint.resize(2*_cpuCount, 0.0);
+	trialPoint.resize(2*_cpuCount, 0.0);
+	stepPoint.resize(2*_cpuCount, 0.0);
+	searchGradient.resize(2*_cpuCount, 0.0);
+	lowerBounds.resize(2*_cpuCount, 0.0);
+	upperBounds.resize(2*_cpuCount, 0.0);
+	gradientOrder.resize(_cpuCount, 0);
+
 	modelValueTrace = RequestTrace(_name, "ModelValueTrace");
 	initModelValueTrace(_cpuCount);
 
@@ -118,8 +125,39 @@ ModelThrottlingPolicy::doEvaluation(int cpuID){
 	return false;
 }
 
+void
+ModelThrottlingPolicy::regStats(){
+	using namespace Stats;
+
+	BasePolicy::regStats();
+
+	optimizerRuns
+		.name(name() + ".optimizer_runs")
+		.desc("Number of times the optimal allocation was searched for");
+
+	optimizerIterations
+		.name(name() + ".optimizer_iterations")
+		.desc("Number of search iterations");
+
+	optimizerMicroseconds
+		.name(name() + ".optimizer_host_microseconds")
+		.desc("Host time spent searching for the optimal allocation (in us)");
+
+	avgOptimizerMicroseconds
+		.name(name() + ".avg_optimizer_host_microseconds")
+		.desc("Average host time per search (in us)");
+
+	avgOptimizerMicroseconds = optimizerMicroseconds / optimizerRuns;
+
+	avgOptimizerIterations
+		.name(name() + ".avg_optimizer_iterations")
+		.desc("Average number of iterations per search");
+
+	avgOptimizerIterations = optimizerIterations / optimizerRuns;
+}
+
 double
-ModelThrottlingPolicy::checkConvergence(std::vector<double> xstar, std::vector<double> xvec, std::vector<double> gradient){
+ModelThrottlingPolicy::checkConvergence(const std::vector<double>& xstar, const std::vector<double>& xvec, const std::vector<double>& gradient){
 	double xvecval = 0.0;
 	for(int i=0;i<xvec.size();i++) xvecval += gradient[i]*xvec[i];
 
@@ -138,101 +176,123 @@ ModelThrottlingPolicy::checkConvergence(std::vector<double> xstar, std::vector<d
 	return xstarval > xvecval;
 }
 
-std::vector<double>
-ModelThrottlingPolicy::findNewTrialPoint(std::vector<double> gradient, PerformanceMeasurement* measurements){
-	lprec *lp;
-
-	if ((lp = make_lp(0,cpuCount*2)) == NULL) fatal("Couldn't create LP");
-	set_outputfile(lp, (char*) "lp-trace.txt");
-
-	REAL* rowbuffer = (REAL*) malloc((cpuCount*2+1)*sizeof(REAL));
-	for(int i=0;i<=cpuCount*2;i++) rowbuffer[i] = 0.0;
-
-	// sum of bandwidth shares must be less than 1.0
-	for(int i=1;i<=cpuCount;i++) rowbuffer[i] = 1.0;
-	if (!add_constraint(lp, rowbuffer, LE, 1.0)) fatal("Couldn't add sum constraint");
-
-	// ad starvation constraints and upper bounds
-	for(int i=1;i<=cpuCount;i++) rowbuffer[i] = 0.0;
-	for(int i=1;i<=cpuCount;i++){
+bool
+ModelThrottlingPolicy::updateBounds(PerformanceMeasurement* measurements){
+	double lowsum = 0.0;
+	for(int i=0;i<cpuCount;i++){
 
-		double thisMaxBW = (double) measurements->perCoreCacheMeasurements[i-1].readMisses / (double) aloneCycles[i-1];
+		double thisMaxBW = (double) measurements->perCoreCacheMeasurements[i].readMisses / (double) aloneCycles[i];
 		double upbo = thisMaxBW / measurements->maxReadRequestRate;
 
+		// starvation constraint
 		double lowbo = 0.05;
 		if(lowbo > upbo){
 			upbo = lowbo;
 		}
 
-		// starvation constraint
-		rowbuffer[i-1] = 0.0;
-		rowbuffer[i] = 1.0;
-		if (!add_constraint(lp, rowbuffer, GE, lowbo)) fatal("Couldn't add starvation constraint");
+		lowerBounds[i] = lowbo;
+		upperBounds[i] = upbo;
+		lowsum += lowbo;
 
-		// upper bound
-		set_upbo(lp, i, upbo);
+		lowerBounds[i+cpuCount] = 1.0;
+		upperBounds[i+cpuCount] = SHARED_CACHE_WAYS - (cpuCount - 1);
 	}
 
-	// set cache sum constraint
-	for(int i=0;i<=cpuCount*2;i++) rowbuffer[i] = 0.0;
-	for(int i=cpuCount+1;i<=cpuCount*2;i++){
-		rowbuffer[i] = 1.0;
-	}
-	if (!add_constraint(lp, rowbuffer, LE, SHARED_CACHE_WAYS)) fatal("Couldn't add cache sum constraint");
+	return lowsum <= 1.0 && cpuCount <= SHARED_CACHE_WAYS;
+}
 
-	for(int i=cpuCount+1;i<=cpuCount*2;i++){
-		set_lowbo(lp, i , 1.0);
-	}
+void
+ModelThrottlingPolicy::findWarmStartPoint(const std::vector<double>& fairShare){
 
-	// set objective function
-    for(int i=1;i<=cpuCount*2;i++){
-    	rowbuffer[i] = gradient[i-1];
-    }
-    set_obj_fn(lp, rowbuffer);
+	if(warmStartPoint.empty()){
+		searchPoint = fairShare;
+		return;
+	}
 
-    set_maxim(lp);
+	// Start from the previous optimum moved inside the current bounds
+	double bwsum = 0.0;
+	double waysum = 0.0;
+	for(int i=0;i<cpuCount*2;i++){
+		double x = warmStartPoint[i];
+		if(x < lowerBounds[i]) x = lowerBounds[i];
+		if(x > upperBounds[i]) x = upperBounds[i];
+		searchPoint[i] = x;
 
-    print_lp(lp);
+		if(i < cpuCount) bwsum += x;
+		else waysum += x;
+	}
 
-    int ret = solve(lp);
-    if(ret != OPTIMAL){
-    	warn("Linear programming solver returned non-optimal result (Code %d)", ret);
-    	return vector<double>();
-    }
+	if(bwsum > 1.0 || waysum > SHARED_CACHE_WAYS){
+		DPRINTF(MissBWPolicyExtra, "Previous optimum is not feasible, starting from fair share\n");
+		searchPoint = fairShare;
+	}
+}
 
-    vector<double> retval = vector<double>(cpuCount*2, 0.0);
+void
+ModelThrottlingPolicy::findNewTrialPoint(const std::vector<double>& gradient, std::vector<double>& xstar){
+
+	// The trial point maximizes the gradient over the feasible region. Since
+	// the only coupling constraints are the bandwidth and cache sums, every
+	// core gets its lower bound and the rest is handed out in order of
+	// decreasing gradient.
+	double bwLeft = 1.0;
+	double waysLeft = SHARED_CACHE_WAYS;
+	for(int i=0;i<cpuCount;i++){
+		xstar[i] = lowerBounds[i];
+		bwLeft -= lowerBounds[i];
 
-    // retrieve bandwidth allocations
-    for(int i=0;i<cpuCount;i++){
-    	retval[i] = get_var_primalresult(lp, i+2);
-    }
+		xstar[i+cpuCount] = lowerBounds[i+cpuCount];
+		waysLeft -= lowerBounds[i+cpuCount];
+	}
+	assert(bwLeft >= 0.0 && waysLeft >= 0.0);
 
-    // retrieve cache allocations
-    for(int i=0;i<cpuCount;i++){
-    	retval[i+cpuCount] = get_var_primalresult(lp, 3+i+cpuCount*2);
-    }
+	for(int i=0;i<cpuCount;i++){
+		int j = i;
+		while(j > 0 && gradient[gradientOrder[j-1]] < gradient[i]){
+			gradientOrder[j] = gradientOrder[j-1];
+			j--;
+		}
+		gradientOrder[j] = i;
+	}
 
-    traceVerboseVector("xstar is: ", retval);
+	for(int k=0;k<cpuCount && bwLeft > 0.0;k++){
+		int i = gradientOrder[k];
+		if(gradient[i] <= 0.0) break;
 
-    print_solution(lp, 2);
+		double add = upperBounds[i] - xstar[i];
+		if(add > bwLeft) add = bwLeft;
+		xstar[i] += add;
+		bwLeft -= add;
+	}
 
-    free(rowbuffer);
-    delete_lp(lp);
+	// the cache allocations are only bounded by the sum
+	int best = -1;
+	for(int i=cpuCount;i<cpuCount*2;i++){
+		if(gradient[i] > 0.0 && (best == -1 || gradient[i] > gradient[best])){
+			best = i;
+		}
+	}
+	if(best != -1) xstar[best] += waysLeft;
 
-	return retval;
+	traceVerboseVector("xstar is: ", xstar);
 }
 
-std::vector<double>
-ModelThrottlingPolicy::addMultCons(std::vector<double> xvec, std::vector<double> xstar, double step){
-	vector<double> outvec = vector<double>(xvec.size(), 0.0);
+void
+ModelThrottlingPolicy::addMultCons(const std::vector<double>& xvec, const std::vector<double>& xstar, double step, std::vector<double>& outvec){
+	assert(outvec.size() == xvec.size());
 	for(int i=0;i<outvec.size();i++){
 		outvec[i] = xvec[i] + step*(xstar[i] - xvec[i]);
 	}
-	return outvec;
 }
 
 double
-ModelThrottlingPolicy::findOptimalStepSize(std::vector<double> xvec, std::vector<double> xstar, PerformanceMeasurement* measurements){
+ModelThrottlingPolicy::evaluateStep(const std::vector<double>& xvec, const std::vector<double>& xstar, double step, PerformanceMeasurement* measurements){
+	addMultCons(xvec, xstar, step, stepPoint);
+	return performanceMetric->computeFunction(measurements, stepPoint, aloneCycles);
+}
+
+double
+ModelThrottlingPolicy::findOptimalStepSize(const std::vector<double>& xvec, const std::vector<double>& xstar, PerformanceMeasurement* measurements){
 
 	double step = 0.0001;
 	double stepsize = 0.0001;
@@ -242,7 +302,7 @@ ModelThrottlingPolicy::findOptimalStepSize(std::vector<double> xvec, std::vector
 	double maxval = 0.0;
 
 	while(step <= endval){
-		double curval = performanceMetric->computeFunction(measurements, addMultCons(xvec, xstar, step), aloneCycles);
+		double curval = evaluateStep(xvec, xstar, step, measurements);
 		if(curval > maxval){
 			maxval = curval;
 			maxstep = step;
@@ -261,15 +321,15 @@ ModelThrottlingPolicy::setPrecision(double number, int decimalPlaces){
 }
 
 double
-ModelThrottlingPolicy::fastFindOptimalStepSize(std::vector<double> xvec, std::vector<double> xstar, PerformanceMeasurement* measurements){
+ModelThrottlingPolicy::fastFindOptimalStepSize(const std::vector<double>& xvec, const std::vector<double>& xstar, PerformanceMeasurement* measurements){
 	double precision = 0.00000001;
 	double xl = precision;
 	double xr = 1.0;
 	double x1 = xl + (xr - xl - precision)/2;
 	double x2 = xl + (xr - xl + precision)/2;
 
-	double x1val = setPrecision(performanceMetric->computeFunction(measurements, addMultCons(xvec, xstar, x1), aloneCycles), SEARCH_DECIMALS);
-	double x2val = setPrecision(performanceMetric->computeFunction(measurements, addMultCons(xvec, xstar, x2), aloneCycles), SEARCH_DECIMALS);
+	double x1val = setPrecision(evaluateStep(xvec, xstar, x1, measurements), SEARCH_DECIMALS);
+	double x2val = setPrecision(evaluateStep(xvec, xstar, x2, measurements), SEARCH_DECIMALS);
 
 	DPRINTF(MissBWPolicyExtra, "Initial: x1=%f, x2=%f, x1val=%f, x2val=%f\n", x1, x2, x1val, x2val);
 
@@ -286,8 +346,8 @@ ModelThrottlingPolicy::fastFindOptimalStepSize(std::vector<double> xvec, std::ve
 
 		x1 = xl + (xr - xl - precision)/2;
 		x2 = xl + (xr - xl + precision)/2;
-		x1val = setPrecision(performanceMetric->computeFunction(measurements, addMultCons(xvec, xstar, x1), aloneCycles), SEARCH_DECIMALS);
-		x2val = setPrecision(performanceMetric->computeFunction(measurements, addMultCons(xvec, xstar, x2), aloneCycles), SEARCH_DECIMALS);
+		x1val = setPrecision(evaluateStep(xvec, xstar, x1, measurements), SEARCH_DECIMALS);
+		x2val = setPrecision(evaluateStep(xvec, xstar, x2, measurements), SEARCH_DECIMALS);
 
 		DPRINTF(MissBWPolicyExtra, "x1=%f, x2=%f, x1val=%f, x2val=%f\n", x1, x2, x1val, x2val);
 
@@ -306,50 +366,54 @@ ModelThrottlingPolicy::fastFindOptimalStepSize(std::vector<double> xvec, std::ve
 std::vector<double>
 ModelThrottlingPolicy::findOptimalArrivalRates(PerformanceMeasurement* measurements){
 
-	measurements->updateConstants();
+	Time startTime(true);
+	optimizerRuns++;
 
-	vector<double> xvals = vector<double>(cpuCount*2, 1.0 / (double) cpuCount);
-	for(int i=cpuCount;i<2*cpuCount;i++) xvals[i] = (double) ((double) SHARED_CACHE_WAYS / (double) cpuCount);
+	measurements->updateConstants();
 
-	vector<double> fairShare = xvals;
+	vector<double> fairShare = vector<double>(cpuCount*2, 1.0 / (double) cpuCount);
+	for(int i=cpuCount;i<2*cpuCount;i++) fairShare[i] = (double) ((double) SHARED_CACHE_WAYS / (double) cpuCount);
 
-	vector<double> xstar = vector<double>(cpuCount*2, 0.0);
+	bool feasible = updateBounds(measurements);
+	findWarmStartPoint(fairShare);
+	for(int i=0;i<trialPoint.size();i++) trialPoint[i] = 0.0;
 
-	traceVector("Initial xvector is: ", xvals);
+	traceVector("Initial xvector is: ", searchPoint);
 
-	vector<double> thisGradient = performanceMetric->gradient(measurements, aloneCycles, cpuCount, xvals);
+	performanceMetric->gradient(measurements, aloneCycles, cpuCount, searchPoint, searchGradient);
 
-	traceVector("Initial gradient is: ", thisGradient);
+	traceVector("Initial gradient is: ", searchGradient);
 
 	double gradsum = 0;
-	for(int i=0;i<thisGradient.size();i++) gradsum += thisGradient[i];
+	for(int i=0;i<searchGradient.size();i++) gradsum += searchGradient[i];
 	if(gradsum == 0){
 		DPRINTF(MissBWPolicy, "All gradient values are zero, fair share allocation\n");
+		optimizerMicroseconds += (Counter) ((Time(true) - startTime)() * 1000000.0);
 		return fairShare;
 	}
 
+	if(!feasible){
+		warn("Allocation problem has no feasible solution, returning fair share\n");
+		searchPoint = fairShare;
+	}
 
-	if(doVerification) traceSearch(xvals);
+	if(doVerification) traceSearch(searchPoint);
 	int cutoff = 0;
 	bool quitForCutoff = false;
 
-	while(checkConvergence(xstar, xvals, thisGradient) && !quitForCutoff){
-		thisGradient = performanceMetric->gradient(measurements, aloneCycles, cpuCount, xvals);
-		traceVerboseVector("New gradient is: ", thisGradient);
-		xstar = findNewTrialPoint(thisGradient, measurements);
-		if(xstar.empty()){
-			warn("Linear programming problem not solved optimally, returning initial solution\n");
-			xvals = vector<double>(cpuCount, 1.0 / (double) cpuCount);
-			break;
-		}
+	while(feasible && checkConvergence(trialPoint, searchPoint, searchGradient) && !quitForCutoff){
+		performanceMetric->gradient(measurements, aloneCycles, cpuCount, searchPoint, searchGradient);
+		traceVerboseVector("New gradient is: ", searchGradient);
+		findNewTrialPoint(searchGradient, trialPoint);
 
-		//double stepsize = findOptimalStepSize(xvals, xstar, measurements);
-		double stepsize = fastFindOptimalStepSize(xvals, xstar, measurements);
-		xvals = addMultCons(xvals, xstar, stepsize);
-		traceVerboseVector("New xvector is: ", xvals);
+		//double stepsize = findOptimalStepSize(searchPoint, trialPoint, measurements);
+		double stepsize = fastFindOptimalStepSize(searchPoint, trialPoint, measurements);
+		addMultCons(searchPoint, trialPoint, stepsize, searchPoint);
+		traceVerboseVector("New xvector is: ", searchPoint);
 
-		if(doVerification) traceSearch(xvals);
+		if(doVerification) traceSearch(searchPoint);
 
+		optimizerIterations++;
 		cutoff++;
 		if(cutoff > 5000){
 			warn("Linear programming technique solution did not converge\n");
@@ -357,6 +421,11 @@ ModelThrottlingPolicy::findOptimalArrivalRates(PerformanceMeasurement* measureme
 		}
 	}
 
+	if(feasible) warmStartPoint = searchPoint;
+	vector<double> xvals = searchPoint;
+
+	optimizerMicroseconds += (Counter) ((Time(true) - startTime)() * 1000000.0);
+
 	traceVector("Optimal solution vector is: ", xvals);
 
 	double maxbw = measurements->maxReadRequestRate + measurements->getUncontrollableMissReqRate();
@@ -29,6 +29,22 @@ private:
 
 	bool doVerification;
 
+	// Optimizer state, sized in the constructor and reused every period
+	std::vector<double> warmStartPoint;
+	std::vector<double> searchPoint;
+	std::vector<double> trialPoint;
+	std::vector<double> stepPoint;
+	std::vector<double> searchGradient;
+	std::vector<double> lowerBounds;
+	std::vector<double> upperBounds;
+	std::vector<int> gradientOrder;
+
+	Stats::Scalar<> optimizerRuns;
+	Stats::Scalar<> optimizerIterations;
+	Stats::Scalar<> optimizerMicroseconds;
+	Stats::Formula avgOptimizerMicroseconds;
+	Stats::Formula avgOptimizerIterations;
+
 	enum BWImplStrat{
 		BW_IMPL_NFQ,
 		BW_IMPL_THROTTLE,
@@ -60,18 +76,23 @@ public:
 
 	virtual bool doEvaluation(int cpuID);
 
+	void regStats();
+
 private:
 
-	std::vector<double> findNewTrialPoint(std::vector<double> gradient, PerformanceMeasurement* measurements);
+	bool updateBounds(PerformanceMeasurement* measurements);
+	void findWarmStartPoint(const std::vector<double>& fairShare);
+	void findNewTrialPoint(const std::vector<double>& gradient, std::vector<double>& xstar);
 
 	void implementAllocation(std::vector<double> allocation, double writeRate);
 	std::vector<double> findOptimalArrivalRates(PerformanceMeasurement* measurements);
 
-	double findOptimalStepSize(std::vector<double> xvec, std::vector<double> xstar, PerformanceMeasurement* measurements);
-	double fastFindOptimalStepSize(std::vector<double> xvec, std::vector<double> xstar, PerformanceMeasurement* measurements);
+	double findOptimalStepSize(const std::vector<double>& xvec, const std::vector<double>& xstar, PerformanceMeasurement* measurements);
+	double fastFindOptimalStepSize(const std::vector<double>& xvec, const std::vector<double>& xstar, PerformanceMeasurement* measurements);
 	double setPrecision(double number, int decimalPlaces);
 
-	std::vector<double> addMultCons(std::vector<double> xvec, std::vector<double> xstar, double step);
+	void addMultCons(const std::vector<double>& xvec, const std::vector<double>& xstar, double step, std::vector<double>& outvec);
+	double evaluateStep(const std::vector<double>& xvec, const std::vector<double>& xstar, double step, PerformanceMeasurement* measurements);
 
 	void initThrottleTrace(int np);
 	void traceThrottling(std::vector<double> allocation, std::vector<double> throttles, double writeRate);
@@ -86,7 +107,7 @@ private:
 
 	double getTotalMisses(int cpuid, PerformanceMeasurement* measurements);
 
-	double checkConvergence(std::vector<double> xstar, std::vector<double> xvec, std::vector<double> gradient);
+	double checkConvergence(const std::vector<double>& xstar, const std::vector<double>& xvec, const std::vector<double>& gradient);
 
 	void fixCacheAllocations();
 
@@ -0,0 +1,38 @@
+/*
+ * address_mapping.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include "base/intmath.hh"
+#include "base/misc.hh"
+#include "mem/timing/address_mapping.hh"
+
+using namespace std;
+
+AddressMapping::AddressMapping()
+    : pageBits(0), numBanks(1), bankBits(0), bankShift(0),
+      xorHash(false), linear(true)
+{
+}
+
+void
+AddressMapping::init(const string &name, int page_bits, int num_banks,
+                     int interleave_bit, bool xor_hash)
+{
+    pageBits = page_bits;
+    numBanks = num_banks;
+    bankShift = interleave_bit < 0 ? page_bits : interleave_bit;
+    xorHash = xor_hash;
+    linear = bankShift == pageBits && !xorHash;
+
+    if (num_banks < 1)
+        fatal("%s: there must be at least one bank", name);
+
+    if (!linear && !IsPowerOf2(num_banks))
+        fatal("%s: block interleaving and XOR bank hashing need a power "
+              "of two number of banks, got %d", name, num_banks);
+
+    bankBits = FloorLog2(num_banks);
+}
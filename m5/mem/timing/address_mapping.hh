@@ -0,0 +1,100 @@
+/*
+ * address_mapping.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef __ADDRESS_MAPPING_HH__
+#define __ADDRESS_MAPPING_HH__
+
+#include <string>
+
+#include "targetarch/isa_traits.hh" // for Addr
+
+/**
+ * Maps physical addresses onto DRAM banks and pages (rows) within a
+ * memory channel.
+ *
+ * The bank index is the bit field that starts at the interleave bit.
+ * If the interleave bit equals the page size, consecutive pages go to
+ * consecutive banks. This is the original mapping. If the interleave
+ * bit is set to the cache block size, consecutive blocks go to
+ * consecutive banks. Optionally, the bank field is XORed with the low
+ * bits of the row (permutation based interleaving), so that rows that
+ * conflict in one bank are spread over all banks.
+ *
+ * Pages are identified by row * banks + bank field, which is unique
+ * over the whole channel. pageAddr() inverts page(), so the controller
+ * can keep page ids in activePages and rebuild an address that maps to
+ * the right bank when it issues Activate and Close commands.
+ */
+class AddressMapping
+{
+  private:
+    int pageBits;
+    int numBanks;
+    int bankBits;
+    int bankShift;
+    bool xorHash;
+
+    /** True for the original page interleaved mapping */
+    bool linear;
+
+    static Addr mask(int bits) { return ((Addr) 1 << bits) - 1; }
+
+  public:
+    AddressMapping();
+
+    /**
+     * @param page_bits log2 of the page size.
+     * @param num_banks The number of banks in the channel.
+     * @param interleave_bit The lowest bank index bit, -1 for page_bits.
+     * @param xor_hash XOR the bank index with the row.
+     */
+    void init(const std::string &name, int page_bits, int num_banks,
+              int interleave_bit, bool xor_hash);
+
+    Addr page(Addr addr) const;
+    Addr pageAddr(Addr page) const;
+    int bank(Addr addr) const;
+};
+
+inline Addr
+AddressMapping::page(Addr addr) const
+{
+    if (linear)
+        return addr >> pageBits;
+
+    Addr field = (addr >> bankShift) & mask(bankBits);
+    Addr rest = ((addr >> (bankShift + bankBits)) << bankShift)
+        | (addr & mask(bankShift));
+    return ((rest >> pageBits) << bankBits) | field;
+}
+
+inline Addr
+AddressMapping::pageAddr(Addr page) const
+{
+    if (linear)
+        return page << pageBits;
+
+    Addr field = page & mask(bankBits);
+    Addr rest = (page >> bankBits) << pageBits;
+    return ((rest >> bankShift) << (bankShift + bankBits))
+        | (field << bankShift) | (rest & mask(bankShift));
+}
+
+inline int
+AddressMapping::bank(Addr addr) const
+{
+    if (linear)
+        return (addr >> pageBits) % numBanks;
+
+    Addr p = page(addr);
+    Addr b = p & mask(bankBits);
+    if (xorHash)
+        b ^= (p >> bankBits) & mask(bankBits);
+    return b;
+}
+
+#endif // __ADDRESS_MAPPING_HH__
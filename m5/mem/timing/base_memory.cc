@@ -51,6 +51,16 @@ BaseMemory::BaseMemory(const std::string &name, HierParams *hier,
 
     assert(hier != NULL);
     bmCPUCount = hier->hpCpuCount;
+
+    //CPU frequency is 4GHz
+    Tick bus_to_cpu_factor = 4000 / params.bus_frequency;
+    burstLatency = params.data_time * bus_to_cpu_factor;
+    uncontendedHitLatency = params.CAS_latency * bus_to_cpu_factor
+        + burstLatency;
+    uncontendedClosedLatency = params.RAS_latency * bus_to_cpu_factor
+        + uncontendedHitLatency;
+    uncontendedConflictLatency = params.precharge_latency * bus_to_cpu_factor
+        + uncontendedClosedLatency;
 }
 
 void
@@ -274,3 +284,34 @@ BaseMemory::regStats()
     perCPUHitRate = perCPUPageHits / perCPURequests;
 
 }
+
+void
+BaseMemory::recordDRAMResult(DRAM_RESULT result, int latency, MemReqPtr &req)
+{
+    int cmd = (req->cmd == Read ? DRAM_READ : DRAM_WRITE);
+    int cpuID = req->adaptiveMHASenderID;
+
+    req->dramResult = result;
+
+    switch(result){
+    case DRAM_RESULT_CONFLICT:
+        if(cpuID != -1) perCPUPageConflicts[cpuID]++;
+        pageConflicts[cmd]++;
+        pageConflictLatency[cmd] += latency;
+        pageConflictLatencyDistribution[cmd].sample(latency);
+        break;
+    case DRAM_RESULT_HIT:
+        if(cpuID != -1) perCPUPageHits[cpuID]++;
+        pageHits[cmd]++;
+        pageHitLatency[cmd] += latency;
+        break;
+    case DRAM_RESULT_MISS:
+        if(cpuID != -1) perCPUPageMisses[cpuID]++;
+        pageMisses[cmd]++;
+        pageMissLatency[cmd] += latency;
+        pageMissLatencyDistribution[cmd].sample(latency);
+        break;
+    default:
+        fatal("Unknown DRAM result");
+    }
+}
@@ -37,12 +37,14 @@
 #ifndef __BASE_MEMORY_HH__
 #define __BASE_MEMORY_HH__
 
+#include <string>
 #include <vector>
 
 #include "config/full_system.hh"
 #include "mem/base_mem.hh"
 #include "base/statistics.hh"
 #include "mem/mem_req.hh" // For MemReqPtr
+#include "mem/timing/address_mapping.hh"
 
 class Bus;
 class FunctionalMemory;
@@ -80,6 +82,15 @@ class BaseMemory : public BaseMem
     int num_banks; // needs to be here for statistics allocation
     int bmCPUCount;
 
+    /** Uncontended read latencies in CPU cycles */
+    Tick uncontendedHitLatency;
+    Tick uncontendedClosedLatency;
+    Tick uncontendedConflictLatency;
+    Tick burstLatency;
+
+    /** Address to bank and page mapping, set up by the subclasses */
+    AddressMapping addrMap;
+
     // statistics
     /**
      * @addtogroup MemoryStatistics Memory Statistics
@@ -141,6 +152,12 @@ class BaseMemory : public BaseMem
     Stats::Formula perCPUMissRate;
     Stats::Formula perCPUHitRate;
 
+    /**
+     * Record the page hit/miss/conflict outcome of a read or write in
+     * the request and in the page statistics.
+     */
+    void recordDRAMResult(DRAM_RESULT result, int latency, MemReqPtr &req);
+
   public:
 
     /**
@@ -188,6 +205,22 @@ class BaseMemory : public BaseMem
 
     bool static_memory_latency;
 
+    /* DDR3/DDR4 timing engine params (bus cycles) */
+    std::string timing_model;
+    int num_ranks;
+    int num_bank_groups;
+    int CAS_to_CAS_long;
+    int row_to_row_long;
+    int write_to_read_long;
+    int four_activate_window;
+    int rank_to_rank_switch;
+    int refresh_interval;
+    int refresh_cycle_time;
+
+    /* Address mapping params */
+    int bank_interleave_bit;
+    bool xor_bank_hash;
+
     };
 
     /**
@@ -203,6 +236,35 @@ class BaseMemory : public BaseMem
      */
     void regStats();
 
+    Addr getPage(Addr addr)
+    {
+        return addrMap.page(addr);
+    }
+
+    Addr getPageAddr(Addr page)
+    {
+        return addrMap.pageAddr(page);
+    }
+
+    int getBank(Addr addr) const
+    {
+        return addrMap.bank(addr);
+    }
+
+    int getBankCount() const
+    {
+        return num_banks;
+    }
+
+    /**
+     * The uncontended latencies let models outside the memory controller,
+     * like the private mode reference, use the timing of this memory.
+     */
+    Tick getPageHitLatency() const { return uncontendedHitLatency; }
+    Tick getPageClosedLatency() const { return uncontendedClosedLatency; }
+    Tick getPageConflictLatency() const { return uncontendedConflictLatency; }
+    Tick getBurstLatency() const { return burstLatency; }
+
     /**
      * Dummy implementation.
      */
@@ -0,0 +1,367 @@
+/*
+ * ddr_mem_bank.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/trace.hh"
+#include "mem/bus/slave_interface.hh"
+#include "mem/mem_req.hh"
+#include "mem/timing/ddr_mem_bank.hh"
+
+#define STATIC_LATENCY 120
+
+using namespace std;
+
+/** Timestamp of a command that has never been issued */
+static const Tick Never = -((Tick) 1 << 50);
+
+DDRMemBank::DDRMemBank(const string &name, HierParams *hier,
+                       BaseMemory::Params params)
+    : BaseMemory(name, hier, params)
+{
+    num_ranks = params.num_ranks;
+    num_bank_groups = params.num_bank_groups;
+    pagesize = params.pagesize;
+
+    if (num_ranks < 1 || num_bank_groups < 1)
+        fatal("%s: there must be at least one rank and one bank group", name);
+    if (params.num_banks % num_bank_groups != 0)
+        fatal("%s: %d banks cannot be split into %d bank groups",
+              name, params.num_banks, num_bank_groups);
+
+    // num_banks is per rank in the configuration, but the controller
+    // sees all banks in the channel
+    num_banks = params.num_banks * num_ranks;
+    addrMap.init(name, pagesize, num_banks, params.bank_interleave_bit,
+                 params.xor_bank_hash);
+
+    active_bank_count = 0;
+    maximum_active_banks = params.max_active_bank_cnt * num_ranks;
+    returnStaticLatencies = params.static_memory_latency;
+
+    //CPU frequency is 4GHz
+    bus_to_cpu_factor = 4000 / params.bus_frequency;
+
+    tRCD = params.RAS_latency * bus_to_cpu_factor;
+    tCL = params.CAS_latency * bus_to_cpu_factor;
+    tCWL = params.write_latency * bus_to_cpu_factor;
+    tRP = params.precharge_latency * bus_to_cpu_factor;
+    tRAS = params.min_activate_to_precharge_latency * bus_to_cpu_factor;
+    tRTP = params.internal_read_to_precharge * bus_to_cpu_factor;
+    tWR = params.write_recovery_time * bus_to_cpu_factor;
+    tBURST = params.data_time * bus_to_cpu_factor;
+    tRTW = params.read_to_write_turnaround * bus_to_cpu_factor;
+    tRRD_S = params.internal_row_to_row * bus_to_cpu_factor;
+    tWTR_S = params.internal_write_to_read * bus_to_cpu_factor;
+    tFAW = params.four_activate_window * bus_to_cpu_factor;
+    tRTRS = params.rank_to_rank_switch * bus_to_cpu_factor;
+    tREFI = params.refresh_interval * bus_to_cpu_factor;
+    tRFC = params.refresh_cycle_time * bus_to_cpu_factor;
+
+    // Back-to-back bursts within a bank group are limited by tCCD_L,
+    // otherwise by the burst length. Unset long timings default to the
+    // short ones.
+    tCCD_S = tBURST;
+    tCCD_L = max(tCCD_S, (Tick) params.CAS_to_CAS_long * bus_to_cpu_factor);
+    tRRD_L = max(tRRD_S, (Tick) params.row_to_row_long * bus_to_cpu_factor);
+    tWTR_L = max(tWTR_S, (Tick) params.write_to_read_long * bus_to_cpu_factor);
+
+    if (tREFI != 0 && tRFC >= tREFI)
+        fatal("%s: refresh cycle time must be shorter than the refresh "
+              "interval", name);
+
+    ranks.resize(num_ranks);
+    for (int i = 0; i < num_ranks; i++) {
+        Rank &r = ranks[i];
+        r.actWindow.resize(4, Never);
+        r.actWindowPos = 0;
+        r.lastActivate = Never;
+        r.lastCAS = Never;
+        r.lastRead = Never;
+        r.lastWriteEnd = Never;
+        r.groupLastActivate.resize(num_bank_groups, Never);
+        r.groupLastCAS.resize(num_bank_groups, Never);
+        r.groupLastWriteEnd.resize(num_bank_groups, Never);
+
+        // Stagger refreshes so that ranks are not refreshed together
+        r.refreshOffset = (tREFI / num_ranks) * i;
+    }
+
+    // Consecutive bank ids are spread over bank groups first, then ranks
+    banks.resize(num_banks);
+    for (int i = 0; i < num_banks; i++) {
+        Bank &b = banks[i];
+        b.open = false;
+        b.openPage = 0;
+        b.group = i % num_bank_groups;
+        b.rank = (i / num_bank_groups) % num_ranks;
+        b.rowReadyAt = 0;
+        b.preAllowedAt = 0;
+        b.closedAt = 0;
+        b.accessesSinceActivate = 0;
+        b.inConflict = false;
+    }
+
+    dataBusFreeAt = 0;
+    lastDataRank = 0;
+}
+
+void
+DDRMemBank::regStats()
+{
+    using namespace Stats;
+
+    BaseMemory::regStats();
+
+    refreshDelays
+        .name(name() + ".refresh_delays")
+        .desc("Number of commands delayed by a refresh")
+        ;
+
+    fawDelays
+        .name(name() + ".faw_delays")
+        .desc("Number of activates delayed by the four activate window")
+        ;
+
+    rankSwitches
+        .name(name() + ".rank_switches")
+        .desc("Number of data bus transfers that switched rank")
+        ;
+}
+
+Tick
+DDRMemBank::refreshAdjust(const Rank &r, Tick t)
+{
+    if (tREFI == 0 || t < r.refreshOffset) {
+        return t;
+    }
+
+    Tick phase = (t - r.refreshOffset) % tREFI;
+    if (phase < tRFC) {
+        refreshDelays++;
+        return t + (tRFC - phase);
+    }
+    return t;
+}
+
+Tick
+DDRMemBank::activate(Bank &bank, Addr page)
+{
+    Rank &r = ranks[bank.rank];
+
+    if (bank.closedAt >= curTick && bank.closedAt != 0) {
+        bank.inConflict = true;
+    }
+
+    Tick actAt = max(curTick, bank.closedAt);
+    actAt = max(actAt, r.lastActivate + tRRD_S);
+    actAt = max(actAt, r.groupLastActivate[bank.group] + tRRD_L);
+
+    if (tFAW > 0 && r.actWindow[r.actWindowPos] + tFAW > actAt) {
+        actAt = r.actWindow[r.actWindowPos] + tFAW;
+        fawDelays++;
+    }
+
+    actAt = refreshAdjust(r, actAt);
+
+    r.actWindow[r.actWindowPos] = actAt;
+    r.actWindowPos = (r.actWindowPos + 1) % r.actWindow.size();
+    r.lastActivate = actAt;
+    r.groupLastActivate[bank.group] = actAt;
+
+    bank.open = true;
+    bank.openPage = page;
+    bank.rowReadyAt = actAt + tRCD;
+    bank.preAllowedAt = actAt + tRAS;
+    bank.accessesSinceActivate = 0;
+
+    DPRINTF(DRAM, "Activate issued at %d, row ready at %d\n",
+            actAt, bank.rowReadyAt);
+
+    return 0;
+}
+
+Tick
+DDRMemBank::precharge(Bank &bank)
+{
+    Tick preAt = max(curTick, bank.preAllowedAt);
+    preAt = refreshAdjust(ranks[bank.rank], preAt);
+
+    bank.open = false;
+    bank.closedAt = preAt + tRP;
+
+    DPRINTF(DRAM, "Precharge issued at %d, bank closed at %d\n",
+            preAt, bank.closedAt);
+
+    return 0;
+}
+
+Tick
+DDRMemBank::column(Bank &bank, MemReqPtr &req, bool isRead)
+{
+    Rank &r = ranks[bank.rank];
+    int g = bank.group;
+
+    // Earliest column command issue time
+    Tick casAt = max(bank.rowReadyAt, req->inserted_into_memory_controller);
+    casAt = max(casAt, r.lastCAS + tCCD_S);
+    casAt = max(casAt, r.groupLastCAS[g] + tCCD_L);
+    if (isRead) {
+        casAt = max(casAt, r.lastWriteEnd + tWTR_S);
+        casAt = max(casAt, r.groupLastWriteEnd[g] + tWTR_L);
+    } else {
+        casAt = max(casAt, r.lastRead + tRTW);
+    }
+
+    if (bank.rowReadyAt > curTick) {
+        number_of_non_overlap_activate++;
+    }
+
+    // Delay the column command until its burst fits on the data bus
+    Tick casToData = isRead ? tCL : tCWL;
+    Tick busFree = dataBusFreeAt;
+    if (bank.rank != lastDataRank) {
+        busFree += tRTRS;
+        rankSwitches++;
+    }
+    casAt = max(casAt, max(busFree, curTick) - casToData);
+
+    // A refresh can only push the command later, so the burst still fits
+    casAt = refreshAdjust(r, casAt);
+
+    Tick dataStart = casAt + casToData;
+    Tick dataEnd = dataStart + tBURST;
+
+    r.lastCAS = casAt;
+    r.groupLastCAS[g] = casAt;
+    if (isRead) {
+        r.lastRead = casAt;
+        bank.preAllowedAt = max(bank.preAllowedAt, casAt + tRTP);
+    } else {
+        r.lastWriteEnd = dataEnd;
+        r.groupLastWriteEnd[g] = dataEnd;
+        bank.preAllowedAt = max(bank.preAllowedAt, dataEnd + tWR);
+    }
+
+    dataBusFreeAt = dataEnd;
+    lastDataRank = bank.rank;
+
+    DPRINTF(DRAM, "%s column command at %d, data from %d to %d\n",
+            isRead ? "Read" : "Write", casAt, dataStart, dataEnd);
+
+    return dataEnd - curTick;
+}
+
+Tick
+DDRMemBank::calculateLatency(MemReqPtr &req)
+{
+    assert(req->cmd == Read || req->cmd == Writeback
+           || req->cmd == Close || req->cmd == Activate);
+
+    if (returnStaticLatencies) {
+        if (req->cmd == Read || req->cmd == Writeback) {
+            return STATIC_LATENCY;
+        }
+        return 0;
+    }
+
+    int bankID = getMemoryBankID(req->paddr);
+    Addr page = getPage(req->paddr);
+    Bank &bank = banks[bankID];
+
+    accessesPerBank[bankID]++;
+
+    DPRINTF(DRAM, "Calculating latency for req %d, cmd %s, page %d, "
+            "bank %d (rank %d, group %d)\n",
+            req->paddr, req->cmd, page, bankID, bank.rank, bank.group);
+
+    if (req->cmd == Close) {
+        assert(bank.open);
+        active_bank_count--;
+        return precharge(bank);
+    }
+
+    if (req->cmd == Activate) {
+        assert(!bank.open);
+        active_bank_count++;
+        assert(active_bank_count <= maximum_active_banks);
+        return activate(bank, page);
+    }
+
+    assert(bank.open && bank.openPage == page);
+
+    bool isRead = req->cmd == Read;
+    bool isHit = bank.accessesSinceActivate > 0;
+    if (isRead) {
+        number_of_reads++;
+        if (isHit) number_of_reads_hit++;
+    } else {
+        number_of_writes++;
+        if (isHit) number_of_writes_hit++;
+    }
+
+    Tick latency = column(bank, req, isRead);
+    bank.accessesSinceActivate++;
+
+    int cpuID = req->adaptiveMHASenderID;
+    if (cpuID > -1 && cpuID < bmCPUCount) {
+        perCPURequests[cpuID]++;
+        if (bank.inConflict) {
+            recordDRAMResult(DRAM_RESULT_CONFLICT, latency, req);
+        } else if (isHit) {
+            recordDRAMResult(DRAM_RESULT_HIT, latency, req);
+        } else {
+            recordDRAMResult(DRAM_RESULT_MISS, latency, req);
+        }
+    }
+    bank.inConflict = false;
+
+    total_latency += latency;
+
+    DPRINTF(DRAM, "Returning latency %d\n", latency);
+    return latency;
+}
+
+MemAccessResult
+DDRMemBank::access(MemReqPtr &req)
+{
+    Tick response_time = calculateLatency(req) + curTick;
+
+    req->flags |= SATISFIED;
+    si->respond(req, response_time);
+
+    return MA_HIT;
+}
+
+Tick
+DDRMemBank::probe(MemReqPtr &req, bool update)
+{
+    fatal("PROBE CALLED! YOU ARE NOT HOME!\n");
+    return 0;
+}
+
+bool
+DDRMemBank::isActive(MemReqPtr &req)
+{
+    Bank &bank = banks[getMemoryBankID(req->paddr)];
+    return bank.open && bank.openPage == getPage(req->paddr);
+}
+
+bool
+DDRMemBank::bankIsClosed(MemReqPtr &req)
+{
+    return !banks[getMemoryBankID(req->paddr)].open;
+}
+
+bool
+DDRMemBank::isReady(MemReqPtr &req)
+{
+    Bank &bank = banks[getMemoryBankID(req->paddr)];
+    return isActive(req) && bank.rowReadyAt <= curTick;
+}
@@ -0,0 +1,174 @@
+/*
+ * ddr_mem_bank.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef __DDR_MEM_BANK_HH__
+#define __DDR_MEM_BANK_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/timing/base_memory.hh"
+
+/**
+ * A DDR3/DDR4 timing engine with ranks and bank groups.
+ *
+ * The memory controller issues Activate, Close, Read and Writeback
+ * commands one at a time, exactly as for SimpleMemBank. For each
+ * command, the earliest issue time is computed in closed form from the
+ * per-bank, per-bank-group and per-rank timestamps of earlier commands.
+ * Nothing is polled per cycle. The constraints modelled are tRCD, tCL,
+ * tCWL, tRP, tRAS, tRTP, tWR, tCCD_S/L, tRRD_S/L, tWTR_S/L, tFAW,
+ * read-to-write turnaround, rank-to-rank switching on the data bus and
+ * staggered per-rank refresh.
+ *
+ * The controller decides on the next command when the previous data
+ * burst ends. A real controller issues column commands earlier, so
+ * the CAS latency overlaps the previous burst. To get the same
+ * pipelining, a column command may issue as early as its timing
+ * constraints and the arrival of its request allow. The data burst is
+ * then placed on the data bus no earlier than the current tick.
+ *
+ * Refresh only blocks command issue. The open-page state belongs to
+ * the controller, so rows are not closed by a refresh.
+ */
+class DDRMemBank : public BaseMemory
+{
+  private:
+
+    struct Bank
+    {
+        bool open;
+        Addr openPage;
+        int rank;
+        int group;
+
+        Tick rowReadyAt;
+        Tick preAllowedAt;
+        Tick closedAt;
+
+        int accessesSinceActivate;
+        bool inConflict;
+    };
+
+    struct Rank
+    {
+        /** The last four activates, for the tFAW window */
+        std::vector<Tick> actWindow;
+        int actWindowPos;
+
+        Tick lastActivate;
+        Tick lastCAS;
+        Tick lastRead;
+        Tick lastWriteEnd;
+
+        std::vector<Tick> groupLastActivate;
+        std::vector<Tick> groupLastCAS;
+        std::vector<Tick> groupLastWriteEnd;
+
+        Tick refreshOffset;
+    };
+
+    /* Timing parameters, converted to CPU cycles */
+    Tick tRCD;
+    Tick tCL;
+    Tick tCWL;
+    Tick tRP;
+    Tick tRAS;
+    Tick tRTP;
+    Tick tWR;
+    Tick tBURST;
+    Tick tRTW;
+    Tick tCCD_S;
+    Tick tCCD_L;
+    Tick tRRD_S;
+    Tick tRRD_L;
+    Tick tWTR_S;
+    Tick tWTR_L;
+    Tick tFAW;
+    Tick tRTRS;
+    Tick tREFI;
+    Tick tRFC;
+
+    int num_ranks;
+    int num_bank_groups;
+    int pagesize;
+    int bus_to_cpu_factor;
+
+    int active_bank_count;
+    int maximum_active_banks;
+
+    bool returnStaticLatencies;
+
+    std::vector<Bank> banks;
+    std::vector<Rank> ranks;
+
+    Tick dataBusFreeAt;
+    int lastDataRank;
+
+    Stats::Scalar<> refreshDelays;
+    Stats::Scalar<> fawDelays;
+    Stats::Scalar<> rankSwitches;
+
+    Tick refreshAdjust(const Rank &r, Tick t);
+
+    Tick activate(Bank &bank, Addr page);
+    Tick precharge(Bank &bank);
+    Tick column(Bank &bank, MemReqPtr &req, bool isRead);
+
+  public:
+    /**
+     * Constructs and initializes this memory.
+     * @param name The name of this memory.
+     * @param hier Pointer to the hierarchy wide parameters.
+     * @param params The BaseMemory parameters.
+     */
+    DDRMemBank(const std::string &name, HierParams *hier,
+               BaseMemory::Params params);
+
+    void regStats();
+
+    Tick calculateLatency(MemReqPtr &req);
+
+    /**
+     * Perform the request on this memory.
+     * @param req The request to perform.
+     * @return MA_HIT
+     */
+    MemAccessResult access(MemReqPtr &req);
+
+    Tick probe(MemReqPtr &req, bool update);
+
+    bool isActive(MemReqPtr &req);
+    bool bankIsClosed(MemReqPtr &req);
+    bool isReady(MemReqPtr &req);
+
+    int getMemoryBankID(Addr addr){
+        return addrMap.bank(addr);
+    }
+
+    int getMemoryBankCount(){
+        return num_banks;
+    }
+
+    int getMaxActiveBanks(){
+        return maximum_active_banks;
+    }
+
+    int getPageSize(){
+        return pagesize;
+    }
+
+    Tick getDataTransTime(){
+        return tBURST;
+    }
+
+    Tick getBankActivatedAt(int bankID){
+        return banks[bankID].rowReadyAt;
+    }
+};
+
+#endif // __DDR_MEM_BANK_HH__
@@ -39,6 +39,7 @@
 #include "mem/functional/functional.hh"
 #include "mem/timing/base_memory.hh"
 #include "mem/timing/simple_mem_bank.hh"
+#include "mem/timing/ddr_mem_bank.hh"
 #include "mem/bus/bus.hh"
 #include "sim/builder.hh"
 
@@ -91,6 +92,20 @@ BEGIN_DECLARE_SIM_OBJECT_PARAMS(BaseMemory)
 
     Param<bool> static_memory_latency;
 
+    Param<string> timing_model;
+    Param<int> num_ranks;
+    Param<int> num_bank_groups;
+    Param<int> CAS_to_CAS_long;
+    Param<int> row_to_row_long;
+    Param<int> write_to_read_long;
+    Param<int> four_activate_window;
+    Param<int> rank_to_rank_switch;
+    Param<int> refresh_interval;
+    Param<int> refresh_cycle_time;
+
+    Param<int> bank_interleave_bit;
+    Param<bool> xor_bank_hash;
+
 END_DECLARE_SIM_OBJECT_PARAMS(BaseMemory)
 
 BEGIN_INIT_SIM_OBJECT_PARAMS(BaseMemory)
@@ -124,7 +139,19 @@ BEGIN_INIT_SIM_OBJECT_PARAMS(BaseMemory)
 	INIT_PARAM(read_to_write_turnaround, "Read to write turn around time (bus cycles)"),
 	INIT_PARAM(internal_row_to_row, "Internal row to row (bus cycles)"),
 	INIT_PARAM(max_active_bank_cnt, "Maximum number of active banks"),
-    INIT_PARAM_DFLT(static_memory_latency, "Return the same latency for all data transfers", false)
+    INIT_PARAM_DFLT(static_memory_latency, "Return the same latency for all data transfers", false),
+    INIT_PARAM_DFLT(timing_model, "DRAM timing model (simple or ddr)", "simple"),
+    INIT_PARAM_DFLT(num_ranks, "Number of ranks (ddr model only)", 1),
+    INIT_PARAM_DFLT(num_bank_groups, "Number of bank groups per rank (ddr model only)", 1),
+    INIT_PARAM_DFLT(CAS_to_CAS_long, "CAS to CAS within a bank group, tCCD_L (bus cycles)", 0),
+    INIT_PARAM_DFLT(row_to_row_long, "Activate to activate within a bank group, tRRD_L (bus cycles)", 0),
+    INIT_PARAM_DFLT(write_to_read_long, "Write to read within a bank group, tWTR_L (bus cycles)", 0),
+    INIT_PARAM_DFLT(four_activate_window, "Four activate window, tFAW (bus cycles)", 0),
+    INIT_PARAM_DFLT(rank_to_rank_switch, "Rank to rank switch on the data bus, tRTRS (bus cycles)", 0),
+    INIT_PARAM_DFLT(refresh_interval, "Refresh interval, tREFI, 0 disables refresh (bus cycles)", 0),
+    INIT_PARAM_DFLT(refresh_cycle_time, "Refresh cycle time, tRFC (bus cycles)", 0),
+    INIT_PARAM_DFLT(bank_interleave_bit, "Lowest bank index address bit, -1 interleaves pages", -1),
+    INIT_PARAM_DFLT(xor_bank_hash, "XOR the bank index with the low row bits", false)
 
 END_INIT_SIM_OBJECT_PARAMS(BaseMemory)
 
@@ -162,6 +189,35 @@ CREATE_SIM_OBJECT(BaseMemory)
 
     params.static_memory_latency = static_memory_latency;
 
+    params.timing_model = timing_model;
+    params.num_ranks = num_ranks;
+    params.num_bank_groups = num_bank_groups;
+    params.CAS_to_CAS_long = CAS_to_CAS_long;
+    params.row_to_row_long = row_to_row_long;
+    params.write_to_read_long = write_to_read_long;
+    params.four_activate_window = four_activate_window;
+    params.rank_to_rank_switch = rank_to_rank_switch;
+    params.refresh_interval = refresh_interval;
+    params.refresh_cycle_time = refresh_cycle_time;
+
+    params.bank_interleave_bit = bank_interleave_bit;
+    params.xor_bank_hash = xor_bank_hash;
+
+    if (params.timing_model == "ddr") {
+	if (compressed)
+	    panic("the ddr timing model does not support compression");
+
+	DDRMemBank *retval = new DDRMemBank(getInstanceName(), hier, params);
+	if (in_bus == NULL) {
+	    retval->setSlaveInterface(new MemoryInterface<DDRMemBank>(getInstanceName(), hier, retval, mem_trace));
+	} else {
+	    retval->setSlaveInterface(new SlaveInterface<DDRMemBank, Bus>(getInstanceName(), hier, retval, in_bus, mem_trace));
+	}
+	return retval;
+    } else if (params.timing_model != "simple") {
+	fatal("Unknown DRAM timing model %s", params.timing_model);
+    }
+
     if (compressed) {
 #if defined(USE_LZSS_COMPRESSION)
 	SimpleMemBank<LZSSCompression> *retval =
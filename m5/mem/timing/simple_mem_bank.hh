@@ -131,7 +131,7 @@ class SimpleMemBank : public BaseMemory
     bool isReady(MemReqPtr &req);
 
     int getMemoryBankID(Addr addr){
-        return (addr >> pagesize) % num_banks;
+        return addrMap.bank(addr);
     }
 
     int getMemoryBankCount(){
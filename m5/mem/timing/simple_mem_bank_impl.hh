@@ -92,6 +92,9 @@ SimpleMemBank<Compression>::SimpleMemBank(const string &name, HierParams *hier,
 
     bankInConflict.resize(num_banks, false);
 
+    addrMap.init(name, pagesize, num_banks, params.bank_interleave_bit,
+                 params.xor_bank_hash);
+
     //CPU frequency is 4GHz
     bus_to_cpu_factor = 4000 / params.bus_frequency; // Multiply by this to get cpu - cycles :p
 
@@ -144,7 +147,7 @@ SimpleMemBank<Compression>::calculateLatency(MemReqPtr &req)
     }
 
     int bank = getMemoryBankID(req->paddr);
-    Addr page = (req->paddr >> pagesize);
+    Addr page = getPage(req->paddr);
     DDR2State oldState = Bankstate[bank];
 
     accessesPerBank[bank]++;
@@ -389,35 +392,14 @@ SimpleMemBank<Compression>::updateLatencyDistribution(bool isHit, int latency, i
 
     if(bankInConflict[bank]){
         assert(!isHit);
-
         isConflict = true;
-
-        req->dramResult = DRAM_RESULT_CONFLICT;
-
-        if(req->adaptiveMHASenderID != -1) perCPUPageConflicts[req->adaptiveMHASenderID]++;
-
-        pageConflicts[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)]++;
-        pageConflictLatency[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)] += latency;
-        pageConflictLatencyDistribution[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)].sample(latency);
+        recordDRAMResult(DRAM_RESULT_CONFLICT, latency, req);
     }
     else if(isHit){
-
-        req->dramResult = DRAM_RESULT_HIT;
-
-        if(req->adaptiveMHASenderID != -1) perCPUPageHits[req->adaptiveMHASenderID]++;
-
-        pageHits[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)]++;
-        pageHitLatency[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)] += latency;
+        recordDRAMResult(DRAM_RESULT_HIT, latency, req);
     }
     else{
-
-        req->dramResult = DRAM_RESULT_MISS;
-
-        if(req->adaptiveMHASenderID != -1) perCPUPageMisses[req->adaptiveMHASenderID]++;
-
-        pageMisses[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)]++;
-        pageMissLatency[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)] += latency;
-        pageMissLatencyDistribution[(req->cmd == Read ? DRAM_READ  : DRAM_WRITE)].sample(latency);
+        recordDRAMResult(DRAM_RESULT_MISS, latency, req);
     }
 
     return isConflict;
@@ -454,8 +436,8 @@ template <class Compression>
 bool
 SimpleMemBank<Compression>::isActive(MemReqPtr &req)
 {
-  int bank = (req->paddr >> pagesize) % num_banks;
-  Addr page = (req->paddr >> pagesize);
+  int bank = getMemoryBankID(req->paddr);
+  Addr page = getPage(req->paddr);
   if (Bankstate[bank] == DDR2Idle) {
     return false;
   }
@@ -470,7 +452,7 @@ template <class Compression>
 bool
 SimpleMemBank<Compression>::bankIsClosed(MemReqPtr &req)
 {
-  int bank = (req->paddr >> pagesize) % num_banks;
+  int bank = getMemoryBankID(req->paddr);
   if (Bankstate[bank] == DDR2Idle) {
     return true;
   }
@@ -481,8 +463,8 @@ template <class Compression>
 bool
 SimpleMemBank<Compression>::isReady(MemReqPtr &req)
 {
-	int bank = (req->paddr >> pagesize) % num_banks;
-	Addr page = (req->paddr >> pagesize);
+	int bank = getMemoryBankID(req->paddr);
+	Addr page = getPage(req->paddr);
 
 	if (Bankstate[bank] == DDR2Idle) {
 		return false;
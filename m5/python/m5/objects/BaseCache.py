@@ -15,6 +15,8 @@ class BaseCache(BaseMem):
     block_size = Param.Int("block size in bytes")
     compressed_bus = Param.Bool(False,
         "This cache connects to a compressed memory")
+    compression = Param.String("lzss",
+        "Compression algorithm for compressed IIC caches (lzss or bdi)")
     compression_latency = Param.Latency('0ns',
         "Latency in cycles of compression algorithm")
     do_copy = Param.Bool(False, "perform fast copies in the cache")
@@ -32,6 +32,20 @@ class BaseMemory(BaseMem):
     
     static_memory_latency = Param.Bool("Return the same latency for all data transfers")
     
+    timing_model = Param.String("simple", "DRAM timing model (simple or ddr)")
+    num_ranks = Param.Int(1, "Number of ranks (ddr model only)")
+    num_bank_groups = Param.Int(1, "Number of bank groups per rank (ddr model only)")
+    CAS_to_CAS_long = Param.Int(0, "CAS to CAS within a bank group, tCCD_L (bus cycles)")
+    row_to_row_long = Param.Int(0, "Activate to activate within a bank group, tRRD_L (bus cycles)")
+    write_to_read_long = Param.Int(0, "Write to read within a bank group, tWTR_L (bus cycles)")
+    four_activate_window = Param.Int(0, "Four activate window, tFAW (bus cycles)")
+    rank_to_rank_switch = Param.Int(0, "Rank to rank switch on the data bus, tRTRS (bus cycles)")
+    refresh_interval = Param.Int(0, "Refresh interval, tREFI, 0 disables refresh (bus cycles)")
+    refresh_cycle_time = Param.Int(0, "Refresh cycle time, tRFC (bus cycles)")
+    
+    bank_interleave_bit = Param.Int(-1, "Lowest bank index address bit, -1 interleaves pages")
+    xor_bank_hash = Param.Bool(False, "XOR the bank index with the low row bits")
+    
     if build_env['FULL_SYSTEM']:
         func_mem = Param.FunctionalMemory(Parent.physmem,
                                "corresponding functional memory object")
@@ -3,7 +3,9 @@ class BranchPred(SimObject):
     type = 'BranchPred'
 
     class PredictorType(Enum): vals = ['resetting', 'saturating']
-    class PredictorClass(Enum): vals = ['hybrid', 'global', 'local']
+    class PredictorClass(Enum): vals = ['hybrid', 'global', 'local',
+                                        'tage-sc-l']
+    class IndirectClass(Enum): vals = ['btb', 'ittage']
 
     btb_assoc = Param.Int("BTB associativity")
     btb_size = Param.Int("number of entries in BTB")
@@ -19,9 +21,20 @@ class BranchPred(SimObject):
     global_hist_bits = Param.Int(0, "global predictor history reg bits")
     global_index_bits = Param.Int(0, "global predictor index bits")
     global_xor = Param.Bool(False, "XOR global hist w/PC (False: concatenate)")
+    indirect_class = Param.IndirectClass('btb', "indirect target predictor")
+    ittage_budget = Param.Int(64, "ITTAGE storage budget in KB")
+    ittage_max_hist = Param.Int(300, "longest ITTAGE history")
+    ittage_min_hist = Param.Int(4, "shortest ITTAGE history")
+    ittage_tables = Param.Int(8, "number of ITTAGE tagged tables")
+    ittage_tag_bits = Param.Int(12, "ITTAGE tag bits")
     local_hist_bits = Param.Int(0, "local predictor history reg bits")
     local_hist_regs = Param.Int(0, "num. local predictor history regs")
     local_index_bits = Param.Int(0, "local predictor index bits")
     local_xor = Param.Bool(False, "XOR local hist w/PC (False: concatenate)")
     pred_class = Param.PredictorClass("predictor class")
     ras_size = Param.Int("return address stack size")
+    tage_budget = Param.Int(64, "TAGE-SC-L storage budget in KB")
+    tage_max_hist = Param.Int(640, "longest TAGE history")
+    tage_min_hist = Param.Int(4, "shortest TAGE history")
+    tage_tables = Param.Int(12, "number of TAGE tagged tables")
+    tage_tag_bits = Param.Int(12, "TAGE tag bits")
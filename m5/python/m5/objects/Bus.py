@@ -15,4 +15,4 @@ class Bus(BaseHier):
     interference_manager = Param.InterferenceManager("Interference manager")
     utilization_limit = Param.Float("Data bus utilization limit (single core only)")
     policy = Param.BasePolicy("The policy object")
-
+    arrival_trace = Param.String("", "File to record the memory controller request stream in")
@@ -10,3 +10,5 @@ class ExecutionTrace(ParamContext):
     print_iregs = Param.Bool(False, "print all integer regs")
     print_fetchseq = Param.Bool(False, "print fetch sequence number")
     print_cpseq = Param.Bool(False, "print correct-path sequence number")
+    format = Param.String('text', "trace output format (text or binary)")
+    file = Param.String('exetrace.bin', "binary trace file")
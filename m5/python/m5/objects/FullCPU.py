@@ -31,6 +31,8 @@ class StandardIQ(BaseIQ):
     type = 'StandardIQ'
     prioritized_issue = Param.Bool(False, "thread priorities in issue")
     size = Param.Int("number of entries")
+    bitmap_select = Param.Bool(False,
+        "select ready instructions through per-op-class bitmaps")
 
 class SegmentedIQ(BaseIQ):
     type = 'SegmentedIQ'
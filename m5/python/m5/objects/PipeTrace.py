@@ -6,3 +6,4 @@ class PipeTrace(SimObject):
     file = Param.String('', "output file name")
     range = Param.String('', "range of cycles to trace")
     statistics = VectorParam.String("stats to include in pipe-trace")
+    format = Param.String('text', "trace output format (text or binary)")
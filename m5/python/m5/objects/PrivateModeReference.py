@@ -0,0 +1,16 @@
+from m5 import *
+
+class PrivateModeReference(SimObject):
+    type = 'PrivateModeReference'
+
+    interferenceManager = Param.InterferenceManager("Pointer to the interference manager")
+    cpuCount = Param.Int("Number of cores")
+    size = Param.MemorySize("Capacity of one shared cache bank in bytes")
+    banks = Param.Int(1, "Number of shared cache banks")
+    assoc = Param.Int("Shared cache associativity")
+    blockSize = Param.Int("Shared cache block size")
+    cacheLatency = Param.Latency("Shared cache hit latency")
+    transferLatency = Param.Int(0, "Latency between the private cache and the shared cache in CPU cycles")
+    memory = Param.BaseMemory("The simulated memory, gives the DRAM timing")
+    aloneTraces = VectorParam.String([], "CommittedInsts traces of private mode runs, one per core")
+    useThreads = Param.Bool(True, "Replay the replicas on worker threads")
@@ -5,3 +5,4 @@ class Serialize(ParamContext):
     cycle = Param.Tick(0, "cycle to serialize")
     period = Param.Tick(0, "period to repeat serializations")
     count = Param.Int(10, "maximum number of checkpoints to drop")
+    format = Param.String('text', "checkpoint format (text or binary)")
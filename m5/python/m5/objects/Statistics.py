@@ -18,4 +18,7 @@ class Statistics(ParamContext):
     dump_cycle = Param.Tick(0, "cycle on which to dump stats")
     dump_period = Param.Tick(0, "period with which to dump stats")
     ignore_events = VectorParam.String([], "name strings to ignore")
+    include = VectorParam.String([],
+        "globs of the stats to register (default: all)")
+    exclude = VectorParam.String([], "globs of the stats not to register")
 
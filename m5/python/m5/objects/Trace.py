@@ -6,5 +6,6 @@ class Trace(ParamContext):
     bufsize = Param.Int(0, "circular buffer size (0 = send to file)")
     file = Param.String('cout', "trace output file")
     dump_on_exit = Param.Bool(False, "dump trace buffer on exit")
+    format = Param.String('text', "trace output format (text or binary)")
     ignore = VectorParam.String([], "name strings to ignore")
 
@@ -4,4 +4,5 @@ class TrafficGenerator(SimObject):
     type = 'TrafficGenerator'
     membus = Param.Bus("The memory bus to inject traffic into")
     use_id = Param.Int("The CPU ID to use for the requets")
-
+    replay_trace = Param.String("", "Request stream to replay instead of generating traffic")
+    replay_mlp = Param.Int(0, "Maximum reads in flight per CPU during replay, 0 is open loop")
@@ -63,6 +63,7 @@ file_bases = ['AdaptiveMHA',
               'PhysicalMemory',
               'PipeTrace',
               'Platform',
+              'PrivateModeReference',
               'Process',
               'PseudoInst',
               'PerformanceDirectedPolicy',
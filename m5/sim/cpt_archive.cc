@@ -0,0 +1,615 @@
+/*
+ * cpt_archive.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "sim/cpt_archive.hh"
+
+using namespace std;
+
+static const char archiveMagic[8] = {'M', '5', 'C', 'P', 'T', 'A', 'R', 'C'};
+static const uint32_t archiveVersion = 1;
+
+enum Compression {
+    COMPRESS_NONE = 0,
+    COMPRESS_ZLIB = 1
+};
+
+struct ArchiveHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numSections;
+    uint64_t indexOffset;
+};
+
+/** One section on its way to or from the file. */
+struct SectionJob
+{
+    CheckpointArchive::Section *section;
+    uint32_t compression;
+    uint64_t rawSize;
+    std::string stored;
+    bool ok;
+};
+
+struct JobPool
+{
+    std::vector<SectionJob> *jobs;
+    bool saving;
+    unsigned next;
+    pthread_mutex_t lock;
+};
+
+static void
+trim(string &s)
+{
+    string::size_type first = s.find_first_not_of(" \t\r\n");
+    if (first == string::npos) {
+        s.clear();
+        return;
+    }
+    string::size_type last = s.find_last_not_of(" \t\r\n");
+    s = s.substr(first, last - first + 1);
+}
+
+/**
+ * Turn a long list of decimal integers into an integer array. Only
+ * tokens that are printed back identically are accepted, so find()
+ * returns the original text.
+ */
+static void
+classify(CheckpointArchive::Entry &e)
+{
+    if (e.type != CheckpointArchive::TEXT)
+        return;
+
+    const string &s = e.text;
+    vector<int64_t> values;
+    bool isSigned = false;
+    bool isLarge = false;
+    string::size_type pos = 0;
+
+    while (pos < s.size()) {
+        string::size_type end = s.find(' ', pos);
+        if (end == string::npos)
+            end = s.size();
+        if (end == pos)
+            return;
+
+        string::size_type digits = pos;
+        bool negative = s[pos] == '-';
+        if (negative) {
+            digits++;
+            isSigned = true;
+        }
+        if (digits == end || end - digits > 19)
+            return;
+        if (s[digits] == '0' && (end - digits > 1 || negative))
+            return;
+        for (string::size_type i = digits; i < end; i++) {
+            if (s[i] < '0' || s[i] > '9')
+                return;
+        }
+
+        // 19 digits always fit in 64 bits
+        uint64_t v = strtoull(s.c_str() + digits, NULL, 10);
+        if (v >= ((uint64_t)1 << 63)) {
+            if (negative)
+                return;
+            isLarge = true;
+        }
+        values.push_back(negative ? -(int64_t)v : (int64_t)v);
+        pos = end + 1;
+    }
+
+    // a signed array prints its values as int64_t
+    if (values.size() < CheckpointArchive::MinArrayLength
+        || s[s.size() - 1] == ' ' || (isSigned && isLarge))
+        return;
+
+    e.type = isSigned ? CheckpointArchive::INT_ARRAY
+                      : CheckpointArchive::UINT_ARRAY;
+    e.values.swap(values);
+    e.text.clear();
+}
+
+static void
+putBytes(string &out, const void *p, size_t size)
+{
+    out.append((const char *)p, size);
+}
+
+static void
+putString(string &out, const string &s)
+{
+    uint32_t len = s.size();
+    putBytes(out, &len, sizeof(len));
+    out.append(s);
+}
+
+static bool
+getBytes(const string &in, size_t &pos, void *p, size_t size)
+{
+    if (pos + size > in.size())
+        return false;
+    memcpy(p, in.data() + pos, size);
+    pos += size;
+    return true;
+}
+
+static bool
+getString(const string &in, size_t &pos, string &s)
+{
+    uint32_t len;
+    if (!getBytes(in, pos, &len, sizeof(len)) || pos + len > in.size())
+        return false;
+    s.assign(in.data() + pos, len);
+    pos += len;
+    return true;
+}
+
+static void
+encodeSection(const CheckpointArchive::Section &section, string &out)
+{
+    CheckpointArchive::Section::const_iterator it = section.begin();
+    for ( ; it != section.end(); it++) {
+        const CheckpointArchive::Entry &e = it->second;
+        putString(out, it->first);
+        uint8_t type = e.type;
+        putBytes(out, &type, sizeof(type));
+        if (e.type == CheckpointArchive::TEXT) {
+            putString(out, e.text);
+        } else {
+            uint32_t count = e.values.size();
+            putBytes(out, &count, sizeof(count));
+            if (count > 0)
+                putBytes(out, &e.values[0], count * sizeof(int64_t));
+        }
+    }
+}
+
+static bool
+decodeSection(const string &in, CheckpointArchive::Section &section)
+{
+    size_t pos = 0;
+    while (pos < in.size()) {
+        string key;
+        uint8_t type;
+        if (!getString(in, pos, key) || !getBytes(in, pos, &type, 1))
+            return false;
+
+        CheckpointArchive::Entry &e = section[key];
+        e.type = (CheckpointArchive::EntryType)type;
+        if (e.type == CheckpointArchive::TEXT) {
+            if (!getString(in, pos, e.text))
+                return false;
+        } else if (e.type == CheckpointArchive::INT_ARRAY
+                   || e.type == CheckpointArchive::UINT_ARRAY) {
+            uint32_t count;
+            if (!getBytes(in, pos, &count, sizeof(count)))
+                return false;
+            e.values.resize(count);
+            if (count > 0 && !getBytes(in, pos, &e.values[0],
+                                       count * sizeof(int64_t)))
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+saveJob(SectionJob &job)
+{
+    string raw;
+    encodeSection(*job.section, raw);
+    job.rawSize = raw.size();
+
+    if (raw.size() < CheckpointArchive::MinCompressSize) {
+        job.compression = COMPRESS_NONE;
+        job.stored.swap(raw);
+        return true;
+    }
+
+    uLongf size = compressBound(raw.size());
+    job.stored.resize(size);
+    if (compress2((Bytef *)&job.stored[0], &size, (const Bytef *)raw.data(),
+                  raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+        return false;
+    job.stored.resize(size);
+    job.compression = COMPRESS_ZLIB;
+    return true;
+}
+
+static bool
+loadJob(SectionJob &job)
+{
+    if (job.compression == COMPRESS_NONE)
+        return job.stored.size() == job.rawSize
+            && decodeSection(job.stored, *job.section);
+
+    if (job.compression != COMPRESS_ZLIB)
+        return false;
+
+    string raw;
+    raw.resize(job.rawSize);
+    uLongf size = job.rawSize;
+    if (job.rawSize > 0 &&
+        uncompress((Bytef *)&raw[0], &size, (const Bytef *)job.stored.data(),
+                   job.stored.size()) != Z_OK)
+        return false;
+    if (size != job.rawSize)
+        return false;
+
+    string().swap(job.stored);
+    return decodeSection(raw, *job.section);
+}
+
+void *
+CheckpointArchive::runWorker(void *arg)
+{
+    JobPool *pool = (JobPool *)arg;
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        unsigned index = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (index >= pool->jobs->size())
+            break;
+
+        SectionJob &job = (*pool->jobs)[index];
+        job.ok = pool->saving ? saveJob(job) : loadJob(job);
+    }
+    return NULL;
+}
+
+/** Process all jobs on a pool of threads, the caller being one of them. */
+static void
+runJobs(vector<SectionJob> &jobs, bool saving, void *(*worker)(void *))
+{
+    JobPool pool;
+    pool.jobs = &jobs;
+    pool.saving = saving;
+    pool.next = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    int threads = CheckpointArchive::numThreads();
+    if ((unsigned)threads > jobs.size())
+        threads = jobs.size();
+
+    vector<pthread_t> ids;
+    for (int i = 1; i < threads; i++) {
+        pthread_t id;
+        if (pthread_create(&id, NULL, worker, &pool) == 0)
+            ids.push_back(id);
+    }
+    worker(&pool);
+    for (int i = 0; i < ids.size(); i++)
+        pthread_join(ids[i], NULL);
+
+    pthread_mutex_destroy(&pool.lock);
+}
+
+int
+CheckpointArchive::numThreads()
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1)
+        return 1;
+    return cpus > 8 ? 8 : cpus;
+}
+
+bool
+CheckpointArchive::isArchive(const string &file)
+{
+    FILE *f = fopen(file.c_str(), "rb");
+    if (f == NULL)
+        return false;
+
+    char magic[sizeof(archiveMagic)];
+    bool match = fread(magic, sizeof(magic), 1, f) == 1
+        && memcmp(magic, archiveMagic, sizeof(magic)) == 0;
+    fclose(f);
+    return match;
+}
+
+bool
+CheckpointArchive::parseText(istream &is)
+{
+    Section *section = NULL;
+    string line;
+
+    while (getline(is, line)) {
+        trim(line);
+        if (line.empty())
+            continue;
+
+        if (line[0] == '[' && line[line.size() - 1] == ']') {
+            string name = line.substr(1, line.size() - 2);
+            trim(name);
+            section = &sections[name];
+            continue;
+        }
+
+        // anything before the first section is a comment
+        if (section == NULL)
+            continue;
+
+        string::size_type offset = line.find('=');
+        if (offset == string::npos || offset == 0) {
+            errorMsg = "Can't parse checkpoint line " + line;
+            return false;
+        }
+
+        bool append = line[offset - 1] == '+';
+        string key = line.substr(0, append ? offset - 1 : offset);
+        string value = line.substr(offset + 1);
+        trim(key);
+        trim(value);
+
+        Section::iterator it = section->find(key);
+        if (it != section->end() && append) {
+            it->second.text += " ";
+            it->second.text += value;
+        } else {
+            Entry &e = (*section)[key];
+            e.type = TEXT;
+            e.text = value;
+            e.values.clear();
+        }
+    }
+
+    SectionMap::iterator sit = sections.begin();
+    for ( ; sit != sections.end(); sit++) {
+        Section::iterator eit = sit->second.begin();
+        for ( ; eit != sit->second.end(); eit++)
+            classify(eit->second);
+    }
+
+    return true;
+}
+
+bool
+CheckpointArchive::save(const string &file)
+{
+    vector<SectionJob> jobs(sections.size());
+    vector<string> names;
+    SectionMap::iterator it = sections.begin();
+    for (int i = 0; it != sections.end(); it++, i++) {
+        jobs[i].section = &it->second;
+        jobs[i].ok = false;
+        names.push_back(it->first);
+    }
+
+    runJobs(jobs, true, runWorker);
+
+    FILE *f = fopen(file.c_str(), "wb");
+    if (f == NULL) {
+        errorMsg = "Could not open " + file + ": " + strerror(errno);
+        return false;
+    }
+
+    ArchiveHeader header;
+    memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+    header.version = archiveVersion;
+    header.numSections = jobs.size();
+    header.indexOffset = 0;
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+
+    string index;
+    uint64_t offset = sizeof(header);
+    for (int i = 0; ok && i < jobs.size(); i++) {
+        SectionJob &job = jobs[i];
+        if (!job.ok) {
+            errorMsg = "Could not compress section " + names[i];
+            fclose(f);
+            return false;
+        }
+
+        uint64_t storedSize = job.stored.size();
+        putString(index, names[i]);
+        putBytes(index, &job.compression, sizeof(job.compression));
+        putBytes(index, &offset, sizeof(offset));
+        putBytes(index, &storedSize, sizeof(storedSize));
+        putBytes(index, &job.rawSize, sizeof(job.rawSize));
+
+        if (storedSize > 0)
+            ok = fwrite(job.stored.data(), storedSize, 1, f) == 1;
+        offset += storedSize;
+    }
+
+    header.indexOffset = offset;
+    ok = ok && fwrite(index.data(), index.size(), 1, f) == 1
+        && fseek(f, 0, SEEK_SET) == 0
+        && fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = fclose(f) == 0 && ok;
+
+    if (!ok)
+        errorMsg = "Could not write " + file;
+    return ok;
+}
+
+bool
+CheckpointArchive::load(const string &file)
+{
+    ifstream f(file.c_str(), ios::binary);
+    if (!f.is_open()) {
+        errorMsg = "Could not open " + file;
+        return false;
+    }
+
+    ArchiveHeader header;
+    f.read((char *)&header, sizeof(header));
+    if (!f.good() || memcmp(header.magic, archiveMagic, sizeof(archiveMagic))) {
+        errorMsg = file + " is not a checkpoint archive";
+        return false;
+    }
+    if (header.version != archiveVersion) {
+        errorMsg = file + " has an unsupported archive version";
+        return false;
+    }
+
+    f.seekg(0, ios::end);
+    uint64_t fileSize = f.tellg();
+    if (header.indexOffset > fileSize) {
+        errorMsg = file + " is truncated";
+        return false;
+    }
+
+    string index(fileSize - header.indexOffset, '\0');
+    f.seekg(header.indexOffset);
+    if (!index.empty())
+        f.read(&index[0], index.size());
+
+    // read all payloads here, the workers only decompress and decode
+    vector<SectionJob> jobs(header.numSections);
+    vector<string> names(header.numSections);
+    size_t pos = 0;
+    for (int i = 0; i < jobs.size(); i++) {
+        SectionJob &job = jobs[i];
+        uint64_t offset, storedSize;
+        if (!getString(index, pos, names[i])
+            || !getBytes(index, pos, &job.compression, sizeof(job.compression))
+            || !getBytes(index, pos, &offset, sizeof(offset))
+            || !getBytes(index, pos, &storedSize, sizeof(storedSize))
+            || !getBytes(index, pos, &job.rawSize, sizeof(job.rawSize))
+            || offset + storedSize > header.indexOffset) {
+            errorMsg = file + " has a corrupt section index";
+            return false;
+        }
+
+        job.stored.resize(storedSize);
+        f.seekg(offset);
+        if (storedSize > 0)
+            f.read(&job.stored[0], storedSize);
+        if (!f.good()) {
+            errorMsg = "Could not read section " + names[i] + " of " + file;
+            return false;
+        }
+
+        job.section = &sections[names[i]];
+        job.ok = false;
+    }
+
+    runJobs(jobs, false, runWorker);
+
+    for (int i = 0; i < jobs.size(); i++) {
+        if (!jobs[i].ok) {
+            errorMsg = "Section " + names[i] + " of " + file + " is corrupt";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+CheckpointArchive::embedPageIndexes(const string &dir)
+{
+    SectionMap::iterator it = sections.begin();
+    for ( ; it != sections.end(); it++) {
+        Section &section = it->second;
+        if (section.find("diskpagefilename") == section.end())
+            continue;
+
+        Section::iterator fit = section.find("filename");
+        if (fit == section.end() || fit->second.type != TEXT)
+            continue;
+
+        string filename = dir + "/" + fit->second.text;
+        ifstream pagefile(filename.c_str(), ios::binary);
+        if (!pagefile.is_open()) {
+            errorMsg = "Could not read page file " + filename;
+            return false;
+        }
+
+        int entries = 0;
+        pagefile.read((char *)&entries, sizeof(int));
+
+        Entry &addrs = section["diskpage_addrs"];
+        Entry &offsets = section["diskpage_offsets"];
+        addrs.type = UINT_ARRAY;
+        offsets.type = UINT_ARRAY;
+        addrs.values.resize(entries);
+        offsets.values.resize(entries);
+
+        for (int i = 0; i < entries && pagefile.good(); i++) {
+            pagefile.read((char *)&addrs.values[i], sizeof(uint64_t));
+            pagefile.read((char *)&offsets.values[i], sizeof(uint64_t));
+        }
+
+        if (!pagefile.good()) {
+            errorMsg = "Page file " + filename + " is truncated";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+CheckpointArchive::sectionExists(const string &section) const
+{
+    return sections.find(section) != sections.end();
+}
+
+bool
+CheckpointArchive::find(const string &section, const string &entry,
+                        string &value) const
+{
+    SectionMap::const_iterator sit = sections.find(section);
+    if (sit == sections.end())
+        return false;
+
+    Section::const_iterator eit = sit->second.find(entry);
+    if (eit == sit->second.end())
+        return false;
+
+    const Entry &e = eit->second;
+    if (e.type == TEXT) {
+        value = e.text;
+        return true;
+    }
+
+    stringstream text;
+    for (int i = 0; i < e.values.size(); i++) {
+        if (i > 0)
+            text << " ";
+        if (e.type == UINT_ARRAY)
+            text << (uint64_t)e.values[i];
+        else
+            text << e.values[i];
+    }
+    value = text.str();
+    return true;
+}
+
+bool
+CheckpointArchive::findArray(const string &section, const string &entry,
+                             vector<int64_t> &values) const
+{
+    SectionMap::const_iterator sit = sections.find(section);
+    if (sit == sections.end())
+        return false;
+
+    Section::const_iterator eit = sit->second.find(entry);
+    if (eit == sit->second.end() || eit->second.type == TEXT)
+        return false;
+
+    values = eit->second.values;
+    return true;
+}
@@ -0,0 +1,123 @@
+/*
+ * cpt_archive.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#ifndef CPT_ARCHIVE_HH_
+#define CPT_ARCHIVE_HH_
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim/host.hh"
+
+/**
+ * Binary checkpoint container (m5.cpz).
+ *
+ * The file starts with a header, followed by one payload per section
+ * and a section index at the end. The header holds a magic string, a
+ * version, the number of sections and the offset of the index. Each
+ * index record holds the section name, its compression, file offset,
+ * stored size and uncompressed size. Sections larger than a few
+ * hundred bytes are stored zlib compressed.
+ *
+ * An uncompressed payload is a list of entries. Each entry is a key,
+ * a type and a value. The value is either the text written by
+ * paramOut() or an array of 64 bit integers. When a text checkpoint is
+ * converted, long space separated lists of decimal integers become
+ * integer arrays, so arrayParamIn() can copy them without parsing.
+ *
+ * Sections are compressed when saving and decompressed and decoded
+ * when loading by a small pool of threads. Each section is handled by
+ * one thread, so a CMP checkpoint gets its per-CPU sections processed
+ * in parallel.
+ *
+ * The class only depends on the C++ library, zlib and pthreads, so the
+ * cptconvert utility can use it as well. Errors are reported through
+ * the return values and error().
+ */
+class CheckpointArchive
+{
+  public:
+
+    enum EntryType {
+        TEXT = 0,
+        INT_ARRAY = 1,
+        UINT_ARRAY = 2
+    };
+
+    struct Entry
+    {
+        EntryType type;
+        std::string text;
+        std::vector<int64_t> values;
+    };
+
+    typedef std::map<std::string, Entry> Section;
+
+  private:
+
+    typedef std::map<std::string, Section> SectionMap;
+    SectionMap sections;
+
+    std::string errorMsg;
+
+    static void *runWorker(void *arg);
+
+  public:
+
+    CheckpointArchive() {}
+
+    /** The minimum number of integers before a list becomes an array. */
+    static const unsigned MinArrayLength = 16;
+
+    /** Payloads smaller than this are stored uncompressed. */
+    static const unsigned MinCompressSize = 256;
+
+    /** True if file starts with the archive magic. */
+    static bool isArchive(const std::string &file);
+
+    /**
+     * Add the sections of a text (INI) checkpoint. Entries in
+     * sections that already exist are replaced.
+     */
+    bool parseText(std::istream &is);
+
+    bool load(const std::string &file);
+    bool save(const std::string &file);
+
+    /**
+     * Add the page index of every section that refers to a MainMemory
+     * page file (the diskpagefilename and filename entries). The index
+     * is stored as the integer arrays diskpage_addrs and
+     * diskpage_offsets. Page files are looked up relative to dir.
+     */
+    bool embedPageIndexes(const std::string &dir);
+
+    bool sectionExists(const std::string &section) const;
+
+    bool find(const std::string &section, const std::string &entry,
+              std::string &value) const;
+
+    /** @return false if the entry is missing or not an integer array. */
+    bool findArray(const std::string &section, const std::string &entry,
+                   std::vector<int64_t> &values) const;
+
+    Section &addSection(const std::string &section)
+    {
+        return sections[section];
+    }
+
+    int numSections() const { return sections.size(); }
+
+    const std::string &error() const { return errorMsg; }
+
+    /** Number of threads used to process sections. */
+    static int numThreads();
+};
+
+#endif /* CPT_ARCHIVE_HH_ */
@@ -304,24 +304,25 @@ Process::serialize(std::ostream &os){
 	//NOTE: serialization of MainMem is done automatically from SimObject
 }
 
-void
-Process::copyFile(std::string fromPath, std::string toPath){
-	cout << "Copying " << fromPath << " " << toPath << "\n";
-
-    ifstream  src(fromPath.c_str(), std::ios::binary);
-    ofstream  dst(toPath.c_str(),   std::ios::binary);
-
-    assert(src.good());
-    assert(dst.good());
-
-    dst << src.rdbuf();
-
-    assert(!src.fail());
-    assert(!dst.fail());
-
-    src.close();
-    dst.flush();
-    dst.close();
+const Process::CleanFile &
+Process::cleanFile(const std::string &path){
+
+	map<string, CleanFile>::iterator it = cleanFiles.find(path);
+	if(it != cleanFiles.end()) return it->second;
+
+	// the clean copy is read once and kept in memory for later restarts
+	CleanFile &file = cleanFiles[path];
+	string cleanName = path + ".clean";
+	ifstream src(cleanName.c_str(), ios::binary);
+	file.exists = src.is_open();
+	if(file.exists){
+		stringstream contents;
+		contents << src.rdbuf();
+		assert(!src.bad());
+		file.contents = contents.str();
+		cout << "RESTART: Cached clean file " << cleanName << " (" << file.contents.size() << " bytes)\n";
+	}
+	return file;
 }
 
 void
@@ -343,17 +344,14 @@ Process::cleanFileState(){
 	for( ; it != tgtFDFileParams.end(); it++){
 		FileParameters params = it->second;
 
-		bool cleanFileExists = false;
-		stringstream cleanName;
-		cleanName << params.path << ".clean";
-		if (FILE *file = fopen(cleanName.str().c_str(), "r")){
-			fclose(file);
-			cleanFileExists = true;
-		}
-
-		if(cleanFileExists){
-			cout << "RESTART: Restoring possibly touched file " << params.path << " with clean file " << cleanName.str() << "\n";
-			copyFile(cleanName.str(), params.path);
+		const CleanFile &clean = cleanFile(params.path);
+		if(clean.exists){
+			cout << "RESTART: Restoring possibly touched file " << params.path << " from its cached clean copy\n";
+			ofstream dst(params.path.c_str(), ios::binary | ios::trunc);
+			assert(dst.good());
+			dst.write(clean.contents.data(), clean.contents.size());
+			assert(!dst.fail());
+			dst.close();
 		}
 		else{
 			cout << "RESTART: Skipping file " << params.path << ", assuming that it is an input file since no .clean file is present\n";
@@ -361,13 +359,7 @@ Process::cleanFileState(){
 
 	}
 
-	stringstream useDiskpages;
-	useDiskpages << "diskpages-cpt" << cpuID << ".bin";
-	stringstream cleanDiskpages;
-	cleanDiskpages << "diskpages-cpt" << cpuID << ".bin.clean";
-
-	cout << "RESTART: Restoring diskpages from clean file " << cleanDiskpages.str() << " with clean file " << useDiskpages.str() << "\n";
-	copyFile(cleanDiskpages.str(), useDiskpages.str());
+	// the diskpages file is restored by the memory in clearDiskpages()
 }
 
 void
@@ -202,7 +202,16 @@ class Process : public SimObject
 
     void cleanFileState();
 
-    void copyFile(std::string fromPath, std::string toPath);
+    struct CleanFile
+    {
+        bool exists;
+        std::string contents;
+    };
+
+    // clean copies of the files the process has opened, keyed by path
+    std::map<std::string, CleanFile> cleanFiles;
+
+    const CleanFile &cleanFile(const std::string &path);
 
   public:
     // static helper functions to generate file descriptors for constructor
@@ -36,6 +36,7 @@
 
 #include <fstream>
 #include <list>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,7 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "sim/config_node.hh"
+#include "sim/cpt_archive.hh"
 #include "sim/eventq.hh"
 #include "sim/param.hh"
 #include "sim/serialize.hh"
@@ -56,6 +58,7 @@ using namespace std;
 
 int Serializable::maxCount = 0;
 int Serializable::count = 0;
+bool Serializable::binaryFormat = false;
 
 char* serializeFileBuffer[BINARY_FILE_BUFFER_SIZE];
 
@@ -115,11 +118,36 @@ arrayParamOut(ostream &os, const std::string &name,
 }
 
 
+template <class T>
+static bool
+copyIntArray(const vector<int64_t> &values, T *param)
+{
+	for (int i = 0; i < values.size(); i++)
+		param[i] = (T)values[i];
+	return true;
+}
+
+template <>
+bool
+copyIntArray(const vector<int64_t> &values, string *param)
+{
+	return false;
+}
+
 template <class T>
 void
 arrayParamIn(Checkpoint *cp, const std::string &section,
 		const std::string &name, T *param, int size)
 {
+	// binary checkpoints store integer arrays unparsed
+	vector<int64_t> values;
+	if (cp->findArray(section, name, values)) {
+		if (values.size() != size)
+			fatal("Array size mismatch on %s:%s'\n", section, name);
+		if (copyIntArray(values, param))
+			return;
+	}
+
 	std::string str;
 	if (!cp->find(section, name, str)) {
 		fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -260,13 +288,25 @@ Serializable::serializeAll()
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
 	    fatal("couldn't mkdir %s\n", dir);
 
-    string cpt_file = dir + Checkpoint::baseFilename;
-    ofstream outstream(cpt_file.c_str());
-    time_t t = time(NULL);
-    outstream << "// checkpoint generated: " << ctime(&t);
-
-    globals.serialize(outstream);
-    SimObject::serializeAll(outstream);
+    if (binaryFormat) {
+	// objects serialize to text, the archive stores it in binary
+	stringstream text;
+	globals.serialize(text);
+	SimObject::serializeAll(text);
+
+	CheckpointArchive archive;
+	if (!archive.parseText(text) || !archive.embedPageIndexes(".") ||
+	    !archive.save(dir + Checkpoint::archiveFilename))
+	    fatal("Could not write checkpoint archive: %s\n", archive.error());
+    } else {
+	string cpt_file = dir + Checkpoint::baseFilename;
+	ofstream outstream(cpt_file.c_str());
+	time_t t = time(NULL);
+	outstream << "// checkpoint generated: " << ctime(&t);
+
+	globals.serialize(outstream);
+	SimObject::serializeAll(outstream);
+    }
 
     if (maxCount && ++count >= maxCount)
         SimExit(curTick + 1, "Maximum number of checkpoints dropped");
@@ -311,6 +351,7 @@ SerializeEvent::process()
 }
 
 const char *Checkpoint::baseFilename = "m5.cpt";
+const char *Checkpoint::archiveFilename = "m5.cpz";
 
 static string checkpointDirBase;
 
@@ -359,6 +400,9 @@ Param<Counter> serialize_period(&serialParams,
 Param<int> serialize_count(&serialParams, "count",
 			   "maximum number of checkpoints to drop");
 
+Param<string> serialize_format(&serialParams, "format",
+			       "checkpoint format (text or binary)", "text");
+
 SerializeParamContext::SerializeParamContext(const string &section)
     : ParamContext(section), event(NULL)
 { }
@@ -380,6 +424,12 @@ SerializeParamContext::checkParams()
 	Checkpoint::setup(serialize_cycle, serialize_period);
 
     Serializable::maxCount = serialize_count;
+
+    string format = serialize_format;
+    if (format == "binary")
+	Serializable::binaryFormat = true;
+    else if (format != "text")
+	fatal("Unknown checkpoint format %s\n", format);
 }
 
 void
@@ -464,8 +514,18 @@ Serializable::create(Checkpoint *cp, const std::string &section)
 
 Checkpoint::Checkpoint(const std::string &cpt_dir, const std::string &path,
 		       const ConfigNode *_configNode)
-    : db(new IniFile), basePath(path), configNode(_configNode), cptDir(cpt_dir)
+    : db(NULL), archive(NULL), basePath(path), configNode(_configNode),
+      cptDir(cpt_dir)
 {
+    string archivename = cpt_dir + "/" + Checkpoint::archiveFilename;
+    if (CheckpointArchive::isArchive(archivename)) {
+	archive = new CheckpointArchive;
+	if (!archive->load(archivename))
+	    fatal("Can't load checkpoint archive: %s\n", archive->error());
+	return;
+    }
+
+    db = new IniFile;
     string filename = cpt_dir + "/" + Checkpoint::baseFilename;
     if (!db->load(filename)) {
 	fatal("Can't load checkpoint file '%s'\n", filename);
@@ -474,6 +534,7 @@ Checkpoint::Checkpoint(const std::string &cpt_dir, const std::string &path,
 
 Checkpoint::~Checkpoint(){
 	delete db;
+	delete archive;
 }
 
 
@@ -481,17 +542,27 @@ bool
 Checkpoint::find(const std::string &section, const std::string &entry,
 		 std::string &value)
 {
+    if (archive)
+	return archive->find(section, entry, value);
     return db->find(section, entry, value);
 }
 
 
+bool
+Checkpoint::findArray(const std::string &section, const std::string &entry,
+		      std::vector<int64_t> &values)
+{
+    return archive && archive->findArray(section, entry, values);
+}
+
+
 bool
 Checkpoint::findObj(const std::string &section, const std::string &entry,
 		    Serializable *&value)
 {
     string path;
 
-    if (!db->find(section, entry, path))
+    if (!find(section, entry, path))
 	return false;
 
     if ((value = configNode->resolveSimObject(path)) != NULL)
@@ -507,5 +578,7 @@ Checkpoint::findObj(const std::string &section, const std::string &entry,
 bool
 Checkpoint::sectionExists(const std::string &section)
 {
+    if (archive)
+	return archive->sectionExists(section);
     return db->sectionExists(section);
 }
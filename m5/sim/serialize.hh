@@ -40,12 +40,14 @@
 #include <list>
 #include <iostream>
 #include <map>
+#include <vector>
 
 #include "sim/host.hh"
 #include "sim/configfile.hh"
 
 class Serializable;
 class Checkpoint;
+class CheckpointArchive;
 
 #define BINARY_FILE_BUFFER_SIZE 8192
 
@@ -135,6 +137,7 @@ class Serializable
 
     static int count;
     static int maxCount;
+    static bool binaryFormat;
     static void serializeAll();
     static void unserializeGlobals(Checkpoint *cp);
 
@@ -224,6 +227,7 @@ class Checkpoint
   private:
 
     IniFile *db;
+    CheckpointArchive *archive;
     const std::string basePath;
     const ConfigNode *configNode;
     std::map<std::string, Serializable*> objMap;
@@ -242,6 +246,12 @@ class Checkpoint
     bool findObj(const std::string &section, const std::string &entry,
 		 Serializable *&value);
 
+    // Integer arrays are only stored as such in binary checkpoints.
+    // Returns false for text checkpoints or entries that are not
+    // integer arrays.
+    bool findArray(const std::string &section, const std::string &entry,
+		   std::vector<int64_t> &values);
+
     bool sectionExists(const std::string &section);
 
     // The following static functions have to do with checkpoint
@@ -257,6 +267,10 @@ class Checkpoint
     // Filename for base checkpoint file within directory.
     static const char *baseFilename;
 
+    // Filename for the binary checkpoint (see sim/cpt_archive.hh).
+    // If present, it is used instead of the base file.
+    static const char *archiveFilename;
+
     // Set up a checkpoint creation event or series of events.
     static void setup(Tick when, Tick period = 0);
 };
@@ -122,6 +122,14 @@ VectorParam<string> ignore(&statsParams, "ignore_events",
 			   "name strings to ignore",
 			   vector<string>());
 
+VectorParam<string> stat_include(&statsParams, "include",
+				 "globs of the stats to register (default: all)",
+				 vector<string>());
+
+VectorParam<string> stat_exclude(&statsParams, "exclude",
+				 "globs of the stats not to register",
+				 vector<string>());
+
 StatsParamContext::StatsParamContext(const string &_iniSection)
     : ParamContext(_iniSection, StatsInitPhase)
 {}
@@ -161,6 +169,8 @@ StatsParamContext::checkParams()
 #endif
 
     event_ignore.setExpression(ignore);
+
+    setFilter(stat_include, stat_exclude);
 }
 
 void
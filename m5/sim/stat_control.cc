@@ -91,6 +91,9 @@ statElapsedTicks()
 
 SimTicksReset simTicksReset;
 
+/** Called before the statistics are written */
+CallbackQueue dumpQueue;
+
 void
 InitSimStats()
 {
@@ -194,6 +197,8 @@ list<Output *> OutputList;
 void
 DumpNow()
 {
+	dumpQueue.process();
+
 	list<Output *>::iterator i = OutputList.begin();
 	list<Output *>::iterator end = OutputList.end();
 	for (; i != end; ++i) {
@@ -205,6 +210,12 @@ DumpNow()
 	}
 }
 
+void
+registerDumpCallback(Callback *cb)
+{
+    dumpQueue.add(cb);
+}
+
 void
 SetupEvent(int flags, Tick when, Tick repeat)
 {
@@ -35,6 +35,8 @@
 #include <fstream>
 #include <list>
 
+class Callback;
+
 namespace Stats {
 
 enum {
@@ -46,6 +48,7 @@ class Output;
 extern std::list<Output *> OutputList;
 
 void DumpNow();
+void registerDumpCallback(Callback *cb);
 void SetupEvent(int flags, Tick when, Tick repeat = 0);
 
 void InitSimStats();
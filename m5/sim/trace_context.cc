@@ -63,6 +63,12 @@ TraceDumpCallback::process()
     Trace::theLog.dump(DebugOut());
 }
 
+class BinaryTraceCloseCallback : public Callback
+{
+  public:
+    virtual void process() { Trace::binaryLog.close(); }
+};
+
 /////////////////////////////////////////////////////////////////////
 // Parameter space for execution address tracing options.  Derive
 // from ParamContext so we can override checkParams() function.
@@ -99,6 +105,9 @@ Param<string> trace_file(&traceParams, "file", "file for trace output");
 Param<bool> trace_dump_on_exit(&traceParams, "dump_on_exit",
 			       "dump trace buffer on exit", false);
 
+Param<string> trace_format(&traceParams, "format",
+			   "trace output format (text or binary)", "text");
+
 VectorParam<string> trace_ignore(&traceParams, "ignore",
 				 "name strings to ignore", vector<string>());
 
@@ -166,14 +175,31 @@ TraceParamContext::checkParams()
 	new EnableTraceEvent(this, trace_start);
     }
 
-    if ((int)trace_bufsize > 0)
-	theLog.init(trace_bufsize);
+    if ((string)trace_format == "binary") {
+	if ((int)trace_bufsize > 0)
+	    fatal("The binary trace format does not support a trace buffer");
+	if ((string)trace_file == "cout" || (string)trace_file == "cerr")
+	    fatal("The binary trace format needs a trace file");
+
+	binaryLog.open(simout.resolve(trace_file), flagStrings, NumFlags);
+	registerExitCallback(new BinaryTraceCloseCallback);
 
-    if (trace_dump_on_exit) {
-	registerExitCallback(new TraceDumpCallback);
+	// DCOUT output is still text
+	dprintf_stream = &cerr;
     }
+    else if ((string)trace_format == "text") {
+	if ((int)trace_bufsize > 0)
+	    theLog.init(trace_bufsize);
 
-    dprintf_stream = simout.find(trace_file);
+	if (trace_dump_on_exit) {
+	    registerExitCallback(new TraceDumpCallback);
+	}
+
+	dprintf_stream = simout.find(trace_file);
+    }
+    else {
+	fatal("Unknown trace format %s", (string)trace_format);
+    }
 
     ignore.setExpression(trace_ignore);
 
@@ -0,0 +1,540 @@
+/*
+ * compacttrace.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <libgen.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/compact_trace.hh"
+#include "base/cprintf.hh"
+
+using namespace std;
+
+const char *program = "compacttrace";
+
+void
+usage()
+{
+    cprintf(
+	"usage: \n"
+	"\t%s [-c start:end] [-t thread] [-T] print <trace>\n"
+	"\t%s [-c start:end] [-t thread] [-T] [-n lines] diff <trace> <trace>\n"
+	"\n"
+	"\t-c  only records in the cycle range\n"
+	"\t-t  only records of the thread\n"
+	"\t-T  leave out the cycles, to compare traces with different timing\n"
+	"\t-n  number of lines to show after the first difference\n",
+	program, program);
+    exit(2);
+}
+
+void
+error(const string &msg)
+{
+    cerr << program << ": " << msg << endl;
+    exit(1);
+}
+
+/**
+ * Reads the values written by CompactTraceWriter.
+ */
+class Reader
+{
+  private:
+    gzFile file;
+    string filename;
+    vector<uint8_t> buffer;
+    int used;
+    int available;
+
+  public:
+    Reader(const string &_filename)
+	: filename(_filename), buffer(1 << 16), used(0), available(0)
+    {
+	file = gzopen(filename.c_str(), "rb");
+	if (file == NULL)
+	    error("could not open " + filename);
+
+	uint32_t magic = 0;
+	for (int i = 0; i < 4; ++i)
+	    magic |= (uint32_t)getByte() << (8 * i);
+	if (magic != CompactTraceWriter::Magic)
+	    error(filename + " is not a compact trace");
+    }
+
+    ~Reader() { gzclose(file); }
+
+    bool
+    next(uint8_t &value)
+    {
+	if (used == available) {
+	    available = gzread(file, &buffer[0], buffer.size());
+	    used = 0;
+	    if (available < 0)
+		error("could not read " + filename);
+	    if (available == 0)
+		return false;
+	}
+	value = buffer[used++];
+	return true;
+    }
+
+    uint8_t
+    getByte()
+    {
+	uint8_t value;
+	if (!next(value))
+	    error(filename + " is truncated");
+	return value;
+    }
+
+    uint64_t
+    getVarint()
+    {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+	    uint8_t b = getByte();
+	    value |= (uint64_t)(b & 0x7f) << shift;
+	    if (!(b & 0x80))
+		return value;
+	}
+	error(filename + " has a bad value");
+	return 0;
+    }
+
+    uint64_t
+    getDelta(uint64_t &last)
+    {
+	uint64_t zigzag = getVarint();
+	int64_t delta = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+	last += (uint64_t)delta;
+	return last;
+    }
+
+    string
+    getString()
+    {
+	uint64_t len = getVarint();
+	string str;
+	str.reserve(len);
+	for (uint64_t i = 0; i < len; ++i)
+	    str += (char)getByte();
+	return str;
+    }
+};
+
+/**
+ * The text of the next record of a trace, in the same format as the
+ * text traces.
+ */
+struct Line
+{
+    string text;
+    uint64_t cycle;
+    int thread;
+};
+
+class Decoder
+{
+  public:
+    virtual ~Decoder() {}
+    virtual bool next(Line &line, bool timing) = 0;
+};
+
+// Same output as Trace::InstRecord::dump()
+class ExecDecoder : public Decoder
+{
+  private:
+    enum {
+	TRACE_MISSPEC = 0,
+	PRINT_CYCLE,
+	PRINT_OP_CLASS,
+	PRINT_THREAD_NUM,
+	PRINT_RESULT_DATA,
+	PRINT_EFF_ADDR,
+	PRINT_INT_REGS,
+	PRINT_FETCH_SEQ,
+	PRINT_CP_SEQ
+    };
+
+    enum { CPUDef = 1, StaticDef, Inst };
+
+    struct Static
+    {
+	string pcText;
+	string disassembly;
+	string opClass;
+    };
+
+    Reader &in;
+    uint64_t flags;
+    vector<string> cpus;
+    map<uint64_t, Static> statics;
+
+    uint64_t lastCycle, lastPC, lastAddr, lastFetchSeq, lastCPSeq;
+
+    bool flag(int bit) { return (flags >> bit) & 1; }
+
+  public:
+    ExecDecoder(Reader &_in)
+	: in(_in), lastCycle(0), lastPC(0), lastAddr(0), lastFetchSeq(0),
+	  lastCPSeq(0)
+    {
+	flags = in.getVarint();
+    }
+
+    bool
+    next(Line &line, bool timing)
+    {
+	uint8_t type;
+	while (in.next(type)) {
+	    if (type == CPUDef) {
+		uint64_t id = in.getVarint();
+		if (id >= cpus.size())
+		    cpus.resize(id + 1);
+		cpus[id] = in.getString();
+		continue;
+	    }
+	    if (type == StaticDef) {
+		Static &s = statics[in.getVarint()];
+		s.pcText = in.getString();
+		s.disassembly = in.getString();
+		s.opClass = in.getString();
+		continue;
+	    }
+	    if (type != Inst)
+		error("bad record in instruction trace");
+
+	    uint8_t fields = in.getByte();
+	    uint64_t cpu = in.getVarint();
+	    uint64_t cycle = in.getDelta(lastCycle);
+	    uint64_t pc = in.getDelta(lastPC);
+	    int thread = in.getVarint();
+
+	    if (cpu >= cpus.size() || !statics.count(pc))
+		error("undefined CPU or instruction in instruction trace");
+	    const Static &s = statics[pc];
+
+	    ostringstream outs;
+	    if (flag(PRINT_CYCLE) && timing)
+		ccprintf(outs, "%7d: ", cycle);
+
+	    outs << cpus[cpu] << " ";
+
+	    if (flag(TRACE_MISSPEC))
+		outs << ((fields & 0x01) ? "-" : "+") << " ";
+
+	    if (flag(PRINT_THREAD_NUM))
+		outs << "T" << thread << " : ";
+
+	    outs << s.pcText << " : ";
+	    outs << setw(26) << left << s.disassembly;
+	    outs << " : ";
+
+	    if (flag(PRINT_OP_CLASS))
+		outs << s.opClass << " : ";
+
+	    uint64_t addr = 0, data = 0;
+	    if (fields & 0x02)
+		addr = in.getDelta(lastAddr);
+	    if (fields & 0x04) {
+		in.getByte();
+		data = in.getVarint();
+	    }
+
+	    if (flag(PRINT_RESULT_DATA) && (fields & 0x04)) {
+		outs << " D=";
+		ccprintf(outs, "%#018x", data);
+	    }
+
+	    if (flag(PRINT_EFF_ADDR) && (fields & 0x02))
+		outs << " A=0x" << hex << addr;
+
+	    uint64_t fetchSeq = 0, cpSeq = 0;
+	    if (fields & 0x08)
+		fetchSeq = in.getDelta(lastFetchSeq);
+	    if (fields & 0x10)
+		cpSeq = in.getDelta(lastCPSeq);
+
+	    if (fields & 0x20) {
+		uint64_t regs[32];
+		for (int i = 0; i < 32; ++i)
+		    regs[i] = in.getVarint();
+		if (flag(PRINT_INT_REGS)) {
+		    for (int i = 0; i < 32;)
+			for (int j = i + 1; i <= j; i++)
+			    ccprintf(outs, "r%02d = %#018x%s", i, regs[i],
+				     ((i == j) ? "\n" : "    "));
+		    outs << "\n";
+		}
+	    }
+
+	    if (flag(PRINT_FETCH_SEQ) && (fields & 0x08))
+		outs << "  FetchSeq=" << dec << fetchSeq;
+
+	    if (flag(PRINT_CP_SEQ) && (fields & 0x10))
+		outs << "  CPSeq=" << dec << cpSeq;
+
+	    line.text = outs.str();
+	    line.cycle = cycle;
+	    line.thread = thread;
+	    return true;
+	}
+	return false;
+    }
+};
+
+// Same output as the text mode of PipeTrace
+class PipeDecoder : public Decoder
+{
+  private:
+    enum { CycleRecord = 1, StaticRecord, NewInst, MoveInst, DeleteInst };
+
+    Reader &in;
+    map<uint64_t, string> statics;
+    uint64_t lastCycle, lastSeq, lastCPSeq, lastPC, lastAddr;
+
+    string
+    tag(int &thread)
+    {
+	thread = in.getVarint();
+	uint64_t cpSeq = in.getDelta(lastCPSeq);
+	return csprintf("  [T%d, CP#%d]", thread, cpSeq);
+    }
+
+  public:
+    PipeDecoder(Reader &_in)
+	: in(_in), lastCycle(0), lastSeq(0), lastCPSeq(0), lastPC(0),
+	  lastAddr(0)
+    {
+    }
+
+    bool
+    next(Line &line, bool timing)
+    {
+	static const char * const stageNames[] =
+	    {"IF", "DA", "EX", "WB", "CT"};
+
+	uint8_t type;
+	while (in.next(type)) {
+	    switch (type) {
+	      case CycleRecord:
+		line.cycle = in.getDelta(lastCycle);
+		line.thread = -1;
+		if (!timing)
+		    continue;
+		line.text = csprintf("@ %d", line.cycle);
+		return true;
+
+	      case StaticRecord: {
+		  uint64_t pc = in.getVarint();
+		  statics[pc] = in.getString();
+		  continue;
+	      }
+
+	      case NewInst: {
+		  uint64_t seq = in.getDelta(lastSeq);
+		  uint64_t pc = in.getDelta(lastPC);
+		  int specMode = in.getVarint();
+		  string addr = "0000000000000000";
+		  if (in.getByte())
+		      addr = csprintf("%016x", in.getDelta(lastAddr));
+		  int thread;
+		  string t = tag(thread);
+		  line.cycle = lastCycle;
+		  line.text = csprintf("+ %d 0x%x 0x%s #%d T%d S%d : %#08x %s",
+				       seq, pc, addr, seq, thread, specMode,
+				       pc, statics[pc]) + t;
+		  line.thread = thread;
+		  return true;
+	      }
+
+	      case MoveInst: {
+		  uint64_t seq = in.getDelta(lastSeq);
+		  int stage = in.getByte();
+		  uint64_t events = in.getVarint();
+		  uint64_t lat = in.getVarint();
+		  uint64_t longest = in.getVarint();
+		  int thread;
+		  string t = tag(thread);
+		  if (stage > 4)
+		      error("bad stage in pipeline trace");
+		  line.cycle = lastCycle;
+		  line.text = csprintf("* %d %s 0x%04x %d 0x%04x", seq,
+				       stageNames[stage], events, lat,
+				       longest) + t;
+		  line.thread = thread;
+		  return true;
+	      }
+
+	      case DeleteInst: {
+		  uint64_t seq = in.getDelta(lastSeq);
+		  int thread;
+		  string t = tag(thread);
+		  line.cycle = lastCycle;
+		  line.text = csprintf("- %d", seq) + t;
+		  line.thread = thread;
+		  return true;
+	      }
+
+	      default:
+		error("bad record in pipeline trace");
+	    }
+	}
+	return false;
+    }
+};
+
+/**
+ * A trace file with the record filters applied.
+ */
+class Trace
+{
+  private:
+    Reader in;
+    Decoder *decoder;
+
+  public:
+    uint64_t start, end;
+    int thread;
+    bool timing;
+
+    Trace(const string &filename)
+	: in(filename), start(0), end((uint64_t)-1), thread(-1),
+	  timing(true)
+    {
+	string kind = in.getString();
+	int version = in.getVarint();
+	if (version != 1)
+	    error(filename + " has an unsupported version");
+
+	if (kind == "exec")
+	    decoder = new ExecDecoder(in);
+	else if (kind == "pipe")
+	    decoder = new PipeDecoder(in);
+	else
+	    error(filename + " has an unknown trace kind " + kind);
+    }
+
+    ~Trace() { delete decoder; }
+
+    bool
+    next(Line &line)
+    {
+	while (decoder->next(line, timing)) {
+	    if (line.cycle > end)
+		return false;
+	    if (line.cycle < start)
+		continue;
+	    if (thread >= 0 && line.thread >= 0 && line.thread != thread)
+		continue;
+	    return true;
+	}
+	return false;
+    }
+};
+
+int
+main(int argc, char *argv[])
+{
+    program = basename(argv[0]);
+
+    uint64_t start = 0, end = (uint64_t)-1;
+    int thread = -1;
+    bool timing = true;
+    int context = 10;
+
+    int c;
+    while ((c = getopt(argc, argv, "c:t:Tn:")) != -1) {
+	switch (c) {
+	  case 'c': {
+	      string range = optarg;
+	      string::size_type colon = range.find(':');
+	      if (colon == string::npos)
+		  usage();
+	      start = strtoull(range.substr(0, colon).c_str(), NULL, 0);
+	      if (colon + 1 < range.size())
+		  end = strtoull(range.substr(colon + 1).c_str(), NULL, 0);
+	      break;
+	  }
+	  case 't':
+	    thread = atoi(optarg);
+	    break;
+	  case 'T':
+	    timing = false;
+	    break;
+	  case 'n':
+	    context = atoi(optarg);
+	    break;
+	  default:
+	    usage();
+	}
+    }
+
+    if (argc - optind < 2)
+	usage();
+
+    string command = argv[optind];
+    vector<Trace *> traces;
+    for (int i = optind + 1; i < argc; ++i) {
+	Trace *trace = new Trace(argv[i]);
+	trace->start = start;
+	trace->end = end;
+	trace->thread = thread;
+	trace->timing = timing;
+	traces.push_back(trace);
+    }
+
+    Line line;
+    int status = 0;
+
+    if (command == "print" && traces.size() == 1) {
+	while (traces[0]->next(line))
+	    cout << line.text << "\n";
+    } else if (command == "diff" && traces.size() == 2) {
+	Line other;
+	uint64_t lineNum = 0;
+	while (true) {
+	    bool more = traces[0]->next(line);
+	    bool otherMore = traces[1]->next(other);
+	    lineNum++;
+
+	    if (!more && !otherMore)
+		break;
+
+	    if (more && otherMore && line.text == other.text)
+		continue;
+
+	    // print the first difference and the lines after it
+	    cout << "traces differ at line " << lineNum << "\n";
+	    for (int i = 0; i <= context && (more || otherMore); ++i) {
+		cout << "< " << (more ? line.text : "<end of trace>") << "\n";
+		cout << "> " << (otherMore ? other.text : "<end of trace>")
+		     << "\n";
+		more = more && traces[0]->next(line);
+		otherMore = otherMore && traces[1]->next(other);
+	    }
+	    status = 1;
+	    break;
+	}
+    } else {
+	usage();
+    }
+
+    for (int i = 0; i < traces.size(); ++i)
+	delete traces[i];
+
+    return status;
+}
@@ -0,0 +1,58 @@
+/*
+ * cptconvert.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ *
+ * Converts a text checkpoint (m5.cpt) into the binary checkpoint
+ * format (m5.cpz). The page indexes of the MainMemory objects are
+ * embedded in the archive, so the pagefile-content files are no longer
+ * needed when the checkpoint is loaded. The diskpages files are still
+ * used as they are.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "sim/cpt_archive.hh"
+
+using namespace std;
+
+int
+main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3) {
+        cerr << "usage: " << argv[0] << " <checkpoint dir> [output file]\n"
+             << "  output defaults to <checkpoint dir>/m5.cpz\n";
+        return 1;
+    }
+
+    string dir = argv[1];
+    string output = argc == 3 ? argv[2] : dir + "/m5.cpz";
+
+    string input = dir + "/m5.cpt";
+    ifstream text(input.c_str());
+    if (!text.is_open()) {
+        cerr << "Could not open " << input << "\n";
+        return 1;
+    }
+
+    CheckpointArchive archive;
+    if (!archive.parseText(text) || !archive.embedPageIndexes(dir)
+        || !archive.save(output)) {
+        cerr << archive.error() << "\n";
+        return 1;
+    }
+
+    // read the archive back to catch problems before the text is deleted
+    CheckpointArchive check;
+    if (!check.load(output)) {
+        cerr << "Verification failed: " << check.error() << "\n";
+        return 1;
+    }
+
+    cout << "Wrote " << archive.numSections() << " sections to "
+         << output << "\n";
+    return 0;
+}
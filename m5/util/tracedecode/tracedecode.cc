@@ -0,0 +1,312 @@
+/*
+ * tracedecode.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: jahre
+ */
+
+#include <ctype.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/cprintf.hh"
+
+using namespace std;
+using namespace Trace;
+
+const char *program = "tracedecode";
+
+void
+usage()
+{
+    cprintf("usage: %s [-f flag[,flag...]] <trace file>\n", program);
+    exit(2);
+}
+
+FILE *in;
+
+void
+readBytes(void *data, int len)
+{
+    if (len > 0 && fread(data, 1, len, in) != (size_t)len) {
+	cerr << program << ": truncated trace file" << endl;
+	exit(1);
+    }
+}
+
+template <class T>
+T
+read()
+{
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+}
+
+string
+readString()
+{
+    uint32_t len = read<uint32_t>();
+    string str(len, '\0');
+    if (len > 0)
+	readBytes(&str[0], len);
+    return str;
+}
+
+/**
+ * The arguments of one record. cp::ArgList keeps references to the
+ * arguments, so the values are kept in lists that do not move them.
+ */
+struct ArgStore
+{
+    list<bool> bools;
+    list<char> chars;
+    list<signed char> signedChars;
+    list<unsigned char> unsignedChars;
+    list<short> shorts;
+    list<unsigned short> unsignedShorts;
+    list<int> ints;
+    list<unsigned int> unsignedInts;
+    list<long> longs;
+    list<unsigned long> unsignedLongs;
+    list<long long> longLongs;
+    list<unsigned long long> unsignedLongLongs;
+    list<float> floats;
+    list<double> doubles;
+    list<string> strings;
+    list<const void *> pointers;
+};
+
+template <class T>
+void
+appendArg(cp::ArgList &args, list<T> &store)
+{
+    store.push_back(read<T>());
+    args.append(store.back());
+}
+
+void
+readArgs(cp::ArgList &args, ArgStore &store)
+{
+    while (true) {
+	uint8_t type = read<uint8_t>();
+	switch (type) {
+	  case Binary::ArgEnd:
+	    return;
+	  case Binary::ArgBool:
+	    appendArg(args, store.bools);
+	    break;
+	  case Binary::ArgChar:
+	    appendArg(args, store.chars);
+	    break;
+	  case Binary::ArgSignedChar:
+	    appendArg(args, store.signedChars);
+	    break;
+	  case Binary::ArgUnsignedChar:
+	    appendArg(args, store.unsignedChars);
+	    break;
+	  case Binary::ArgShort:
+	    appendArg(args, store.shorts);
+	    break;
+	  case Binary::ArgUnsignedShort:
+	    appendArg(args, store.unsignedShorts);
+	    break;
+	  case Binary::ArgInt:
+	    appendArg(args, store.ints);
+	    break;
+	  case Binary::ArgUnsignedInt:
+	    appendArg(args, store.unsignedInts);
+	    break;
+	  case Binary::ArgLong:
+	    appendArg(args, store.longs);
+	    break;
+	  case Binary::ArgUnsignedLong:
+	    appendArg(args, store.unsignedLongs);
+	    break;
+	  case Binary::ArgLongLong:
+	    appendArg(args, store.longLongs);
+	    break;
+	  case Binary::ArgUnsignedLongLong:
+	    appendArg(args, store.unsignedLongLongs);
+	    break;
+	  case Binary::ArgFloat:
+	    appendArg(args, store.floats);
+	    break;
+	  case Binary::ArgDouble:
+	    appendArg(args, store.doubles);
+	    break;
+	  case Binary::ArgString:
+	    store.strings.push_back(readString());
+	    args.append(store.strings.back());
+	    break;
+	  case Binary::ArgPointer:
+	    store.pointers.push_back((const void *)(uintptr_t)read<uint64_t>());
+	    args.append(store.pointers.back());
+	    break;
+	  default:
+	    cerr << program << ": bad argument type " << (int)type << endl;
+	    exit(1);
+	}
+    }
+}
+
+// Same output as Trace::DataRecord::dump()
+void
+dumpData(Tick cycle, const string &name, const string &data)
+{
+    int c, i, j;
+    int len = data.size();
+
+    for (i = 0; i < len; i += 16) {
+	ccprintf(cout, "%d: %s: %08x  ", cycle, name, i);
+	c = len - i;
+	if (c > 16) c = 16;
+
+	for (j = 0; j < c; j++) {
+	    ccprintf(cout, "%02x ", data[i + j] & 0xff);
+	    if ((j & 0xf) == 7 && j > 0)
+		ccprintf(cout, " ");
+	}
+
+	for (; j < 16; j++)
+	    ccprintf(cout, "   ");
+	ccprintf(cout, "  ");
+
+	for (j = 0; j < c; j++) {
+	    int ch = data[i + j] & 0x7f;
+	    ccprintf(cout,
+		     "%c", (char)(isprint(ch) ? ch : ' '));
+	}
+
+	ccprintf(cout, "\n");
+
+	if (c < 16)
+	    break;
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    program = basename(argv[0]);
+
+    set<string> selected;
+    int c;
+    while ((c = getopt(argc, argv, "f:")) != -1) {
+	switch (c) {
+	  case 'f': {
+	      string flags = optarg;
+	      string::size_type start = 0, end;
+	      do {
+		  end = flags.find(',', start);
+		  selected.insert(flags.substr(start, end - start));
+		  start = end + 1;
+	      } while (end != string::npos);
+	      break;
+	  }
+	  default:
+	    usage();
+	}
+    }
+
+    if (argc - optind != 1)
+	usage();
+
+    in = fopen(argv[optind], "rb");
+    if (in == NULL) {
+	cerr << program << ": could not open " << argv[optind] << endl;
+	exit(1);
+    }
+
+    if (read<uint32_t>() != Binary::Magic) {
+	cerr << program << ": not a binary trace file" << endl;
+	exit(1);
+    }
+    if (read<uint32_t>() != Binary::Version) {
+	cerr << program << ": unsupported trace version" << endl;
+	exit(1);
+    }
+
+    // records without a flag are always printed
+    uint32_t numFlags = read<uint32_t>();
+    vector<bool> show(numFlags, selected.empty());
+    for (int i = 0; i < numFlags; ++i) {
+	if (selected.count(readString()))
+	    show[i] = true;
+    }
+
+    vector<string> formats;
+
+    int type;
+    while ((type = fgetc(in)) != EOF) {
+	switch (type) {
+	  case Binary::FormatRecord: {
+	      uint32_t id = read<uint32_t>();
+	      if (id >= formats.size())
+		  formats.resize(id + 1);
+	      formats[id] = readString();
+	      break;
+	  }
+
+	  case Binary::PrintfRecord: {
+	      Tick cycle = read<Tick>();
+	      int16_t flag = read<int16_t>();
+	      uint32_t id = read<uint32_t>();
+	      string name = readString();
+
+	      cp::ArgList args;
+	      ArgStore store;
+	      readArgs(args, store);
+
+	      if (id >= formats.size()) {
+		  cerr << program << ": undefined format " << id << endl;
+		  exit(1);
+	      }
+	      if (flag >= 0 && (flag >= numFlags || !show[flag]))
+		  break;
+
+	      // Same output as Trace::PrintfRecord::dump()
+	      string fmt = "";
+
+	      if (!name.empty()) {
+		  fmt = "%s: " + fmt;
+		  args.prepend(name);
+	      }
+
+	      if (cycle != (Tick)-1) {
+		  fmt = "%7d: " + fmt;
+		  args.prepend(cycle);
+	      }
+
+	      fmt += formats[id];
+
+	      args.dump(cout, fmt);
+	      break;
+	  }
+
+	  case Binary::DataRecord: {
+	      Tick cycle = read<Tick>();
+	      string name = readString();
+	      string data = readString();
+	      dumpData(cycle, name, data);
+	      break;
+	  }
+
+	  default:
+	    cerr << program << ": bad record type " << type << endl;
+	    exit(1);
+	}
+    }
+
+    fclose(in);
+    return 0;
+}